@@ -0,0 +1,208 @@
+/**
+ * ST7305_Asset.cpp
+ *
+ * Compressed native-format asset decoder implementation
+ *
+ * The payload is unpacked one row-pair at a time into a 75-byte scratch
+ * buffer. Because the bytes are already in frame buffer order, a row-pair
+ * can go to drawPacked() for the buffer path or straight out over SPI for
+ * the streaming path with no per-pixel work.
+ */
+
+#include "ST7305_Asset.h"
+
+// Panel size in RAM window units
+#define ST7305_PANEL_COLS  (ST7305_WIDTH / ST7305_PIXELS_PER_COL)
+#define ST7305_PANEL_PAIRS (ST7305_HEIGHT / 2)
+
+/**
+ * Floor division for window snapping (rounds negative values down)
+ */
+static inline int16_t floorDiv(int16_t value, int16_t divisor) {
+    return (value >= 0) ? (value / divisor) : -((divisor - 1 - value) / divisor);
+}
+
+/**
+ * Replay a recorded draw() (see ST7305_Mono::recordDeferred())
+ */
+static void replayAsset(ST7305_Mono &display, const void *data, int16_t x, int16_t y) {
+    ST7305_AssetDecoder decoder(display);
+    decoder.draw((const uint8_t*)data, x, y);
+}
+
+/**
+ * Constructor - Bind the decoder to a display
+ *
+ * @param display Display that receives decoded assets
+ */
+ST7305_AssetDecoder::ST7305_AssetDecoder(ST7305_Mono &display)
+    : _display(display), _encoding(ST7305_ASSET_RAW), _width(0), _height(0),
+      _cols(0), _pairs(0), _src(nullptr), _end(nullptr),
+      _runLeft(0), _runLiteral(false), _runValue(0) {
+}
+
+/**
+ * Draw - Decode into the frame buffer, one row-pair at a time
+ *
+ * @param asset Asset data
+ * @param x, y  Top-left corner (viewport coordinates)
+ * @return true on success
+ */
+bool ST7305_AssetDecoder::draw(const uint8_t *asset, int16_t x, int16_t y) {
+    if (!parseHeader(asset)) {
+        return false;
+    }
+    // Recording: keep a reference to the asset, decode per tile later
+    if (_display.recordDeferred(x, y, _width, _height, replayAsset, asset, true)) {
+        return true;
+    }
+
+    for (uint16_t pair = 0; pair < _pairs; pair++) {
+        if (!unpackPair()) {
+            return false;
+        }
+        int16_t rows = _height - pair * 2;
+        _display.drawPacked(x, y + pair * 2, _pair, _width, (rows > 2) ? 2 : rows);
+    }
+    return true;
+}
+
+/**
+ * Stream - Decode straight into a windowed RAMWR
+ *
+ * Row-pairs above the panel are decoded and dropped (the payload is a
+ * single run-length stream), columns outside the panel are cut from
+ * each row-pair before it is sent.
+ *
+ * @param asset Asset data
+ * @param x, y  Top-left corner (absolute, snapped to the window grid)
+ * @return true on success
+ */
+bool ST7305_AssetDecoder::stream(const uint8_t *asset, int16_t x, int16_t y) {
+    if (!parseHeader(asset)) {
+        return false;
+    }
+
+    int16_t col = floorDiv(x, ST7305_PIXELS_PER_COL);
+    int16_t pair = floorDiv(y, 2);
+
+    // Visible range in asset columns / row-pairs
+    int16_t c0 = (col < 0) ? -col : 0;
+    int16_t c1 = ST7305_PANEL_COLS - 1 - col;
+    if (c1 > _cols - 1) c1 = _cols - 1;
+    int16_t p0 = (pair < 0) ? -pair : 0;
+    int16_t p1 = ST7305_PANEL_PAIRS - 1 - pair;
+    if (p1 > (int16_t)_pairs - 1) p1 = _pairs - 1;
+    if ((c0 > c1) || (p0 > p1)) {
+        return true;  // Entirely off-screen
+    }
+
+    uint32_t offset = (uint32_t)c0 * ST7305_BYTES_PER_COL;
+    uint32_t len = (uint32_t)(c1 - c0 + 1) * ST7305_BYTES_PER_COL;
+
+    for (int16_t p = 0; p < p0; p++) {
+        if (!unpackPair()) {
+            return false;
+        }
+    }
+
+    _display.beginWindowWrite((col + c0) * ST7305_PIXELS_PER_COL, (pair + p0) * 2,
+                              (c1 - c0 + 1) * ST7305_PIXELS_PER_COL, (p1 - p0 + 1) * 2);
+    bool ok = true;
+    for (int16_t p = p0; p <= p1; p++) {
+        if (!unpackPair()) {
+            ok = false;  // Window stays short; the panel keeps old pixels
+            break;
+        }
+        _display.writeWindowData(_pair + offset, len);
+    }
+    _display.endWindowWrite();
+    return ok;
+}
+
+/**
+ * Parse Header - Validate the header and reset the unpacker
+ *
+ * @param asset Asset data
+ * @return false on bad magic, encoding or size
+ */
+bool ST7305_AssetDecoder::parseHeader(const uint8_t *asset) {
+    uint8_t header[ST7305_ASSET_HEADER];
+    for (uint8_t i = 0; i < ST7305_ASSET_HEADER; i++) {
+        header[i] = pgm_read_byte(asset + i);
+    }
+    if ((header[0] != 'S') || (header[1] != 'A') || (header[2] > ST7305_ASSET_RLE)) {
+        return false;
+    }
+
+    _encoding = (st7305_asset_encoding_t)header[2];
+    _width = header[4] | (header[5] << 8);
+    _height = header[6] | (header[7] << 8);
+    uint32_t payload = header[8] | (header[9] << 8) | ((uint32_t)header[10] << 16) |
+                       ((uint32_t)header[11] << 24);
+    if ((_width == 0) || (_height == 0) || (_width > ST7305_WIDTH)) {
+        return false;
+    }
+
+    _cols = (_width + ST7305_PIXELS_PER_COL - 1) / ST7305_PIXELS_PER_COL;
+    _pairs = (_height + 1) / 2;
+    _src = asset + ST7305_ASSET_HEADER;
+    _end = _src + payload;
+    _runLeft = 0;
+
+    if ((_encoding == ST7305_ASSET_RAW) &&
+        (payload != (uint32_t)_cols * ST7305_BYTES_PER_COL * _pairs)) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Unpack Pair - Decode the next row-pair into _pair
+ *
+ * @return false if the payload ends early or a run is truncated
+ */
+bool ST7305_AssetDecoder::unpackPair() {
+    uint8_t len = _cols * ST7305_BYTES_PER_COL;
+
+    if (_encoding == ST7305_ASSET_RAW) {
+        for (uint8_t i = 0; i < len; i++) {
+            _pair[i] = pgm_read_byte(_src++);
+        }
+        return true;
+    }
+
+    uint8_t *dst = _pair;
+    while (len > 0) {
+        if (_runLeft == 0) {
+            if (_src + 2 > _end) {
+                return false;
+            }
+            uint8_t control = pgm_read_byte(_src++);
+            if (control < 0x80) {
+                _runLiteral = true;
+                _runLeft = control + 1;
+                if (_src + _runLeft > _end) {
+                    return false;
+                }
+            } else {
+                _runLiteral = false;
+                _runLeft = control - 0x7E;
+                _runValue = pgm_read_byte(_src++);
+            }
+        }
+
+        uint8_t n = (_runLeft < len) ? _runLeft : len;
+        if (_runLiteral) {
+            for (uint8_t i = 0; i < n; i++) {
+                *dst++ = pgm_read_byte(_src++);
+            }
+        } else {
+            memset(dst, _runValue, n);
+            dst += n;
+        }
+        _runLeft -= n;
+        len -= n;
+    }
+    return true;
+}
@@ -0,0 +1,121 @@
+/**
+ * ST7305_Asset.h
+ *
+ * Compressed native-format assets for the ST7305 Monochrome Display Driver
+ *
+ * Assets are produced on the host by tools/st7305_asset.py. Pixels are
+ * stored already packed in the controller's 4x2 layout and padded to the
+ * RAM window grid (12 pixels wide, 2 rows high), then compressed with a
+ * PackBits-style run-length code. Decoding is a byte copy loop, so an
+ * asset can be:
+ * - drawn into the frame buffer (clipped, with viewport and dirty tracking)
+ * - streamed straight into a windowed RAMWR, without touching the buffer
+ *
+ * Asset Format ("SA"):
+ *   Byte 0-1: 'S', 'A'
+ *   Byte 2:   Encoding (0 = raw, 1 = run-length)
+ *   Byte 3:   Reserved (0)
+ *   Byte 4-5: Width  in pixels (uint16, little-endian)
+ *   Byte 6-7: Height in pixels (uint16, little-endian)
+ *   Byte 8-11: Payload size in bytes (uint32, little-endian; a tall
+ *             image packs to more than 64KB)
+ *   Payload:  ceil(height / 2) row-pairs of ceil(width / 12) * 3 bytes,
+ *             frame buffer byte order. Run-length control bytes:
+ *     0x00-0x7F: copy the next (n + 1) bytes
+ *     0x80-0xFF: repeat the next byte (n - 0x7E) times (2..129)
+ *   Runs may cross row-pair boundaries.
+ *
+ * Usage:
+ *   #include "splash_asset.h"       // generated, const uint8_t splash[] PROGMEM
+ *   ST7305_AssetDecoder assets(display);
+ *   assets.stream(splash, 0, 0);    // Straight to the panel
+ */
+
+#ifndef ST7305_ASSET_H
+#define ST7305_ASSET_H
+
+#include <Arduino.h>
+#include "ST7305_Mono.h"
+
+// Asset header size in bytes
+#define ST7305_ASSET_HEADER 12
+
+/**
+ * Asset payload encodings
+ */
+typedef enum {
+    ST7305_ASSET_RAW = 0,
+    ST7305_ASSET_RLE = 1
+} st7305_asset_encoding_t;
+
+// ============================================================================
+// ST7305_AssetDecoder Class
+// ============================================================================
+
+class ST7305_AssetDecoder {
+public:
+    /**
+     * Constructor
+     * @param display Target display
+     */
+    ST7305_AssetDecoder(ST7305_Mono &display);
+
+    /**
+     * draw - Decode an asset into the frame buffer
+     *
+     * Each row-pair is unpacked into a small scratch buffer and written
+     * with drawPacked(), so clip, viewport and dirty tracking apply.
+     * Only the asset's own width x height is written, not the padding.
+     * Byte copies are used when x is a multiple of 4 and y is even.
+     * In recording mode the asset is recorded by reference and decoded
+     * for each tile that needs redrawing.
+     *
+     * @param asset Asset data (PROGMEM or RAM)
+     * @param x, y  Top-left corner
+     * @return false on a malformed asset
+     */
+    bool draw(const uint8_t *asset, int16_t x, int16_t y);
+
+    /**
+     * stream - Decode an asset straight into display RAM
+     *
+     * Opens a RAMWR window of the padded asset size and sends each
+     * row-pair as it is unpacked; the frame buffer is neither read nor
+     * modified (a later display() will overwrite the image). Parts
+     * outside the panel are skipped.
+     *
+     * @param asset Asset data (PROGMEM or RAM)
+     * @param x, y  Top-left corner in absolute panel coordinates,
+     *              rounded down to the 12-pixel / 2-row grid
+     * @return false on a malformed asset
+     */
+    bool stream(const uint8_t *asset, int16_t x, int16_t y);
+
+    /**
+     * Properties of the last asset parsed
+     */
+    st7305_asset_encoding_t encoding() const { return _encoding; }
+    uint16_t width() const { return _width; }
+    uint16_t height() const { return _height; }
+
+private:
+    ST7305_Mono &_display;
+
+    uint8_t _pair[ST7305_BYTES_PER_ROW];      // One unpacked row-pair
+
+    st7305_asset_encoding_t _encoding;
+    uint16_t _width, _height;
+    uint8_t _cols;                            // Width in 12-pixel columns
+    uint16_t _pairs;                          // Height in row-pairs
+
+    const uint8_t *_src;                      // Next payload byte
+    const uint8_t *_end;                      // End of payload
+    uint8_t _runLeft;                         // Bytes left in current run
+    bool _runLiteral;                         // Current run copies bytes
+    uint8_t _runValue;                        // Repeated byte
+
+    bool parseHeader(const uint8_t *asset);
+    bool unpackPair();                        // Next row-pair into _pair
+};
+
+#endif // ST7305_ASSET_H
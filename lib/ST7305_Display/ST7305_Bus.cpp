@@ -0,0 +1,207 @@
+/**
+ * ST7305_Bus.cpp
+ *
+ * Shared SPI bus manager implementation
+ *
+ * Every chunk is a complete windowed RAMWR (displayRegion() of a band of
+ * row-pairs), so the bus can be handed to another device between chunks
+ * without relying on the controller to resume a write after CS goes high.
+ */
+
+#include "ST7305_Bus.h"
+
+/**
+ * Constructor - Empty bus
+ *
+ * @param chunkBytes Pixel bytes per chunk
+ */
+ST7305_SPIBus::ST7305_SPIBus(uint16_t chunkBytes)
+    : _count(0), _next(0), _chunkBytes(chunkBytes),
+      _yield(nullptr), _yieldContext(nullptr) {
+    memset(_panels, 0, sizeof(_panels));
+    resetStats();
+}
+
+/**
+ * Attach - Register a display
+ *
+ * @param display Initialized display
+ * @return false if full or already attached
+ */
+bool ST7305_SPIBus::attach(ST7305_Mono &display) {
+    if ((_count >= ST7305_BUS_MAX_PANELS) || find(display)) {
+        return false;
+    }
+    memset(&_panels[_count], 0, sizeof(st7305_bus_panel_t));
+    _panels[_count].display = &display;
+    _count++;
+    return true;
+}
+
+/**
+ * Detach - Unregister a display (an unfinished window is abandoned)
+ *
+ * @param display Attached display
+ */
+void ST7305_SPIBus::detach(ST7305_Mono &display) {
+    st7305_bus_panel_t *panel = find(display);
+    if (!panel) {
+        return;
+    }
+    *panel = _panels[--_count];
+    if (_next >= _count) {
+        _next = 0;
+    }
+}
+
+/**
+ * Set Yield Callback - Function run between chunks by flush()
+ */
+void ST7305_SPIBus::setYieldCallback(st7305_bus_yield_t callback, void *context) {
+    _yield = callback;
+    _yieldContext = context;
+}
+
+/**
+ * Request Flush - Mark a display as having data to send
+ *
+ * @param display Attached display
+ * @param full    Invalidate the whole panel first
+ * @return false if not attached
+ */
+bool ST7305_SPIBus::requestFlush(ST7305_Mono &display, bool full) {
+    st7305_bus_panel_t *panel = find(display);
+    if (!panel) {
+        return false;
+    }
+    if (full) {
+        display.invalidateRect(0, 0, ST7305_WIDTH, ST7305_HEIGHT);
+    }
+    panel->requested = true;
+    return true;
+}
+
+/**
+ * Service - Send one chunk, round-robin over panels with work
+ *
+ * A panel whose turn comes with a request but a clean buffer is
+ * skipped without using the bus.
+ *
+ * @return true if work remains
+ */
+bool ST7305_SPIBus::service() {
+    for (uint8_t tries = 0; tries < _count; tries++) {
+        st7305_bus_panel_t &panel = _panels[_next];
+        _next = (_next + 1 < _count) ? _next + 1 : 0;
+
+        if (!panel.active && !(panel.requested && startWindow(panel))) {
+            continue;
+        }
+        sendChunk(panel);
+        break;
+    }
+    return busy();
+}
+
+/**
+ * Flush - Drain all pending work, yielding between chunks
+ */
+void ST7305_SPIBus::flush() {
+    while (service()) {
+        if (_yield) {
+            _yield(_yieldContext);
+        } else {
+            yield();
+        }
+    }
+}
+
+/**
+ * Busy - Any panel with a request or an open window
+ */
+bool ST7305_SPIBus::busy() const {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_panels[i].active || _panels[i].requested) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Reset Stats - Zero all counters
+ */
+void ST7305_SPIBus::resetStats() {
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+/**
+ * Find - Panel entry of a display
+ */
+st7305_bus_panel_t *ST7305_SPIBus::find(ST7305_Mono &display) {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_panels[i].display == &display) {
+            return &_panels[i];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Start Window - Take the display's dirty rectangle as the next window
+ *
+ * The window is snapped to whole 12-pixel columns and row-pairs here so
+ * the chunks split it exactly on row-pair boundaries.
+ *
+ * @param panel Panel with a pending request
+ * @return false if the display is clean (request dropped)
+ */
+bool ST7305_SPIBus::startWindow(st7305_bus_panel_t &panel) {
+    st7305_rect_t dirty = panel.display->getDirtyRect();
+    panel.display->clearDirty();
+    panel.requested = false;
+    if ((dirty.w <= 0) || (dirty.h <= 0)) {
+        return false;
+    }
+
+    int16_t col0 = dirty.x / ST7305_PIXELS_PER_COL;
+    int16_t col1 = (dirty.x + dirty.w - 1) / ST7305_PIXELS_PER_COL;
+    panel.x = col0 * ST7305_PIXELS_PER_COL;
+    panel.w = (col1 - col0 + 1) * ST7305_PIXELS_PER_COL;
+    panel.pair = dirty.y / 2;
+    panel.lastPair = (dirty.y + dirty.h - 1) / 2;
+    panel.active = true;
+    return true;
+}
+
+/**
+ * Send Chunk - One band of row-pairs of the panel's window
+ *
+ * @param panel Panel with an open window
+ */
+void ST7305_SPIBus::sendChunk(st7305_bus_panel_t &panel) {
+    uint16_t rowBytes = (panel.w / ST7305_PIXELS_PER_COL) * ST7305_BYTES_PER_COL;
+    int16_t pairs = _chunkBytes / rowBytes;
+    if (pairs < 1) {
+        pairs = 1;
+    }
+    if (pairs > panel.lastPair - panel.pair + 1) {
+        pairs = panel.lastPair - panel.pair + 1;
+    }
+
+    uint32_t start = micros();
+    panel.display->displayRegion(panel.x, panel.pair * 2, panel.w, pairs * 2);
+    uint32_t elapsed = micros() - start;
+
+    _stats.chunks++;
+    _stats.bytes += (uint32_t)rowBytes * pairs;
+    if (elapsed > _stats.maxChunkMicros) {
+        _stats.maxChunkMicros = elapsed;
+    }
+
+    panel.pair += pairs;
+    if (panel.pair > panel.lastPair) {
+        panel.active = false;
+        _stats.flushes++;
+    }
+}
@@ -0,0 +1,169 @@
+/**
+ * ST7305_Bus.h
+ *
+ * Shared SPI bus manager for the ST7305 Monochrome Display Driver
+ *
+ * display() keeps the bus for the whole 15KB transfer (about 120ms at
+ * 1MHz), which locks out an SD card or radio sharing the same SPI pins.
+ * ST7305_SPIBus instead sends each flush as a series of small windowed
+ * RAMWRs, one band of row-pairs at a time. Between bands the bus is
+ * free: the SPI transaction is closed, CS is high and a yield callback
+ * runs, so other devices get the bus within one chunk time.
+ *
+ * Several ST7305_Mono instances (separate CS pins, shared SCK/MOSI and
+ * optionally DC) can be attached. Pending flushes are served round-robin
+ * one chunk at a time, so a full-screen update of one panel does not
+ * hold back a small update of another.
+ *
+ * Usage:
+ *   ST7305_SPIBus bus(1500);              // Bytes per chunk
+ *   bus.attach(left);
+ *   bus.attach(right);
+ *
+ *   left.print(...);  bus.requestFlush(left);
+ *   right.print(...); bus.requestFlush(right);
+ *
+ *   void loop() {
+ *       bus.service();                    // One chunk, then back to loop()
+ *       radio.poll();
+ *   }
+ */
+
+#ifndef ST7305_BUS_H
+#define ST7305_BUS_H
+
+#include <Arduino.h>
+#include "ST7305_Mono.h"
+
+// Panels that can share one bus
+#define ST7305_BUS_MAX_PANELS  4
+
+// Default chunk size in bytes: 20 full-width row-pairs, about 12ms at 1MHz.
+// Chunks always end on a row-pair boundary and hold at least one row-pair.
+#define ST7305_BUS_CHUNK_BYTES 1500
+
+/**
+ * Called between chunks by flush() (default: Arduino yield())
+ */
+typedef void (*st7305_bus_yield_t)(void *context);
+
+/**
+ * Per-panel flush state
+ */
+typedef struct {
+    ST7305_Mono *display;
+    bool requested;       // Flush asked for, window not started yet
+    bool active;          // Window being sent
+    int16_t x, w;         // Window columns (pixels, on the 12-pixel grid)
+    int16_t pair;         // Next row-pair to send
+    int16_t lastPair;     // Last row-pair of the window
+} st7305_bus_panel_t;
+
+/**
+ * Bus counters
+ */
+typedef struct {
+    uint32_t chunks;          // Windowed RAMWRs sent
+    uint32_t bytes;           // Pixel data bytes sent
+    uint32_t flushes;         // Completed panel flushes
+    uint32_t maxChunkMicros;  // Longest single chunk (bus held)
+} st7305_bus_stats_t;
+
+// ============================================================================
+// ST7305_SPIBus Class
+// ============================================================================
+
+class ST7305_SPIBus {
+public:
+    /**
+     * Constructor
+     * @param chunkBytes Pixel bytes per chunk (see setChunkSize())
+     */
+    ST7305_SPIBus(uint16_t chunkBytes = ST7305_BUS_CHUNK_BYTES);
+
+    /**
+     * attach - Put a display on this bus
+     *
+     * The display must already be initialized with begin().
+     *
+     * @return false if the bus is full or the display already attached
+     */
+    bool attach(ST7305_Mono &display);
+
+    /**
+     * detach - Remove a display and drop its pending flush
+     */
+    void detach(ST7305_Mono &display);
+
+    /**
+     * setChunkSize - Bytes sent while holding the bus
+     *
+     * Rounded down to whole row-pairs of the window being sent (75 bytes
+     * for a full-width row-pair), minimum one row-pair. Smaller chunks
+     * free the bus sooner at the cost of 7 addressing bytes per chunk.
+     */
+    void setChunkSize(uint16_t bytes) { _chunkBytes = bytes; }
+
+    /**
+     * setYieldCallback - Run other bus users between chunks in flush()
+     *
+     * @param callback Function to call, nullptr for Arduino yield()
+     * @param context  Passed to callback
+     */
+    void setYieldCallback(st7305_bus_yield_t callback, void *context = nullptr);
+
+    /**
+     * requestFlush - Queue the display's dirty region for sending
+     *
+     * The dirty rectangle is taken (and cleared) when the panel's turn
+     * starts, so drawing done until then is included. Drawing during a
+     * flush may show up in the rows not sent yet; it also stays dirty
+     * for the next request.
+     *
+     * @param display Attached display
+     * @param full    Send the whole panel instead of the dirty region
+     * @return false if the display is not attached
+     */
+    bool requestFlush(ST7305_Mono &display, bool full = false);
+
+    /**
+     * service - Send one chunk for the next panel with work
+     *
+     * Non-blocking building block for cooperative loops: returns after
+     * at most one chunk with the bus released.
+     *
+     * @return true if more work is pending
+     */
+    bool service();
+
+    /**
+     * flush - Send everything pending, yielding between chunks
+     */
+    void flush();
+
+    /**
+     * busy - Some panel has a flush pending or in progress
+     */
+    bool busy() const;
+
+    /**
+     * Statistics
+     */
+    st7305_bus_stats_t getStats() const { return _stats; }
+    void resetStats();
+
+private:
+    st7305_bus_panel_t _panels[ST7305_BUS_MAX_PANELS];
+    uint8_t _count;
+    uint8_t _next;                        // Round-robin position
+    uint16_t _chunkBytes;
+    st7305_bus_yield_t _yield;
+    void *_yieldContext;
+    st7305_bus_stats_t _stats;
+
+    st7305_bus_panel_t *find(ST7305_Mono &display);
+    bool startWindow(st7305_bus_panel_t &panel);  // Dirty rect -> window
+    void sendChunk(st7305_bus_panel_t &panel);
+};
+
+#endif // ST7305_BUS_H
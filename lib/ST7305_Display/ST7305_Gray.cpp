@@ -0,0 +1,366 @@
+/**
+ * ST7305_Gray.cpp
+ *
+ * Temporal-dither grayscale implementation
+ *
+ * A pixel at (x, y) with level L is white in plane i when
+ * (x + y + i) mod N < L. Within one packed byte the 8 pixels only
+ * differ by (dx + dy), so every (plane, level, phase of the byte's first
+ * pixel) has one fixed byte value, precomputed in begin().
+ */
+
+#include "ST7305_Gray.h"
+
+/**
+ * Constructor - No planes until begin()
+ *
+ * @param display Output display
+ */
+ST7305_Grayscale::ST7305_Grayscale(ST7305_Mono &display)
+    : Adafruit_GFX(ST7305_WIDTH, ST7305_HEIGHT), _display(display),
+      _memory(nullptr), _planes(0), _shown(0), _period(0), _lastPush(0),
+      _framesPerPlane(1), _lastBytes(0) {
+    memset(_plane, 0, sizeof(_plane));
+    memset(_deltaCount, 0, sizeof(_deltaCount));
+    memset(_deltaValid, 0, sizeof(_deltaValid));
+    _dirtyX0 = INT16_MAX;
+    _dirtyY0 = INT16_MAX;
+    _dirtyX1 = INT16_MIN;
+    _dirtyY1 = INT16_MIN;
+}
+
+/**
+ * Destructor - Free the planes
+ */
+ST7305_Grayscale::~ST7305_Grayscale() {
+    if (_memory) {
+        free(_memory);
+        _memory = nullptr;
+    }
+}
+
+/**
+ * Begin - Allocate planes and build the pattern table
+ *
+ * @param planes Bitplane count, clamped to 1..ST7305_GRAY_MAX_PLANES
+ * @return false if out of memory
+ */
+bool ST7305_Grayscale::begin(uint8_t planes) {
+    if (planes < 1) planes = 1;
+    if (planes > ST7305_GRAY_MAX_PLANES) planes = ST7305_GRAY_MAX_PLANES;
+
+    if (_memory) {
+        free(_memory);
+    }
+    _memory = (uint8_t*)malloc((size_t)ST7305_BUFFER_SIZE * planes);
+    if (!_memory) {
+        _planes = 0;
+        return false;
+    }
+    _planes = planes;
+    for (uint8_t i = 0; i < planes; i++) {
+        _plane[i] = _memory + (size_t)i * ST7305_BUFFER_SIZE;
+        memset(_plane[i], 0xFF, ST7305_BUFFER_SIZE);  // White
+    }
+
+    // Pattern bytes: bit 7 - (dx * 2 + dy) is pixel (dx, dy) of the byte
+    for (uint8_t i = 0; i < planes; i++) {
+        for (uint8_t level = 0; level <= planes; level++) {
+            for (uint8_t phase = 0; phase < planes; phase++) {
+                uint8_t value = 0;
+                for (uint8_t dx = 0; dx < 4; dx++) {
+                    for (uint8_t dy = 0; dy < 2; dy++) {
+                        if ((phase + dx + dy + i) % planes < level) {
+                            value |= 0x80 >> (dx * 2 + dy);
+                        }
+                    }
+                }
+                _pattern[i][level][phase] = value;
+            }
+        }
+    }
+
+    _shown = 0;
+    _period = _display.getFramePeriodMicros();
+    _lastPush = micros();
+    invalidate(0, 0, ST7305_WIDTH - 1, ST7305_HEIGHT - 1);  // Panel content unknown
+    return true;
+}
+
+// ===== Drawing =====
+
+/**
+ * Draw Pixel - Set one pixel in every plane
+ *
+ * @param x, y  Panel coordinates
+ * @param color Gray level (0 = black, values >= planes = white)
+ */
+void ST7305_Grayscale::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (!_memory || (x < 0) || (y < 0) || (x >= ST7305_WIDTH) || (y >= ST7305_HEIGHT)) {
+        return;
+    }
+    uint8_t level = (color > _planes) ? _planes : color;
+    uint16_t index = (y / 2) * ST7305_BYTES_PER_ROW + (x / 4);
+    uint8_t bit = 0x80 >> (((x % 4) * 2) + (y % 2));
+    uint8_t phase = (x + y) % _planes;
+
+    for (uint8_t i = 0; i < _planes; i++) {
+        if ((phase + i) % _planes < level) {
+            _plane[i][index] |= bit;
+        } else {
+            _plane[i][index] &= ~bit;
+        }
+    }
+    invalidate(x, y, x, y);
+}
+
+/**
+ * Fill Rect - Clip, then fill row-pair spans with pattern bytes
+ */
+void ST7305_Grayscale::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    int32_t x0 = (x < 0) ? 0 : x;
+    int32_t y0 = (y < 0) ? 0 : y;
+    int32_t x1 = (int32_t)x + w - 1;
+    int32_t y1 = (int32_t)y + h - 1;
+    if (x1 > ST7305_WIDTH - 1) x1 = ST7305_WIDTH - 1;
+    if (y1 > ST7305_HEIGHT - 1) y1 = ST7305_HEIGHT - 1;
+    if (!_memory || (w <= 0) || (h <= 0) || (x0 > x1) || (y0 > y1)) {
+        return;
+    }
+    uint8_t level = (color > _planes) ? _planes : color;
+
+    for (int32_t pair = y0 / 2; pair <= y1 / 2; pair++) {
+        uint8_t rowMask = ST7305_ROW_MASK_BOTH;
+        if (pair * 2 < y0) rowMask &= ST7305_ROW_MASK_ODD;       // Top row is odd
+        if (pair * 2 + 1 > y1) rowMask &= ST7305_ROW_MASK_EVEN;  // Bottom row is even
+        fillSpan(pair, x0, x1, rowMask, level);
+    }
+    invalidate(x0, y0, x1, y1);
+}
+
+void ST7305_Grayscale::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    fillRect(x, y, w, 1, color);
+}
+
+void ST7305_Grayscale::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    fillRect(x, y, 1, h, color);
+}
+
+void ST7305_Grayscale::fillScreen(uint16_t color) {
+    fillRect(0, 0, ST7305_WIDTH, ST7305_HEIGHT, color);
+}
+
+/**
+ * Fill Span - Write one row-pair span into all planes
+ *
+ * @param pair    Row-pair index
+ * @param x0, x1  Inclusive pixel columns (clipped)
+ * @param rowMask Rows of the pair to write
+ * @param level   Gray level (0..planes)
+ */
+void ST7305_Grayscale::fillSpan(int16_t pair, int16_t x0, int16_t x1, uint8_t rowMask, uint8_t level) {
+    int16_t bx0 = x0 / 4;
+    int16_t bx1 = x1 / 4;
+    uint8_t leftMask = 0xFF >> ((x0 % 4) * 2);
+    uint8_t rightMask = 0xFF << ((3 - (x1 % 4)) * 2);
+    uint16_t row = pair * ST7305_BYTES_PER_ROW;
+    uint8_t phase0 = (bx0 * 4 + pair * 2) % _planes;
+    uint8_t step = 4 % _planes;
+
+    for (uint8_t i = 0; i < _planes; i++) {
+        uint8_t *dst = _plane[i] + row;
+        const uint8_t *pattern = _pattern[i][level];
+        uint8_t phase = phase0;
+        for (int16_t bx = bx0; bx <= bx1; bx++) {
+            uint8_t mask = rowMask;
+            if (bx == bx0) mask &= leftMask;
+            if (bx == bx1) mask &= rightMask;
+            dst[bx] = (dst[bx] & ~mask) | (pattern[phase] & mask);
+            phase += step;
+            if (phase >= _planes) phase -= _planes;
+        }
+    }
+}
+
+// ===== Refresh =====
+
+/**
+ * Update - Frame-paced plane push
+ *
+ * @return true if a plane was pushed
+ */
+bool ST7305_Grayscale::update() {
+    if (!_memory) {
+        return false;
+    }
+    uint32_t interval = _period * _framesPerPlane;
+    uint32_t now = micros();
+    if (now - _lastPush < interval) {
+        return false;
+    }
+    _lastPush += interval;
+    if (now - _lastPush >= interval) {
+        _lastPush = now;  // Fell behind: restart the grid
+    }
+    showNextPlane();
+    return true;
+}
+
+/**
+ * Show Next Plane - Send what differs between the panel and the next plane
+ *
+ * Outside the dirty box the panel holds the current plane exactly, so
+ * the cached current -> next delta covers it; the dirty box is snapped
+ * to the RAM window grid and merged into the delta list, so no window
+ * is sent twice.
+ */
+void ST7305_Grayscale::showNextPlane() {
+    if (!_memory) {
+        return;
+    }
+    uint8_t next = (_shown + 1 < _planes) ? _shown + 1 : 0;
+    bool drawn = (_dirtyX0 <= _dirtyX1);
+    if (drawn) {
+        memset(_deltaValid, 0, sizeof(_deltaValid));  // Planes changed since the deltas were computed
+    }
+
+    st7305_rect_t rects[ST7305_GRAY_MAX_RECTS];
+    uint8_t count = 0;
+    if (next != _shown) {
+        if (!_deltaValid[_shown]) {
+            computeDelta(_shown);
+        }
+        memcpy(rects, _delta[_shown], _deltaCount[_shown] * sizeof(st7305_rect_t));
+        count = _deltaCount[_shown];
+    }
+    if (drawn) {
+        st7305_rect_t box = { _dirtyX0, _dirtyY0, (int16_t)(_dirtyX1 - _dirtyX0 + 1),
+                              (int16_t)(_dirtyY1 - _dirtyY0 + 1) };
+        st7305_rect_t snapped;
+        if (st7305_snap_rect(box, snapped)) {
+            st7305_add_rect(rects, count, ST7305_GRAY_MAX_RECTS, snapped);
+        }
+    }
+
+    _lastBytes = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        int16_t col0 = rects[i].x / ST7305_PIXELS_PER_COL;
+        int16_t col1 = (rects[i].x + rects[i].w - 1) / ST7305_PIXELS_PER_COL;
+        int16_t pair0 = rects[i].y / 2;
+        int16_t pair1 = (rects[i].y + rects[i].h - 1) / 2;
+        _lastBytes += (uint32_t)(col1 - col0 + 1) * ST7305_BYTES_PER_COL * (pair1 - pair0 + 1);
+    }
+    if (count > 0) {
+        _display.displayFrame(_plane[next], rects, count);
+    }
+
+    _shown = next;
+    _dirtyX0 = INT16_MAX;
+    _dirtyY0 = INT16_MAX;
+    _dirtyX1 = INT16_MIN;
+    _dirtyY1 = INT16_MIN;
+}
+
+/**
+ * Refresh - Full resend of the current plane
+ */
+void ST7305_Grayscale::refresh() {
+    if (!_memory) {
+        return;
+    }
+    _display.displayFrame(_plane[_shown], nullptr, 0);
+    _lastBytes = ST7305_BUFFER_SIZE;
+    if (_dirtyX0 <= _dirtyX1) {
+        memset(_deltaValid, 0, sizeof(_deltaValid));
+    }
+    _dirtyX0 = INT16_MAX;
+    _dirtyY0 = INT16_MAX;
+    _dirtyX1 = INT16_MIN;
+    _dirtyY1 = INT16_MIN;
+}
+
+/**
+ * Compute Delta - Windows where plane from and plane from + 1 differ
+ *
+ * Each row-pair's differing bytes are widened to whole 12-pixel columns;
+ * consecutive differing row-pairs are joined into one rectangle. When
+ * the list is full the rest is merged into the last rectangle.
+ *
+ * @param from Plane index
+ */
+void ST7305_Grayscale::computeDelta(uint8_t from) {
+    const uint8_t *a = _plane[from];
+    const uint8_t *b = _plane[(from + 1 < _planes) ? from + 1 : 0];
+    st7305_rect_t *list = _delta[from];
+    uint8_t count = 0;
+    bool open = false;
+    int16_t openX0 = 0, openX1 = 0, openPair = 0;
+
+    for (int16_t pair = 0; pair <= ST7305_HEIGHT / 2; pair++) {
+        int16_t first = -1, last = -1;
+        if (pair < ST7305_HEIGHT / 2) {
+            const uint8_t *ra = a + pair * ST7305_BYTES_PER_ROW;
+            const uint8_t *rb = b + pair * ST7305_BYTES_PER_ROW;
+            for (int16_t i = 0; i < ST7305_BYTES_PER_ROW; i++) {
+                if (ra[i] != rb[i]) {
+                    first = i;
+                    break;
+                }
+            }
+            if (first >= 0) {
+                for (last = ST7305_BYTES_PER_ROW - 1; ra[last] == rb[last]; last--) {
+                }
+            }
+        }
+
+        if (first >= 0) {
+            int16_t x0 = (first / ST7305_BYTES_PER_COL) * ST7305_PIXELS_PER_COL;
+            int16_t x1 = (last / ST7305_BYTES_PER_COL) * ST7305_PIXELS_PER_COL + ST7305_PIXELS_PER_COL - 1;
+            if (!open) {
+                open = true;
+                openPair = pair;
+                openX0 = x0;
+                openX1 = x1;
+            } else {
+                if (x0 < openX0) openX0 = x0;
+                if (x1 > openX1) openX1 = x1;
+            }
+            continue;
+        }
+        if (!open) {
+            continue;
+        }
+
+        // Close the run of differing row-pairs
+        open = false;
+        if (openX1 > ST7305_WIDTH - 1) openX1 = ST7305_WIDTH - 1;
+        st7305_rect_t r = { openX0, (int16_t)(openPair * 2),
+                            (int16_t)(openX1 - openX0 + 1), (int16_t)((pair - openPair) * 2) };
+        if (count < ST7305_GRAY_MAX_RECTS) {
+            list[count++] = r;
+        } else {
+            st7305_rect_t &m = list[count - 1];
+            int16_t mx0 = (r.x < m.x) ? r.x : m.x;
+            int16_t mx1 = (r.x + r.w > m.x + m.w) ? r.x + r.w : m.x + m.w;
+            m.h = r.y + r.h - m.y;
+            m.x = mx0;
+            m.w = mx1 - mx0;
+        }
+    }
+
+    _deltaCount[from] = count;
+    _deltaValid[from] = true;
+}
+
+/**
+ * Invalidate - Grow the dirty box
+ *
+ * Called for every pixel, so the cached deltas are only dropped when
+ * the box is consumed (showNextPlane(), refresh()).
+ */
+void ST7305_Grayscale::invalidate(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    if (x0 < _dirtyX0) _dirtyX0 = x0;
+    if (y0 < _dirtyY0) _dirtyY0 = y0;
+    if (x1 > _dirtyX1) _dirtyX1 = x1;
+    if (y1 > _dirtyY1) _dirtyY1 = y1;
+}
@@ -0,0 +1,169 @@
+/**
+ * ST7305_Gray.h
+ *
+ * Temporal-dither grayscale for the ST7305 Monochrome Display Driver
+ *
+ * The panel is 1 bit per pixel, so gray is shown by flipping pixels
+ * between black and white on successive panel refreshes. N bitplanes
+ * are kept; a pixel of level L (0 = black .. N = white) is white in L of
+ * the N planes. One plane is pushed per panel frame (or per k frames),
+ * paced by the refresh rate the init table sets with FRCTRL (0xB2), so
+ * the eye averages the planes to N + 1 levels.
+ *
+ * Which planes a gray pixel is white in is rotated by (x + y) mod N, so
+ * neighbouring pixels flip in different frames and the area shimmers
+ * rather than pulses. Black and white pixels are identical in every
+ * plane, hence each refresh only sends the regions where the next plane
+ * differs from the current one (cached until something is drawn).
+ *
+ * Drawing goes through Adafruit_GFX with the gray level as the color
+ * (values above N are white). Spans and rectangles are filled a byte
+ * at a time from precomputed pattern bytes.
+ *
+ * Usage:
+ *   ST7305_Grayscale gray(display);
+ *   gray.begin(3);                        // 4 levels, 3 x 15KB
+ *   gray.fillRect(20, 20, 100, 40, 1);    // Dark gray
+ *   gray.setTextColor(2);                 // Light gray
+ *   gray.print("Hello");
+ *   void loop() { gray.update(); }        // Next plane when a frame is due
+ *
+ * Notes:
+ * - Use high power mode: at 32 Hz, 3 planes cycle at about 11 Hz. Low
+ *   power rates (8 Hz and below) flicker visibly.
+ * - A plane delta must go out within one panel frame; size the SPI
+ *   clock for the gray area being shown.
+ */
+
+#ifndef ST7305_GRAY_H
+#define ST7305_GRAY_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include "ST7305_Mono.h"
+
+// Maximum bitplanes (levels = planes + 1); each plane is ST7305_BUFFER_SIZE bytes
+#define ST7305_GRAY_MAX_PLANES 3
+
+// Rectangles kept per plane transition; more are merged
+#define ST7305_GRAY_MAX_RECTS  16
+
+// ============================================================================
+// ST7305_Grayscale Class
+// ============================================================================
+
+class ST7305_Grayscale : public Adafruit_GFX {
+public:
+    /**
+     * Constructor
+     * @param display Initialized display used for output (its own frame
+     *                buffer is not touched)
+     */
+    ST7305_Grayscale(ST7305_Mono &display);
+
+    /**
+     * Destructor - Free the bitplanes
+     */
+    ~ST7305_Grayscale();
+
+    /**
+     * begin - Allocate the bitplanes, cleared to white
+     *
+     * The frame period is taken from display.getFramePeriodMicros().
+     * The first plane sent is a full frame.
+     *
+     * @param planes Number of bitplanes (1 .. ST7305_GRAY_MAX_PLANES)
+     * @return false if allocation fails
+     */
+    bool begin(uint8_t planes = ST7305_GRAY_MAX_PLANES);
+
+    /**
+     * levels - Number of gray levels (planes + 1)
+     */
+    uint8_t levels() const { return _planes + 1; }
+
+    // ========================================================================
+    // Drawing (color = gray level, 0 = black)
+    // ========================================================================
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void fillScreen(uint16_t color) override;
+
+    // ========================================================================
+    // Refresh
+    // ========================================================================
+
+    /**
+     * update - Push the next plane if a frame period has passed
+     *
+     * Call as often as possible from loop(). The cadence is kept on a
+     * fixed grid; if a call comes late by more than a period, the grid
+     * restarts from now.
+     *
+     * @return true if a plane was pushed
+     */
+    bool update();
+
+    /**
+     * showNextPlane - Push the next plane now (e.g. from a TE interrupt)
+     *
+     * Sends the cached delta between the current and next plane plus
+     * anything drawn since the last push.
+     */
+    void showNextPlane();
+
+    /**
+     * refresh - Resend the current plane as a full frame
+     */
+    void refresh();
+
+    /**
+     * setFramesPerPlane - Panel frames each plane stays on screen
+     *
+     * 1 (default) changes the plane every panel frame; higher values
+     * lower bus traffic at the cost of more visible flicker.
+     */
+    void setFramesPerPlane(uint8_t frames) { _framesPerPlane = (frames > 0) ? frames : 1; }
+
+    /**
+     * setFramePeriod - Override the period derived from FRCTRL
+     *
+     * @param micros Microseconds per panel frame
+     */
+    void setFramePeriod(uint32_t micros) { _period = micros; }
+
+    /**
+     * Status
+     */
+    uint8_t currentPlane() const { return _shown; }
+    uint32_t lastPushBytes() const { return _lastBytes; }   // Pixel bytes of the last push
+    uint8_t *getPlane(uint8_t plane) { return (plane < _planes) ? _plane[plane] : nullptr; }
+
+private:
+    ST7305_Mono &_display;
+
+    uint8_t *_memory;                                  // All planes
+    uint8_t *_plane[ST7305_GRAY_MAX_PLANES];
+    uint8_t _planes;
+    uint8_t _pattern[ST7305_GRAY_MAX_PLANES][ST7305_GRAY_MAX_PLANES + 1][ST7305_GRAY_MAX_PLANES];
+                                                       // [plane][level][(x + y) mod N of the byte's first pixel]
+    uint8_t _shown;                                    // Plane on the panel
+    uint32_t _period;                                  // Microseconds per panel frame
+    uint32_t _lastPush;
+    uint8_t _framesPerPlane;
+    uint32_t _lastBytes;
+
+    int16_t _dirtyX0, _dirtyY0, _dirtyX1, _dirtyY1;   // Drawn since the last push (empty if x0 > x1)
+    st7305_rect_t _delta[ST7305_GRAY_MAX_PLANES][ST7305_GRAY_MAX_RECTS]; // Plane i -> i + 1
+    uint8_t _deltaCount[ST7305_GRAY_MAX_PLANES];
+    bool _deltaValid[ST7305_GRAY_MAX_PLANES];          // Dropped when a non-empty dirty box is consumed
+
+    void fillSpan(int16_t pair, int16_t x0, int16_t x1, uint8_t rowMask, uint8_t level);
+    void computeDelta(uint8_t from);
+    void invalidate(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+};
+
+#endif // ST7305_GRAY_H
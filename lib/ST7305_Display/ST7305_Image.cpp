@@ -0,0 +1,431 @@
+/**
+ * ST7305_Image.cpp
+ *
+ * Streaming PBM / BMP / RLE decoder implementation
+ *
+ * Each format is parsed from a small read chunk and converted row by
+ * row: source pixels are collected into a single 1bpp row (visible
+ * columns only) and handed to the display's clipped blit, which packs
+ * them 4 pixels per buffer byte. 8-bit sources are reduced to 1 bit
+ * with a 4x4 ordered (Bayer) dither, which needs no error buffer.
+ */
+
+#include "ST7305_Image.h"
+
+// 4x4 Bayer thresholds (0-255) for ordered dithering of 8-bit sources
+static const uint8_t st7305_bayer4[4][4] = {
+    {   8, 136,  40, 168 },
+    { 200,  72, 232, 104 },
+    {  56, 184,  24, 152 },
+    { 248, 120, 216,  88 }
+};
+
+/**
+ * Constructor - Bind the decoder to a display
+ *
+ * @param display Display whose frame buffer receives decoded pixels
+ */
+ST7305_ImageDecoder::ST7305_ImageDecoder(ST7305_Mono &display)
+    : _display(display), _src(nullptr), _chunkLen(0), _chunkPos(0),
+      _format(ST7305_IMAGE_UNKNOWN), _width(0), _height(0),
+      _x(0), _y(0), _colStart(0), _colCount(0) {
+}
+
+/**
+ * Draw - Detect format from the magic bytes and decode
+ *
+ * @param src Stream positioned at the start of the image
+ * @param x   Left edge
+ * @param y   Top edge
+ * @return true on success
+ */
+bool ST7305_ImageDecoder::draw(Stream &src, int16_t x, int16_t y) {
+    beginSource(src);
+    _format = ST7305_IMAGE_UNKNOWN;
+
+    int a = readByte();
+    int b = readByte();
+
+    if ((a == 'P') && ((b == '1') || (b == '4'))) {
+        return decodePBM(b == '1', x, y);
+    }
+    if ((a == 'B') && (b == 'M')) {
+        return decodeBMP(x, y);
+    }
+    if ((a == 'S') && (b == 'R')) {
+        return decodeRLE(x, y);
+    }
+    return false;
+}
+
+/**
+ * Draw PBM / BMP / RLE - Decode a known format, checking its magic bytes
+ */
+bool ST7305_ImageDecoder::drawPBM(Stream &src, int16_t x, int16_t y) {
+    beginSource(src);
+    int a = readByte();
+    int b = readByte();
+    if ((a != 'P') || ((b != '1') && (b != '4'))) {
+        return false;
+    }
+    return decodePBM(b == '1', x, y);
+}
+
+bool ST7305_ImageDecoder::drawBMP(Stream &src, int16_t x, int16_t y) {
+    beginSource(src);
+    if ((readByte() != 'B') || (readByte() != 'M')) {
+        return false;
+    }
+    return decodeBMP(x, y);
+}
+
+bool ST7305_ImageDecoder::drawRLE(Stream &src, int16_t x, int16_t y) {
+    beginSource(src);
+    if ((readByte() != 'S') || (readByte() != 'R')) {
+        return false;
+    }
+    return decodeRLE(x, y);
+}
+
+// ===== PBM =====
+
+/**
+ * Decode PBM - P1 (ASCII) or P4 (binary) bitmap after the magic
+ *
+ * In PBM a 1 bit is black, the opposite of the panel convention.
+ * P4 rows are padded to whole bytes.
+ */
+bool ST7305_ImageDecoder::decodePBM(bool ascii, int16_t x, int16_t y) {
+    _format = ascii ? ST7305_IMAGE_PBM_ASCII : ST7305_IMAGE_PBM_BINARY;
+
+    uint16_t w, h;
+    if (!readPbmNumber(w) || !readPbmNumber(h) || (w == 0) || (h == 0)) {
+        return false;
+    }
+    beginImage(x, y, w, h);
+
+    for (uint16_t row = 0; row < h; row++) {
+        if (_format == ST7305_IMAGE_PBM_ASCII) {
+            for (uint16_t col = 0; col < w;) {
+                int c = readByte();
+                if (c < 0) {
+                    return false;
+                }
+                if ((c == '0') || (c == '1')) {
+                    setPixel(col++, c == '0');
+                }
+            }
+        } else {
+            for (uint16_t col = 0; col < w; col += 8) {
+                int c = readByte();
+                if (c < 0) {
+                    return false;
+                }
+                for (uint8_t bit = 0; (bit < 8) && (col + bit < w); bit++) {
+                    setPixel(col + bit, !(c & (0x80 >> bit)));
+                }
+            }
+        }
+        emitRow(row);
+    }
+    return true;
+}
+
+/**
+ * Read PBM Number - Parse one decimal header field
+ *
+ * Skips whitespace and '#' comments before the number and consumes the
+ * single whitespace byte after it (the last one precedes P4 data).
+ */
+bool ST7305_ImageDecoder::readPbmNumber(uint16_t &value) {
+    int c;
+    for (;;) {
+        c = readByte();
+        if (c < 0) {
+            return false;
+        }
+        if (c == '#') {
+            while ((c >= 0) && (c != '\n')) c = readByte();
+            continue;
+        }
+        if ((c >= '0') && (c <= '9')) {
+            break;
+        }
+    }
+
+    uint32_t v = 0;
+    while ((c >= '0') && (c <= '9')) {
+        v = v * 10 + (c - '0');
+        if (v > 0xFFFF) {
+            return false;
+        }
+        c = readByte();
+    }
+    value = (uint16_t)v;
+    return true;
+}
+
+// ===== BMP =====
+
+/**
+ * Decode BMP - Uncompressed 1-bit or 8-bit palettized bitmap after the magic
+ *
+ * Rows are stored bottom-up (unless the height is negative) and padded
+ * to 4 bytes. Palette entries are reduced to luma once; 1-bit images
+ * threshold it, 8-bit images dither it against the panel position.
+ */
+bool ST7305_ImageDecoder::decodeBMP(int16_t x, int16_t y) {
+    _format = ST7305_IMAGE_BMP;
+
+    // Rest of BITMAPFILEHEADER (14 bytes including the magic)
+    uint32_t fileSize, reserved, dataOffset;
+    if (!readU32(fileSize) || !readU32(reserved) || !readU32(dataOffset)) {
+        return false;
+    }
+
+    // BITMAPINFOHEADER (40 bytes or larger)
+    uint32_t dibSize, width, height, compression, imageSize, ppmX, ppmY, colorsUsed, important;
+    uint16_t planes, bpp;
+    if (!readU32(dibSize) || (dibSize < 40) ||
+        !readU32(width) || !readU32(height) || !readU16(planes) || !readU16(bpp) ||
+        !readU32(compression) || !readU32(imageSize) || !readU32(ppmX) || !readU32(ppmY) ||
+        !readU32(colorsUsed) || !readU32(important)) {
+        return false;
+    }
+    if (((bpp != 1) && (bpp != 8)) || (compression != 0)) {
+        return false;
+    }
+
+    int32_t w = (int32_t)width;
+    int32_t h = (int32_t)height;
+    bool topDown = h < 0;
+    if (topDown) h = -h;
+    if ((w <= 0) || (w > 0xFFFF) || (h == 0) || (h > 0xFFFF)) {
+        return false;
+    }
+    if (!skipBytes(dibSize - 40)) {
+        return false;
+    }
+
+    // Palette: BGRA entries -> luma
+    uint32_t entries = colorsUsed ? colorsUsed : (1UL << bpp);
+    if (entries > 256) {
+        return false;
+    }
+    memset(_luma, 0, sizeof(_luma));
+    for (uint32_t i = 0; i < entries; i++) {
+        uint8_t bgra[4];
+        if (!readBytes(bgra, 4)) {
+            return false;
+        }
+        _luma[i] = (uint8_t)((bgra[2] * 77 + bgra[1] * 150 + bgra[0] * 29) >> 8);
+    }
+
+    uint32_t consumed = 14 + dibSize + entries * 4;
+    if ((dataOffset < consumed) || !skipBytes(dataOffset - consumed)) {
+        return false;
+    }
+
+    beginImage(x, y, w, h);
+    uint32_t stride = ((uint32_t)w * bpp + 31) / 32 * 4;
+    uint32_t used = ((uint32_t)w * bpp + 7) / 8;
+
+    for (int32_t fileRow = 0; fileRow < h; fileRow++) {
+        uint16_t row = topDown ? fileRow : h - 1 - fileRow;
+        int16_t py = y + row;
+
+        if (bpp == 1) {
+            for (uint32_t col = 0; col < (uint32_t)w; col += 8) {
+                int c = readByte();
+                if (c < 0) {
+                    return false;
+                }
+                for (uint8_t bit = 0; (bit < 8) && (col + bit < (uint32_t)w); bit++) {
+                    uint8_t index = (c >> (7 - bit)) & 1;
+                    setPixel(col + bit, _luma[index] >= 128);
+                }
+            }
+        } else {
+            for (uint32_t col = 0; col < (uint32_t)w; col++) {
+                int c = readByte();
+                if (c < 0) {
+                    return false;
+                }
+                int16_t px = x + col;
+                setPixel(col, _luma[c] > st7305_bayer4[py & 3][px & 3]);
+            }
+        }
+
+        if (!skipBytes(stride - used)) {
+            return false;
+        }
+        emitRow(row);
+    }
+    return true;
+}
+
+// ===== RLE =====
+
+/**
+ * Decode RLE - Simple "SR" run-length image after the magic
+ *
+ * Runs may cross row boundaries; each completed row is emitted.
+ */
+bool ST7305_ImageDecoder::decodeRLE(int16_t x, int16_t y) {
+    _format = ST7305_IMAGE_RLE;
+
+    uint16_t w, h;
+    if (!readU16(w) || !readU16(h) || (w == 0) || (h == 0)) {
+        return false;
+    }
+    beginImage(x, y, w, h);
+
+    uint16_t row = 0;
+    uint16_t col = 0;
+    while (row < h) {
+        int c = readByte();
+        if (c < 0) {
+            return false;
+        }
+        bool white = c & 0x80;
+        uint8_t run = (c & 0x7F) + 1;
+        while (run--) {
+            setPixel(col++, white);
+            if (col == w) {
+                emitRow(row++);
+                col = 0;
+                if (row == h) {
+                    break;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// ===== Source Reading =====
+
+/**
+ * Begin Source - Attach a stream and drop any buffered bytes
+ */
+void ST7305_ImageDecoder::beginSource(Stream &src) {
+    _src = &src;
+    _chunkLen = 0;
+    _chunkPos = 0;
+}
+
+/**
+ * Read Byte - Next byte from the chunk, refilling it as needed
+ *
+ * @return Byte value, or -1 at end of stream / timeout
+ */
+int ST7305_ImageDecoder::readByte() {
+    if (_chunkPos >= _chunkLen) {
+        _chunkLen = _src->readBytes(_chunk, ST7305_IMAGE_CHUNK);
+        _chunkPos = 0;
+        if (_chunkLen == 0) {
+            return -1;
+        }
+    }
+    return _chunk[_chunkPos++];
+}
+
+bool ST7305_ImageDecoder::readBytes(uint8_t *dst, uint32_t len) {
+    while (len--) {
+        int c = readByte();
+        if (c < 0) {
+            return false;
+        }
+        *dst++ = (uint8_t)c;
+    }
+    return true;
+}
+
+bool ST7305_ImageDecoder::skipBytes(uint32_t len) {
+    while (len--) {
+        if (readByte() < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ST7305_ImageDecoder::readU16(uint16_t &value) {
+    uint8_t b[2];
+    if (!readBytes(b, 2)) {
+        return false;
+    }
+    value = b[0] | ((uint16_t)b[1] << 8);
+    return true;
+}
+
+bool ST7305_ImageDecoder::readU32(uint32_t &value) {
+    uint8_t b[4];
+    if (!readBytes(b, 4)) {
+        return false;
+    }
+    value = b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+    return true;
+}
+
+// ===== Row Assembly =====
+
+/**
+ * Begin Image - Record geometry and work out which columns are visible
+ *
+ * Only columns that land inside the active clip (after the viewport
+ * origin) are kept in the row buffer, so arbitrarily wide images still
+ * use a single panel-width row and clipped columns cost nothing.
+ */
+void ST7305_ImageDecoder::beginImage(int16_t x, int16_t y, uint16_t w, uint16_t h) {
+    // Rows come from a reused buffer, so they cannot be recorded
+    if (_display.isRecording()) {
+        _display.flattenRecording();
+    }
+
+    _x = x;
+    _y = y;
+    _width = w;
+    _height = h;
+
+    // Visible columns: the image's absolute span cut to the clip
+    st7305_rect_t clip = _display.getClipRect();
+    int32_t left = (int32_t)x + _display.getOrigin().x;
+    int32_t first = (left > clip.x) ? left : clip.x;
+    int32_t last = left + w - 1;
+    if (last > (int32_t)clip.x + clip.w - 1) {
+        last = (int32_t)clip.x + clip.w - 1;
+    }
+    _colStart = 0;
+    _colCount = 0;
+    if (first <= last) {
+        _colStart = first - left;
+        _colCount = last - first + 1;  // At most the clip width
+    }
+    memset(_row, 0, sizeof(_row));
+}
+
+/**
+ * Set Pixel - Store one source pixel in the row buffer if visible
+ */
+void ST7305_ImageDecoder::setPixel(uint16_t col, bool white) {
+    uint16_t i = col - _colStart;
+    if ((col < _colStart) || (i >= _colCount)) {
+        return;
+    }
+    if (white) {
+        _row[i >> 3] |= 0x80 >> (i & 7);
+    } else {
+        _row[i >> 3] &= ~(0x80 >> (i & 7));
+    }
+}
+
+/**
+ * Emit Row - Blit the assembled row into the frame buffer
+ */
+void ST7305_ImageDecoder::emitRow(uint16_t row) {
+    if (_colCount > 0) {
+        _display.drawBitmap(_x + _colStart, _y + row, _row, _colCount, 1,
+                            ST7305_WHITE, ST7305_BLACK);
+    }
+}
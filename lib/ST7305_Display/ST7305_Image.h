@@ -0,0 +1,128 @@
+/**
+ * ST7305_Image.h
+ *
+ * Streaming image decoder for the ST7305 Monochrome Display Driver
+ *
+ * Decodes images from any Arduino Stream (SD File, flash file system,
+ * Serial, ...) straight into the packed frame buffer:
+ * - PBM: P1 (ASCII) and P4 (binary)
+ * - BMP: uncompressed 1-bit and 8-bit palettized (8-bit is dithered)
+ * - RLE: simple 1bpp run-length format (see below)
+ *
+ * RAM use is constant regardless of image size: a small read chunk,
+ * one 1bpp row of panel width and a 256-byte palette luma table.
+ * No intermediate bitmap is allocated, so this fits next to the 15KB
+ * frame buffer.
+ *
+ * RLE Format ("SR"):
+ *   Byte 0-1: 'S', 'R'
+ *   Byte 2-3: Width  (uint16, little-endian)
+ *   Byte 4-5: Height (uint16, little-endian)
+ *   Then runs of pixels in row-major order, wrapping across rows:
+ *     bit 7    = color (1 = white, 0 = black)
+ *     bits 6-0 = run length - 1 (1..128 pixels)
+ *
+ * Usage:
+ *   File f = SD.open("/splash.bmp");
+ *   ST7305_ImageDecoder decoder(display);
+ *   if (decoder.draw(f, 0, 0)) display.display();
+ */
+
+#ifndef ST7305_IMAGE_H
+#define ST7305_IMAGE_H
+
+#include <Arduino.h>
+#include "ST7305_Mono.h"
+
+// Bytes read from the source per refill
+#define ST7305_IMAGE_CHUNK 32
+
+/**
+ * Image formats recognized by ST7305_ImageDecoder
+ */
+typedef enum {
+    ST7305_IMAGE_UNKNOWN = 0,
+    ST7305_IMAGE_PBM_ASCII,   // P1
+    ST7305_IMAGE_PBM_BINARY,  // P4
+    ST7305_IMAGE_BMP,         // BM, 1 or 8 bits per pixel
+    ST7305_IMAGE_RLE          // SR
+} st7305_image_format_t;
+
+// ============================================================================
+// ST7305_ImageDecoder Class
+// ============================================================================
+
+class ST7305_ImageDecoder {
+public:
+    /**
+     * Constructor
+     * @param display Target display; images are drawn into its buffer
+     *                through the clipped blit path
+     */
+    ST7305_ImageDecoder(ST7305_Mono &display);
+
+    /**
+     * draw - Detect the format from the first bytes and decode
+     *
+     * Pixels are drawn white/black as decoded (opaque). The active clip
+     * and viewport of the display apply; the source is always read to
+     * the end of the image even if it is partly off-screen.
+     * In recording mode the frame is flattened first (decoded rows
+     * cannot be kept by reference), see ST7305_Mono::flattenRecording().
+     *
+     * @param src Stream positioned at the start of the image
+     * @param x   Left edge on the display
+     * @param y   Top edge on the display
+     * @return true on success, false on unsupported format or short read
+     */
+    bool draw(Stream &src, int16_t x, int16_t y);
+
+    /**
+     * Format-specific entry points (stream positioned at the magic bytes)
+     */
+    bool drawPBM(Stream &src, int16_t x, int16_t y);
+    bool drawBMP(Stream &src, int16_t x, int16_t y);
+    bool drawRLE(Stream &src, int16_t x, int16_t y);
+
+    /**
+     * Properties of the last decoded (or attempted) image
+     */
+    st7305_image_format_t format() const { return _format; }
+    uint16_t width() const { return _width; }
+    uint16_t height() const { return _height; }
+
+private:
+    ST7305_Mono &_display;
+    Stream *_src;
+
+    uint8_t _chunk[ST7305_IMAGE_CHUNK];       // Read buffer
+    uint8_t _chunkLen, _chunkPos;
+    uint8_t _row[(ST7305_WIDTH + 7) / 8];     // One visible row, 1bpp, 1 = white
+    uint8_t _luma[256];                       // Palette index -> luma (BMP)
+
+    st7305_image_format_t _format;
+    uint16_t _width, _height;
+    int16_t _x, _y;                           // Image origin
+    uint16_t _colStart, _colCount;            // Visible source columns kept in _row
+
+    // Format decoders (magic bytes already consumed)
+    bool decodePBM(bool ascii, int16_t x, int16_t y);
+    bool decodeBMP(int16_t x, int16_t y);
+    bool decodeRLE(int16_t x, int16_t y);
+
+    // Source reading
+    void beginSource(Stream &src);
+    int readByte();
+    bool readBytes(uint8_t *dst, uint32_t len);
+    bool skipBytes(uint32_t len);
+    bool readU16(uint16_t &value);
+    bool readU32(uint32_t &value);
+    bool readPbmNumber(uint16_t &value);
+
+    // Row assembly
+    void beginImage(int16_t x, int16_t y, uint16_t w, uint16_t h);
+    void setPixel(uint16_t col, bool white);
+    void emitRow(uint16_t row);
+};
+
+#endif // ST7305_IMAGE_H
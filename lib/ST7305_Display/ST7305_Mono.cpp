@@ -18,6 +18,26 @@
 
 #include "ST7305_Mono.h"
 
+// Display list command types (st7305_dl_cmd_t::op)
+#define ST7305_DL_PIXEL     0
+#define ST7305_DL_RECT      1
+#define ST7305_DL_LINE      2
+#define ST7305_DL_POLY      3
+#define ST7305_DL_BITMAP    4
+#define ST7305_DL_PACKED    5
+#define ST7305_DL_CHAR      6
+#define ST7305_DL_DEFERRED  7
+#define ST7305_DL_CIRCLE    8
+#define ST7305_DL_ROUNDRECT 9
+#define ST7305_DL_TRIANGLE  10
+
+// Display list command flags (st7305_dl_cmd_t::flags)
+#define ST7305_DL_COLOR     0x01  // Foreground is white
+#define ST7305_DL_BG        0x02  // Background is white
+#define ST7305_DL_OPAQUE    0x04  // Every pixel in the bounds is written
+#define ST7305_DL_HAS_BG    0x08  // Glyph draws its background cell
+#define ST7305_DL_FILL      0x10  // Filled shape
+
 /**
  * Constructor - Initialize display driver
  * 
@@ -27,35 +47,106 @@
  */
 ST7305_Mono::ST7305_Mono(int8_t dc, int8_t rst, int8_t cs)
     : Adafruit_GFX(ST7305_WIDTH, ST7305_HEIGHT),
-      _dc(dc), _rst(rst), _cs(cs), buffer(nullptr) {
+      _dc(dc), _rst(rst), _cs(cs), buffer(nullptr), _ownBuffer(nullptr),
+      _dl(nullptr), _dlMode(ST7305_DL_IMMEDIATE), _dlFlattened(false),
+      _frameRate(0x12), _lowPower(false), _budgetCredit(0), _presentTime(0), _pendingSince(0),
+      _pendingCost(0), _sendTime(0), _sendMicros(0), _pending(false), _sent(false),
+      _transformsEnabled(0), _jobPhase(ST7305_JOB_IDLE), _jobRender(false), _jobTile(0),
+      _jobX0(0), _jobX1(0), _jobPair(0), _jobPair1(0), _jobTileMicros(0), _jobByteNanos(0), _panel(nullptr), _waitStart(0), _waitMs(0), _trace(nullptr),
+      _glyphCanvas(8, 8) {
+    resetClip();
+    clearDirty();
+    memset(&_dlStats, 0, sizeof(_dlStats));
+    memset(&_spiStats, 0, sizeof(_spiStats));
+    memset(&_budget, 0, sizeof(_budget));
+    memset(&_frameReport, 0, sizeof(_frameReport));
+    memset(_transforms, 0, sizeof(_transforms));
+    memset(&_jobProgress, 0, sizeof(_jobProgress));
+    _energy.nanojoulesPerByte = ST7305_ENERGY_NJ_PER_BYTE;
+    _energy.highPowerMicrowatts = ST7305_ENERGY_HPM_UW;
+    _energy.lowPowerMicrowatts = ST7305_ENERGY_LPM_UW;
+    _spiConfig.commandHz = 0;
+    _spiConfig.dataHz = 0;
+    _spiConfig.chunkBytes = ST7305_SPI_CHUNK;
 }
 
 /**
  * Destructor - Free allocated frame buffer
  */
 ST7305_Mono::~ST7305_Mono() {
-    if (buffer) {
-        free(buffer);
-        buffer = nullptr;
+    if (_ownBuffer) {
+        free(_ownBuffer);
+        _ownBuffer = nullptr;
+    }
+    buffer = nullptr;
+    if (_dl) {
+        free(_dl);
+        _dl = nullptr;
     }
 }
 
 /**
- * Initialize display - Configure hardware and allocate buffer
+ * Initialize display - Configure hardware and initialize a known panel
  * 
  * This function:
  * 1. Configures GPIO pins for SPI communication
  * 2. Initializes SPI bus with specified frequency
  * 3. Allocates 15KB frame buffer
  * 4. Performs hardware reset
- * 5. Sends initialization command sequence
+ * 5. Sends the panel's encoded init sequence
  * 
  * @param spiFrequency SPI clock frequency (default 1MHz, max 40MHz tested)
- * @param initCmds     Pointer to init command array (defaults to ACTIVE_INIT_CMDS)
+ * @param panel        Panel profile (ST7305_PANEL_*)
+ * @return true if initialization successful, false if buffer allocation
+ *         fails or the panel is unknown
+ */
+bool ST7305_Mono::begin(uint32_t spiFrequency, st7305_panel_t panel) {
+    const st7305_panel_profile_t *profile = st7305_get_panel(panel);
+    if (!profile) {
+        return false;
+    }
+    return begin(spiFrequency, *profile);
+}
+
+/**
+ * Initialize display - Custom profile
+ * 
+ * @param spiFrequency SPI clock frequency
+ * @param profile      Profile with an encoded init sequence (must outlive the display)
+ * @return true if initialization successful, false if buffer allocation fails
+ */
+bool ST7305_Mono::begin(uint32_t spiFrequency, const st7305_panel_profile_t &profile) {
+    if (!setup(spiFrequency)) {
+        return false;
+    }
+    _panel = &profile;
+    sendInitSequence(profile.init);
+    return true;
+}
+
+/**
+ * Initialize display - Custom init command table
+ * 
+ * @param spiFrequency SPI clock frequency
+ * @param initCmds     Pointer to init command array
  * @param cmdCount     Number of commands in array
  * @return true if initialization successful, false if buffer allocation fails
  */
 bool ST7305_Mono::begin(uint32_t spiFrequency, const st7305_lcd_init_cmd_t* initCmds, size_t cmdCount) {
+    if (!setup(spiFrequency)) {
+        return false;
+    }
+    _panel = nullptr;
+    initDisplay(initCmds, cmdCount);
+    return true;
+}
+
+/**
+ * Setup - Pins, SPI, frame buffer and hardware reset (common to begin())
+ * 
+ * @return false if out of memory
+ */
+bool ST7305_Mono::setup(uint32_t spiFrequency) {
     // Configure pins
     pinMode(_dc, OUTPUT);
     pinMode(_cs, OUTPUT);
@@ -66,21 +157,22 @@ bool ST7305_Mono::begin(uint32_t spiFrequency, const st7305_lcd_init_cmd_t* init
     // Initialize SPI with specified frequency and mode
     // Mode 0: CPOL=0, CPHA=0, MSBFIRST
     SPI.begin();
-    spiSettings = SPISettings(spiFrequency, MSBFIRST, SPI_MODE0);
+    setSpiClocks(spiFrequency, spiFrequency);
     
     // Allocate frame buffer: (300/4) × (400/2) = 15,000 bytes
-    buffer = (uint8_t*)malloc(ST7305_BUFFER_SIZE);
-    if (!buffer) {
-        return false;  // Out of memory
+    if (!_ownBuffer) {
+        _ownBuffer = (uint8_t*)malloc(ST7305_BUFFER_SIZE);
+        if (!_ownBuffer) {
+            return false;  // Out of memory
+        }
     }
+    buffer = _ownBuffer;
     
     // Clear buffer to white (0xFF for white background)
     memset(buffer, 0xFF, ST7305_BUFFER_SIZE);
     
-    // Perform hardware reset and send init commands
+    // Perform hardware reset (the recovery time runs until the first command)
     hardwareReset();
-    initDisplay(initCmds, cmdCount);
-    
     return true;
 }
 
@@ -92,7 +184,8 @@ bool ST7305_Mono::begin(uint32_t spiFrequency, const st7305_lcd_init_cmd_t* init
  * 2. RST LOW for 10ms (reset active)
  * 3. RST HIGH for 120ms (recovery time)
  * 
- * Total reset time: ~140ms
+ * Total reset time: ~140ms. The recovery time is left pending (see
+ * waitReady()), so the first init command is what waits for it.
  */
 void ST7305_Mono::hardwareReset() {
     if (_rst >= 0) {
@@ -101,32 +194,27 @@ void ST7305_Mono::hardwareReset() {
         digitalWrite(_rst, LOW);
         delay(10);
         digitalWrite(_rst, HIGH);
-        delay(120);  // Wait for reset to complete
+        startWait(120);  // Wait for reset to complete
     }
 }
 
 /**
- * Initialize Display - Send initialization command sequence
+ * Initialize Display - Send an init command table
  * 
- * Iterates through the selected init command array (configured via ACTIVE_INIT_CMDS).
  * Each command structure contains:
  * - cmd: Command byte to send
  * - data[]: Array of up to 10 data bytes
  * - len: Number of data bytes to send
  * - delay_ms: Milliseconds to delay after command
  * 
- * Available configurations:
- * - st7305_init_cmds_default: Standard initialization
- * - st7305_init_cmds_FT_tele: FT_tele reference implementation
- * - st7305_init_cmds_kevin: Custom configuration
- * - st7305_init_cmds_mfg: Manufacturer settings
- * 
  * @param st7305_init_cmds Pointer to init command array
  * @param cmd_count        Number of commands in array
  */
 void ST7305_Mono::initDisplay(const st7305_lcd_init_cmd_t* st7305_init_cmds, size_t cmd_count) {
     
     for (size_t i = 0; i < cmd_count; i++) {
+        noteInitCommand(st7305_init_cmds[i].cmd, st7305_init_cmds[i].len, st7305_init_cmds[i].data[0]);
+        
         sendCommand(st7305_init_cmds[i].cmd);
         for (uint8_t j = 0; j < st7305_init_cmds[i].len; j++) {
             sendData(st7305_init_cmds[i].data[j]);
@@ -137,6 +225,98 @@ void ST7305_Mono::initDisplay(const st7305_lcd_init_cmd_t* st7305_init_cmds, siz
     }
 }
 
+/**
+ * Send Init Sequence - Stream an encoded init sequence (see ST7305_Panels.h)
+ * 
+ * Commands are sent back to back in one SPI transaction with CS held
+ * low, toggling DC between the command byte and its parameters. The
+ * transaction is only closed when a delay is still running before the
+ * next command. A delay is recorded rather than slept, so it overlaps
+ * the next sequence step, the end of begin() and the sketch's drawing;
+ * the trailing Display On delay is usually over before the first
+ * display().
+ * 
+ * @param sequence Encoded sequence (PROGMEM)
+ */
+void ST7305_Mono::sendInitSequence(const uint8_t *sequence) {
+    uint8_t count = pgm_read_byte(sequence++);
+    bool open = false;
+    
+    while (count--) {
+        uint8_t cmd = pgm_read_byte(sequence++);
+        uint8_t len = pgm_read_byte(sequence++);
+        bool hasDelay = (len & ST7305_INIT_DELAY) != 0;
+        len &= ~ST7305_INIT_DELAY;
+        noteInitCommand(cmd, len, (len > 0) ? pgm_read_byte(sequence) : 0);
+        
+        if (_waitMs && open) {  // Let the bus go while the controller is busy
+            SPI.endTransaction();
+            csHigh();
+            open = false;
+        }
+        waitReady();
+        if (!open) {
+            csLow();
+            SPI.beginTransaction(_commandSettings);
+            open = true;
+        }
+        
+        if (_trace) {
+            _trace->command(cmd);
+        }
+        dcLow();
+        SPI.transfer(cmd);
+        dcHigh();
+        for (uint8_t i = 0; i < len; i++) {
+            uint8_t value = pgm_read_byte(sequence++);
+            if (_trace) {
+                _trace->data(value);
+            }
+            SPI.transfer(value);
+        }
+        _spiStats.commands++;
+        _spiStats.dataBytes += len;
+        _spiStats.transfers += 1 + len;
+        if (hasDelay) {
+            startWait(pgm_read_byte(sequence++));
+        }
+    }
+    if (open) {
+        SPI.endTransaction();
+        csHigh();
+    }
+}
+
+/**
+ * Note Init Command - Remember the refresh timing for getFramePeriodMicros()
+ * 
+ * @param cmd   Command byte
+ * @param len   Number of parameters
+ * @param first First parameter (if len > 0)
+ */
+void ST7305_Mono::noteInitCommand(uint8_t cmd, uint8_t len, uint8_t first) {
+    if ((cmd == ST7305_FRCTRL) && (len > 0)) {
+        _frameRate = first;
+    } else if (cmd == ST7305_HPM) {
+        _lowPower = false;
+    } else if (cmd == ST7305_LPM) {
+        _lowPower = true;
+    }
+}
+
+/**
+ * Wait Ready - Block until a pending controller delay has elapsed
+ */
+void ST7305_Mono::waitReady() {
+    if (_waitMs == 0) {
+        return;
+    }
+    while ((uint32_t)(millis() - _waitStart) < _waitMs) {
+        yield();
+    }
+    _waitMs = 0;
+}
+
 /**
  * Draw Pixel - Set or clear a single pixel in the frame buffer
  * 
@@ -166,14 +346,27 @@ void ST7305_Mono::initDisplay(const st7305_lcd_init_cmd_t* st7305_init_cmds, siz
  * Single Byte Layout (bits 7-0):
  *   [x+0,y+0] [x+0,y+1] [x+1,y+0] [x+1,y+1] [x+2,y+0] [x+2,y+1] [x+3,y+0] [x+3,y+1]
  *   
+ * Coordinates are relative to the active viewport and clipped against
+ * the active clip rectangle (full panel by default).
+ *   
  * @param x     X coordinate (0-299)
  * @param y     Y coordinate (0-399)
  * @param color 0=BLACK, 1=WHITE
  */
 void ST7305_Mono::drawPixel(int16_t x, int16_t y, uint16_t color) {
-    if ((x < 0) || (x >= ST7305_WIDTH) || (y < 0) || (y >= ST7305_HEIGHT)) {
+    int32_t ax = (int32_t)x + _originX;
+    int32_t ay = (int32_t)y + _originY;
+    if ((ax < _clipX0) || (ax > _clipX1) || (ay < _clipY0) || (ay > _clipY1)) {
         return;
     }
+    x = ax;
+    y = ay;
+    if (_dlMode != ST7305_DL_IMMEDIATE) {
+        if (recordCommand(ST7305_DL_PIXEL, color ? ST7305_DL_COLOR : 0, x, y, x, y)) {
+            return;
+        }
+    }
+    markDirty(x, y, x, y);
     
     // ST7305 memory layout matching reference code:
     // 4 pixels horizontally, 2 rows vertically per byte
@@ -195,200 +388,3670 @@ void ST7305_Mono::drawPixel(int16_t x, int16_t y, uint16_t color) {
     }
 }
 
+// ===== Batched Pixel Plotting =====
+
 /**
- * Display - Transfer frame buffer to display hardware
- * 
- * This function sends the entire 15KB frame buffer to the display using SPI.
- * 
- * Sequence:
- * 1. Set column address range (0x2A): 0x12 to 0x2A
- * 2. Set row address range (0x2B): 0x00 to 0xC7
- * 3. Send memory write command (0x2C)
- * 4. Transfer all 15,000 bytes via SPI in one transaction
+ * Draw Pixels - Batched plot, single color
  * 
- * Address ranges match reference implementation:
- * - Column: 0x12 (18) to 0x2A (42)
- * - Row: 0x00 (0) to 0xC7 (199)
+ * @param points Point array (viewport coordinates)
+ * @param count  Number of points
+ * @param color  0=BLACK, 1=WHITE
+ */
+void ST7305_Mono::drawPixels(const st7305_point_t *points, size_t count, uint16_t color) {
+    plotPixels(points, nullptr, count, color);
+}
+
+/**
+ * Draw Pixels - Batched plot, color per point
  * 
- * Performance:
- * - @ 1MHz: ~300ms for full screen update
- * - @ 40MHz: ~100ms for full screen update
+ * @param points Point array (viewport coordinates)
+ * @param colors Color per point (0=BLACK, nonzero=WHITE)
+ * @param count  Number of points
+ */
+void ST7305_Mono::drawPixels(const st7305_point_t *points, const uint16_t *colors, size_t count) {
+    plotPixels(points, colors, count, 0);
+}
+
+/**
+ * Plot Pixels - Clip and update each point's bit without branches
  * 
- * Note: This transfers the entire buffer. For partial updates,
- * implement custom address windowing.
+ * Points are applied in submission order, so the last one on a pixel
+ * wins. The bit is replaced with a mask select instead of a set/clear
+ * branch, and the dirty bounds are taken once for the whole call, so
+ * a point costs less than a drawPixel() call. Sorting or bucketing the
+ * points by byte was measured slower: on a RAM buffer, the merged
+ * stores never paid for the extra pass or the mispredicted run breaks.
  */
-void ST7305_Mono::display() {
-    // Set column address range
-    sendCommand(ST7305_CASET);
-    sendData(0x12);  // Start column
-    sendData(0x2A);  // End column
+void ST7305_Mono::plotPixels(const st7305_point_t *points, const uint16_t *colors, size_t count,
+                             uint16_t color) {
+    if (_dlMode != ST7305_DL_IMMEDIATE) {  // Recorded point by point
+        for (size_t i = 0; i < count; i++) {
+            drawPixel(points[i].x, points[i].y, colors ? colors[i] : color);
+        }
+        return;
+    }
     
-    // Set row address range
-    sendCommand(ST7305_RASET);
-    sendData(0x00);  // Start row
-    sendData(0xC7);  // End row
+    int16_t dirtyX0 = INT16_MAX, dirtyY0 = INT16_MAX;
+    int16_t dirtyX1 = INT16_MIN, dirtyY1 = INT16_MIN;
+    uint8_t fill = color ? 0xFF : 0x00;
     
-    // Write RAM command
-    sendCommand(ST7305_RAMWR);
+    for (size_t i = 0; i < count; i++) {
+        int32_t ax = (int32_t)points[i].x + _originX;
+        int32_t ay = (int32_t)points[i].y + _originY;
+        if ((ax < _clipX0) || (ax > _clipX1) || (ay < _clipY0) || (ay > _clipY1)) {
+            continue;
+        }
+        int16_t x = ax;
+        int16_t y = ay;
+        if (x < dirtyX0) dirtyX0 = x;
+        if (x > dirtyX1) dirtyX1 = x;
+        if (y < dirtyY0) dirtyY0 = y;
+        if (y > dirtyY1) dirtyY1 = y;
+        
+        if (colors) {
+            fill = colors[i] ? 0xFF : 0x00;
+        }
+        uint8_t m = 0x80 >> (((x & 3) << 1) | (y & 1));
+        uint8_t *b = &buffer[(y >> 1) * ST7305_BYTES_PER_ROW + (x >> 2)];
+        *b = (*b & ~m) | (fill & m);
+    }
     
-    // Send entire buffer in one SPI transaction for efficiency
-    digitalWrite(_dc, HIGH);  // Data mode
-    digitalWrite(_cs, LOW);   // Select display
-    SPI.beginTransaction(spiSettings);
-    SPI.transfer(buffer, ST7305_BUFFER_SIZE);  // Send all 15,000 bytes
-    SPI.endTransaction();
-    digitalWrite(_cs, HIGH);  // Deselect display
+    if (dirtyX0 <= dirtyX1) {
+        markDirty(dirtyX0, dirtyY0, dirtyX1, dirtyY1);
+    }
 }
 
+// ===== Span-Based Fill Primitives =====
+
 /**
- * Clear Display - Fill frame buffer with black
+ * Draw Fast Horizontal Line - Packed span fill
  * 
- * Sets all buffer bytes to 0x00 (black pixels).
- * Call display() afterwards to update the screen.
+ * @param x     Start X coordinate
+ * @param y     Y coordinate
+ * @param w     Width in pixels (negative draws to the left)
+ * @param color 0=BLACK, 1=WHITE
  */
-void ST7305_Mono::clearDisplay() {
-    memset(buffer, 0x00, ST7305_BUFFER_SIZE);  // Clear to black (0x00)
+void ST7305_Mono::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    fillRect(x, y, w, 1, color);
 }
 
 /**
- * Fill - Fill frame buffer with specified byte value
+ * Draw Fast Vertical Line - Packed column fill
  * 
- * Useful for:
- * - 0x00: All black
- * - 0xFF: All white
- * - 0xAA/0x55: Checkerboard patterns
+ * Writes one bit pair per row-pair instead of two separate pixels.
  * 
- * @param data Byte value to fill buffer with
+ * @param x     X coordinate
+ * @param y     Start Y coordinate
+ * @param h     Height in pixels (negative draws upwards)
+ * @param color 0=BLACK, 1=WHITE
  */
-void ST7305_Mono::fill(uint8_t data) {
-    memset(buffer, data, ST7305_BUFFER_SIZE);
+void ST7305_Mono::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    fillRect(x, y, 1, h, color);
 }
 
 /**
- * Invert Display - Hardware pixel inversion
- * 
- * Inverts all pixels on the display:
- * - Black becomes white
- * - White becomes black
+ * Fill Rectangle - Clip once, then fill row-pairs with whole bytes
  * 
- * This is a hardware feature and doesn't modify the frame buffer.
+ * Rows are processed in pairs so that interior row-pairs are written
+ * with a single byte store (memset) instead of two masked updates.
+ * A leading odd row or trailing even row is written with its row mask.
  * 
- * @param invert true to invert, false for normal display
+ * @param x, y  Top-left corner
+ * @param w, h  Size in pixels (negative values are normalized)
+ * @param color 0=BLACK, 1=WHITE
  */
-void ST7305_Mono::invertDisplay(bool invert) {
-    sendCommand(invert ? ST7305_INVON : ST7305_INVOFF);
+void ST7305_Mono::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (w < 0) { x += w + 1; w = -w; }
+    if (h < 0) { y += h + 1; h = -h; }
+    
+    int32_t x0 = (int32_t)x + _originX;
+    int32_t y0 = (int32_t)y + _originY;
+    fillRectAbsolute(x0, y0, x0 + w - 1, y0 + h - 1, color);
 }
 
 /**
- * Set Contrast - Adjust display contrast (placeholder)
- * 
- * ST7305 doesn't have a simple contrast command.
- * Contrast adjustment requires modifying voltage/gamma settings.
- * Implement this by adjusting specific voltage commands in init sequence.
+ * Fill Screen - Fill entire buffer (or the active clip) with one color
  * 
- * @param contrast Contrast value (not currently used)
+ * @param color 0=BLACK (0x00), 1=WHITE (0xFF)
  */
-void ST7305_Mono::setContrast(uint8_t contrast) {
-    // ST7305 doesn't have a simple contrast command
-    // Contrast would need to be adjusted through gamma/voltage settings
-    // This is a placeholder - implement if needed with specific voltage adjustments
+void ST7305_Mono::fillScreen(uint16_t color) {
+    if ((_clipX0 == 0) && (_clipY0 == 0) &&
+        (_clipX1 == ST7305_WIDTH - 1) && (_clipY1 == ST7305_HEIGHT - 1)) {
+        fill(color ? 0xFF : 0x00);
+    } else {
+        fillRectAbsolute(_clipX0, _clipY0, _clipX1, _clipY1, color);
+    }
 }
 
 /**
- * Set High Power Mode - Enter high power mode
- * 
- * Sends 0xB9 command for high power operation.
+ * Fill Rect Absolute - Clip an inclusive absolute rectangle once and fill it
  */
-void ST7305_Mono::setHighPowerMode() {
-    sendCommand(ST7305_HPM);
+void ST7305_Mono::fillRectAbsolute(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t color) {
+    if (x0 < _clipX0) x0 = _clipX0;
+    if (y0 < _clipY0) y0 = _clipY0;
+    if (x1 > _clipX1) x1 = _clipX1;
+    if (y1 > _clipY1) y1 = _clipY1;
+    if ((x0 > x1) || (y0 > y1)) {
+        return;
+    }
+    if (_dlMode != ST7305_DL_IMMEDIATE) {
+        if (recordCommand(ST7305_DL_RECT, (color ? ST7305_DL_COLOR : 0) | ST7305_DL_OPAQUE,
+                          x0, y0, x1, y1)) {
+            return;
+        }
+    }
+    
+    markDirty(x0, y0, x1, y1);
+    fillRectClipped(x0, y0, x1, y1, color);
 }
 
 /**
- * Set Low Power Mode - Enter low power mode
- * 
- * Sends 0xBA command for low power operation.
+ * Fill Rect Clipped - Row-pair fill of an inclusive, pre-clipped rectangle
  */
-void ST7305_Mono::setLowPowerMode() {
-    sendCommand(ST7305_LPM);
+void ST7305_Mono::fillRectClipped(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    int16_t y = y0;
+    
+    if (y & 1) {  // Leading odd row shares its byte with the row above
+        writeSpan(y >> 1, x0, x1, ST7305_ROW_MASK_ODD, color);
+        y++;
+    }
+    for (; y < y1; y += 2) {  // Full row-pairs: whole bytes
+        writeSpan(y >> 1, x0, x1, ST7305_ROW_MASK_BOTH, color);
+    }
+    if (y == y1) {  // Trailing even row
+        writeSpan(y >> 1, x0, x1, ST7305_ROW_MASK_EVEN, color);
+    }
 }
 
 /**
- * Set Address Window - Define rectangular update region
+ * Write Span - Fill pixels x0..x1 (inclusive) of one row-pair
  * 
- * Sets the active drawing window for partial updates.
- * Subsequent memory writes will only affect this region.
+ * The partial head and tail bytes are masked; interior bytes are
+ * written whole (memset) when both rows are covered.
  * 
- * @param x0 Start column (0-299)
- * @param y0 Start row (0-399)
- * @param x1 End column (0-299)
- * @param y1 End row (0-399)
+ * Column masks (both rows):
+ *   x%4 = 0 -> 0xC0, 1 -> 0x30, 2 -> 0x0C, 3 -> 0x03
+ * 
+ * @param pair    Row-pair index (y / 2)
+ * @param x0, x1  Inclusive, pre-clipped column range
+ * @param rowMask ST7305_ROW_MASK_EVEN, _ODD or _BOTH
+ * @param color   0=BLACK, 1=WHITE
  */
-void ST7305_Mono::setAddressWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
-    // Column address set
-    sendCommand(ST7305_CASET);
-    sendData(x0 >> 8);
-    sendData(x0 & 0xFF);
-    sendData(x1 >> 8);
-    sendData(x1 & 0xFF);
+void ST7305_Mono::writeSpan(int16_t pair, int16_t x0, int16_t x1, uint8_t rowMask, uint16_t color) {
+    uint8_t *row = buffer + (uint32_t)pair * ST7305_BYTES_PER_ROW;
+    uint8_t *p = row + (x0 >> 2);
+    uint8_t *last = row + (x1 >> 2);
+    uint8_t headMask = (uint8_t)(0xFF >> ((x0 & 3) * 2)) & rowMask;
+    uint8_t tailMask = (uint8_t)(0xFF << ((3 - (x1 & 3)) * 2)) & rowMask;
     
-    // Row address set
-    sendCommand(ST7305_RASET);
-    sendData(y0 >> 8);
-    sendData(y0 & 0xFF);
-    sendData(y1 >> 8);
-    sendData(y1 & 0xFF);
+    if (p == last) {
+        headMask &= tailMask;
+        if (color) *p |= headMask; else *p &= ~headMask;
+        return;
+    }
+    
+    if (color) {
+        *p++ |= headMask;
+        if (rowMask == ST7305_ROW_MASK_BOTH) {
+            memset(p, 0xFF, last - p);
+        } else {
+            while (p < last) *p++ |= rowMask;
+        }
+        *last |= tailMask;
+    } else {
+        *p++ &= ~headMask;
+        if (rowMask == ST7305_ROW_MASK_BOTH) {
+            memset(p, 0x00, last - p);
+        } else {
+            while (p < last) *p++ &= ~rowMask;
+        }
+        *last &= ~tailMask;
+    }
 }
 
-// ===== Low-Level SPI Communication Functions =====
+// ===== Line Kernel =====
+
+// Incremental moves in the packed layout. mask is the pixel's bit in
+// buffer[idx]; x/y track the coordinate to know when a byte boundary
+// (every 4 columns / every 2 rows) is crossed.
+
+static inline void stepRight(uint32_t &idx, uint8_t &mask, int16_t &x) {
+    if ((x & 3) == 3) { idx++; mask = (uint8_t)(mask << 6); } else { mask >>= 2; }
+    x++;
+}
+
+static inline void stepLeft(uint32_t &idx, uint8_t &mask, int16_t &x) {
+    if ((x & 3) == 0) { idx--; mask >>= 6; } else { mask = (uint8_t)(mask << 2); }
+    x--;
+}
+
+static inline void stepDown(uint32_t &idx, uint8_t &mask, int16_t &y) {
+    if (y & 1) { idx += ST7305_BYTES_PER_ROW; mask = (uint8_t)(mask << 1); } else { mask >>= 1; }
+    y++;
+}
+
+static inline void stepUp(uint32_t &idx, uint8_t &mask, int16_t &y) {
+    if (y & 1) { mask = (uint8_t)(mask << 1); } else { idx -= ST7305_BYTES_PER_ROW; mask >>= 1; }
+    y--;
+}
 
 /**
- * Send Command - Send single command byte
- * 
- * @param cmd Command byte to send
+ * Draw Line - Route straight to the packed line kernel
  */
-void ST7305_Mono::sendCommand(uint8_t cmd) {
-    dcLow();
-    csLow();
-    SPI.beginTransaction(spiSettings);
-    SPI.transfer(cmd);
-    SPI.endTransaction();
-    csHigh();
+void ST7305_Mono::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    writeLine(x0, y0, x1, y1, color);
 }
 
 /**
- * Send Data - Send single data byte
+ * Write Line - Translate by the viewport origin, record or draw
  * 
- * @param data Data byte to send
+ * @param x0, y0 Start point
+ * @param x1, y1 End point
+ * @param color  0=BLACK, 1=WHITE
  */
-void ST7305_Mono::sendData(uint8_t data) {
-    dcHigh();
-    csLow();
-    SPI.beginTransaction(spiSettings);
-    SPI.transfer(data);
-    SPI.endTransaction();
-    csHigh();
+void ST7305_Mono::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    int32_t ax0 = (int32_t)x0 + _originX, ax1 = (int32_t)x1 + _originX;
+    int32_t ay0 = (int32_t)y0 + _originY, ay1 = (int32_t)y1 + _originY;
+    
+    if ((_dlMode != ST7305_DL_IMMEDIATE) && (ax0 != ax1) && (ay0 != ay1)) {
+        int32_t bx0 = (ax0 < ax1) ? ax0 : ax1, bx1 = (ax0 < ax1) ? ax1 : ax0;
+        int32_t by0 = (ay0 < ay1) ? ay0 : ay1, by1 = (ay0 < ay1) ? ay1 : ay0;
+        if (bx0 < _clipX0) bx0 = _clipX0;
+        if (by0 < _clipY0) by0 = _clipY0;
+        if (bx1 > _clipX1) bx1 = _clipX1;
+        if (by1 > _clipY1) by1 = _clipY1;
+        if ((bx0 > bx1) || (by0 > by1)) {
+            return;
+        }
+        st7305_dl_cmd_t *cmd = recordCommand(ST7305_DL_LINE, color ? ST7305_DL_COLOR : 0,
+                                             bx0, by0, bx1, by1);
+        if (cmd) {
+            // Operands stay in viewport coordinates; the sum may not fit 16 bits
+            cmd->p[0] = x0; cmd->p[1] = y0;
+            cmd->p[2] = x1; cmd->p[3] = y1;
+            cmd->p[4] = _originX; cmd->p[5] = _originY;
+            return;
+        }
+    }
+    
+    writeLineAbsolute(ax0, ay0, ax1, ay1, color);
 }
 
 /**
- * Send Data Batch - Send multiple data bytes efficiently
+ * Write Line Absolute - Bresenham line walking byte index and bit mask
  * 
- * Transfers data in 256-byte chunks for efficiency.
+ * Mirrors Adafruit_GFX::writeLine() exactly: the line is walked along its
+ * major axis from the lower endpoint with err = dx/2, stepping the minor
+ * axis whenever err goes negative. After k steps the minor offset is
+ *   m(k) = max(0, ceil((k*dy - dx/2) / dx))
+ * which lets the visible step range [kStart, kEnd] be solved up front
+ * for both axes, so the inner loop has no bounds checks. Endpoints span
+ * 17 bits after the origin is added, so the products are 64-bit.
  * 
- * @param data Pointer to data array
- * @param size Number of bytes to send
+ * @param x0, y0 Start point (absolute)
+ * @param x1, y1 End point (absolute)
+ * @param color  0=BLACK, 1=WHITE
  */
-void ST7305_Mono::sendDataBatch(const uint8_t *data, uint32_t size) {
-    dcHigh();
-    csLow();
-    SPI.beginTransaction(spiSettings);
+void ST7305_Mono::writeLineAbsolute(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t color) {
+    if (y0 == y1) {  // Horizontal: span kernel
+        if (x0 > x1) { int32_t t = x0; x0 = x1; x1 = t; }
+        fillRectAbsolute(x0, y0, x1, y1, color);
+        return;
+    }
+    if (x0 == x1) {  // Vertical: column kernel
+        if (y0 > y1) { int32_t t = y0; y0 = y1; y1 = t; }
+        fillRectAbsolute(x0, y0, x1, y1, color);
+        return;
+    }
+    
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) {
+        int32_t t;
+        t = x0; x0 = y0; y0 = t;
+        t = x1; x1 = y1; y1 = t;
+    }
+    if (x0 > x1) {
+        int32_t t;
+        t = x0; x0 = x1; x1 = t;
+        t = y0; y0 = y1; y1 = t;
+    }
+    
+    // Major axis runs x0..x1, minor axis starts at y0 and moves by ystep
+    int32_t dx = x1 - x0;
+    int32_t dy = abs(y1 - y0);
+    int32_t half = dx / 2;
+    int16_t ystep = (y0 < y1) ? 1 : -1;
+    int32_t majorMin = steep ? _clipY0 : _clipX0;
+    int32_t majorMax = steep ? _clipY1 : _clipX1;
+    int32_t minorMin = steep ? _clipX0 : _clipY0;
+    int32_t minorMax = steep ? _clipX1 : _clipY1;
+    
+    // Clip the major axis
+    int32_t kStart = (x0 < majorMin) ? majorMin - x0 : 0;
+    int32_t kEnd = (x1 > majorMax) ? majorMax - x0 : dx;
+    
+    // Clip the minor axis: need lo <= m(k) <= hi
+    int32_t lo = (ystep > 0) ? minorMin - y0 : y0 - minorMax;
+    int32_t hi = (ystep > 0) ? minorMax - y0 : y0 - minorMin;
+    if (hi < 0) {
+        return;
+    }
+    if (lo > 0) {
+        int32_t k = (int32_t)(((int64_t)(lo - 1) * dx + half) / dy) + 1;
+        if (k > kStart) kStart = k;
+    }
+    int32_t k = (int32_t)(((int64_t)hi * dx + half) / dy);
+    if (k < kEnd) kEnd = k;
+    if (kStart > kEnd) {
+        return;
+    }
+    
+    // Fast-forward the error term to the first visible step
+    int64_t stepped = (int64_t)kStart * dy;
+    int32_t m = (stepped > half) ? (int32_t)((stepped - half + dx - 1) / dx) : 0;
+    int32_t err = (int32_t)(half - stepped + (int64_t)m * dx);
+    int16_t major = (int16_t)(x0 + kStart);
+    int16_t minor = (int16_t)(y0 + ystep * m);
+    int16_t px = steep ? minor : major;
+    int16_t py = steep ? major : minor;
+    uint32_t idx = (uint32_t)(py >> 1) * ST7305_BYTES_PER_ROW + (px >> 2);
+    uint8_t mask = 0x80 >> (((px & 3) << 1) + (py & 1));
+    uint8_t value = color ? 0xFF : 0x00;
+    int32_t count = kEnd - kStart + 1;
+    
+    // Dirty box from the two visible endpoints
+    stepped = (int64_t)kEnd * dy;
+    int32_t mEnd = (stepped > half) ? (int32_t)((stepped - half + dx - 1) / dx) : 0;
+    int16_t minorEnd = (int16_t)(y0 + ystep * mEnd);
+    int16_t majorEnd = (int16_t)(x0 + kEnd);
+    int16_t minorLo = (ystep > 0) ? minor : minorEnd;
+    int16_t minorHi = (ystep > 0) ? minorEnd : minor;
+    if (steep) {
+        markDirty(minorLo, major, minorHi, majorEnd);
+    } else {
+        markDirty(major, minorLo, majorEnd, minorHi);
+    }
     
-    // Transfer in chunks for efficiency
-    const uint32_t chunkSize = 256;
-    for (uint32_t i = 0; i < size; i += chunkSize) {
-        uint32_t len = (size - i) > chunkSize ? chunkSize : (size - i);
-        SPI.transfer((void*)(data + i), len);
+    if (dx == dy) {  // 45 degrees (never steep): both axes move every step
+        for (;;) {
+            buffer[idx] = (buffer[idx] & ~mask) | (value & mask);
+            if (--count == 0) break;
+            stepRight(idx, mask, px);
+            if (ystep > 0) stepDown(idx, mask, py); else stepUp(idx, mask, py);
+        }
+        return;
     }
     
+    if (steep) {  // Major axis is Y (downwards), minor is X
+        for (;;) {
+            buffer[idx] = (buffer[idx] & ~mask) | (value & mask);
+            if (--count == 0) break;
+            err -= dy;
+            if (err < 0) {
+                if (ystep > 0) stepRight(idx, mask, px); else stepLeft(idx, mask, px);
+                err += dx;
+            }
+            stepDown(idx, mask, py);
+        }
+    } else {      // Major axis is X (rightwards), minor is Y
+        for (;;) {
+            buffer[idx] = (buffer[idx] & ~mask) | (value & mask);
+            if (--count == 0) break;
+            err -= dy;
+            if (err < 0) {
+                if (ystep > 0) stepDown(idx, mask, py); else stepUp(idx, mask, py);
+                err += dx;
+            }
+            stepRight(idx, mask, px);
+        }
+    }
+}
+
+// ===== Shapes =====
+
+/**
+ * Record Shape - Open a shape command while recording
+ * 
+ * The bounds only need to contain every pixel the shape can draw; they
+ * are clipped here and narrowed to each tile on replay.
+ * 
+ * @param op     ST7305_DL_CIRCLE, _ROUNDRECT or _TRIANGLE
+ * @param fill   Filled variant
+ * @param color  0=BLACK, 1=WHITE
+ * @param x0..y1 Bounds in viewport coordinates (inclusive)
+ * @return Entry for the operands (a scratch entry if clipped away), or
+ *         nullptr to draw immediately
+ */
+st7305_dl_cmd_t *ST7305_Mono::recordShape(uint8_t op, bool fill, uint16_t color,
+                                          int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+    x0 += _originX; x1 += _originX;
+    y0 += _originY; y1 += _originY;
+    if (x0 < _clipX0) x0 = _clipX0;
+    if (y0 < _clipY0) y0 = _clipY0;
+    if (x1 > _clipX1) x1 = _clipX1;
+    if (y1 > _clipY1) y1 = _clipY1;
+    if ((x0 > x1) || (y0 > y1)) {
+        return &_dlScratch;
+    }
+    uint8_t flags = (color ? ST7305_DL_COLOR : 0) | (fill ? ST7305_DL_FILL : 0);
+    return recordCommand(op, flags, x0, y0, x1, y1);
+}
+
+/**
+ * Circles - Center and radius; bounds are the radius either side
+ */
+void ST7305_Mono::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    if (_dlMode == ST7305_DL_RECORD) {
+        int32_t a = abs(r);
+        st7305_dl_cmd_t *cmd = recordShape(ST7305_DL_CIRCLE, false, color, x0 - a, y0 - a, x0 + a, y0 + a);
+        if (cmd) {
+            cmd->p[0] = x0 + _originX; cmd->p[1] = y0 + _originY;
+            cmd->p[2] = r;
+            return;
+        }
+    }
+    Adafruit_GFX::drawCircle(x0, y0, r, color);
+}
+
+void ST7305_Mono::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    if (_dlMode == ST7305_DL_RECORD) {
+        int32_t a = abs(r);
+        st7305_dl_cmd_t *cmd = recordShape(ST7305_DL_CIRCLE, true, color, x0 - a, y0 - a, x0 + a, y0 + a);
+        if (cmd) {
+            cmd->p[0] = x0 + _originX; cmd->p[1] = y0 + _originY;
+            cmd->p[2] = r;
+            return;
+        }
+    }
+    Adafruit_GFX::fillCircle(x0, y0, r, color);
+}
+
+/**
+ * Rounded Rects - Bounds allow for negative sizes and radii, which
+ * make Adafruit_GFX reach up to two radii past the rectangle; the radius
+ * is clamped to half the shorter side first, as Adafruit_GFX does
+ */
+void ST7305_Mono::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+    if (_dlMode == ST7305_DL_RECORD) {
+        int16_t rmax = ((w < h) ? w : h) / 2;
+        int32_t a = 2 * abs((r > rmax) ? rmax : r) + 1;
+        int32_t x1 = (int32_t)x + w, y1 = (int32_t)y + h;
+        st7305_dl_cmd_t *cmd = recordShape(ST7305_DL_ROUNDRECT, false, color,
+                                           ((w < 0) ? x1 : x) - a, ((h < 0) ? y1 : y) - a,
+                                           ((w < 0) ? x : x1) + a, ((h < 0) ? y : y1) + a);
+        if (cmd) {
+            cmd->p[0] = x + _originX; cmd->p[1] = y + _originY;
+            cmd->p[2] = w; cmd->p[3] = h;
+            cmd->p[4] = r;
+            return;
+        }
+    }
+    Adafruit_GFX::drawRoundRect(x, y, w, h, r, color);
+}
+
+void ST7305_Mono::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+    if (_dlMode == ST7305_DL_RECORD) {
+        int16_t rmax = ((w < h) ? w : h) / 2;
+        int32_t a = 2 * abs((r > rmax) ? rmax : r) + 1;
+        int32_t x1 = (int32_t)x + w, y1 = (int32_t)y + h;
+        st7305_dl_cmd_t *cmd = recordShape(ST7305_DL_ROUNDRECT, true, color,
+                                           ((w < 0) ? x1 : x) - a, ((h < 0) ? y1 : y) - a,
+                                           ((w < 0) ? x : x1) + a, ((h < 0) ? y : y1) + a);
+        if (cmd) {
+            cmd->p[0] = x + _originX; cmd->p[1] = y + _originY;
+            cmd->p[2] = w; cmd->p[3] = h;
+            cmd->p[4] = r;
+            return;
+        }
+    }
+    Adafruit_GFX::fillRoundRect(x, y, w, h, r, color);
+}
+
+static inline int16_t min3(int16_t a, int16_t b, int16_t c) {
+    return (a < b) ? ((a < c) ? a : c) : ((b < c) ? b : c);
+}
+
+static inline int16_t max3(int16_t a, int16_t b, int16_t c) {
+    return (a > b) ? ((a > c) ? a : c) : ((b > c) ? b : c);
+}
+
+/**
+ * Triangles - Bounds of the three corners
+ */
+void ST7305_Mono::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+                               uint16_t color) {
+    if (_dlMode == ST7305_DL_RECORD) {
+        st7305_dl_cmd_t *cmd = recordShape(ST7305_DL_TRIANGLE, false, color,
+                                           min3(x0, x1, x2), min3(y0, y1, y2),
+                                           max3(x0, x1, x2), max3(y0, y1, y2));
+        if (cmd) {
+            cmd->p[0] = x0 + _originX; cmd->p[1] = y0 + _originY;
+            cmd->p[2] = x1 + _originX; cmd->p[3] = y1 + _originY;
+            cmd->p[4] = x2 + _originX; cmd->p[5] = y2 + _originY;
+            return;
+        }
+    }
+    Adafruit_GFX::drawTriangle(x0, y0, x1, y1, x2, y2, color);
+}
+
+void ST7305_Mono::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+                               uint16_t color) {
+    if (_dlMode == ST7305_DL_RECORD) {
+        st7305_dl_cmd_t *cmd = recordShape(ST7305_DL_TRIANGLE, true, color,
+                                           min3(x0, x1, x2), min3(y0, y1, y2),
+                                           max3(x0, x1, x2), max3(y0, y1, y2));
+        if (cmd) {
+            cmd->p[0] = x0 + _originX; cmd->p[1] = y0 + _originY;
+            cmd->p[2] = x1 + _originX; cmd->p[3] = y1 + _originY;
+            cmd->p[4] = x2 + _originX; cmd->p[5] = y2 + _originY;
+            return;
+        }
+    }
+    Adafruit_GFX::fillTriangle(x0, y0, x1, y1, x2, y2, color);
+}
+
+// ===== Scanline Fill Engine =====
+
+/**
+ * Edge table entry for the scanline fill engine
+ */
+typedef struct {
+    int64_t x;      // 16.16 X at the current scanline (pixel center), rounded down
+    int64_t dxdy;   // 16.16 X step per scanline, rounded down
+    int32_t rem;    // Remainder of x, 0 .. den-1 (in 1/den of a 16.16 unit)
+    int32_t remStep; // Remainder of dxdy
+    int32_t den;    // Edge height in 24.8 units
+    int16_t yTop;   // First scanline crossed by the edge (clipped)
+    int16_t yEnd;   // One past the last scanline crossed (clipped)
+} st7305_scan_edge_t;
+
+/**
+ * Floor Division - Quotient rounded toward minus infinity (den > 0)
+ */
+static inline int64_t floorDiv(int64_t num, int32_t den) {
+    int64_t q = num / den;
+    return ((num % den) < 0) ? q - 1 : q;
+}
+
+// Crossings are clamped to +-16384 px (16.16) before pairing; anything
+// that far out is off every panel, and the span math stays in int32.
+#define ST7305_SCAN_LIMIT  ((int64_t)1 << 30)
+
+/**
+ * Collect Spans - Produce the clipped spans of one scanline
+ * 
+ * Activates edges starting at y (their range is already clipped, so
+ * an edge enters on its first scanline), drops finished edges, sorts
+ * crossings and pairs them up (even-odd rule). Active edges are
+ * stepped to y+1.
+ * 
+ * @return Number of spans written to spans[] as (x0, x1) pairs
+ */
+static uint8_t collectSpans(st7305_scan_edge_t *edges, uint8_t edgeCount, uint8_t *next,
+                            uint8_t *active, uint8_t *activeCount, int16_t y,
+                            int16_t xMin, int16_t xMax, int16_t *spans) {
+    // Activate edges that start on or before this scanline
+    while ((*next < edgeCount) && (edges[*next].yTop <= y)) {
+        st7305_scan_edge_t *e = &edges[*next];
+        if (e->yEnd > y) {
+            active[(*activeCount)++] = *next;
+        }
+        (*next)++;
+    }
+    
+    // Drop finished edges and gather crossings
+    int32_t xs[ST7305_MAX_POLY_POINTS];
+    uint8_t n = 0;
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < *activeCount; i++) {
+        st7305_scan_edge_t *e = &edges[active[i]];
+        if (e->yEnd <= y) {
+            continue;
+        }
+        active[kept++] = active[i];
+        
+        // Insertion sort: crossings are nearly ordered row to row
+        int32_t x = (e->x < -ST7305_SCAN_LIMIT) ? (int32_t)-ST7305_SCAN_LIMIT :
+                    (e->x > ST7305_SCAN_LIMIT) ? (int32_t)ST7305_SCAN_LIMIT : (int32_t)e->x;
+        uint8_t j = n++;
+        while ((j > 0) && (xs[j - 1] > x)) {
+            xs[j] = xs[j - 1];
+            j--;
+        }
+        xs[j] = x;
+        e->rem += e->remStep;
+        int32_t carry = (e->rem >= e->den) ? 1 : 0;  // Branch-free: carries are irregular
+        e->x += e->dxdy + carry;
+        e->rem -= e->den & -carry;
+    }
+    *activeCount = kept;
+    
+    // Pair crossings: fill pixel centers in [xa, xb)
+    uint8_t spanCount = 0;
+    for (uint8_t i = 0; i + 1 < n; i += 2) {
+        int32_t x0 = (xs[i] + 0xFFFF) >> 16;
+        int32_t x1 = ((xs[i + 1] + 0xFFFF) >> 16) - 1;
+        if (x0 < xMin) x0 = xMin;
+        if (x1 > xMax) x1 = xMax;
+        if (x0 <= x1) {
+            spans[spanCount * 2] = x0;
+            spans[spanCount * 2 + 1] = x1;
+            spanCount++;
+        }
+    }
+    return spanCount;
+}
+
+/**
+ * Fill Polygon Fixed - Scanline fill of a polygon with 24.8 vertices
+ * 
+ * Builds an edge table, then walks the covered scanlines two at a time.
+ * When both rows of a row-pair produce identical spans (the common case
+ * for the interior of a shape) each byte is written once with both row
+ * bits; otherwise each row is written with its own row mask.
+ * 
+ * @param xs, ys Vertex coordinates in 24.8 fixed point (pixel centers at .0)
+ * @param count  Number of vertices
+ * @param color  0=BLACK, 1=WHITE
+ */
+void ST7305_Mono::fillPolygonFixed(const int32_t *xs, const int32_t *ys, uint8_t count, uint16_t color) {
+    if ((count < 3) || (count > ST7305_MAX_POLY_POINTS)) {
+        return;
+    }
+    
+    int32_t originX = (int32_t)_originX * 256;
+    int32_t originY = (int32_t)_originY * 256;
+    
+    if (_dlMode != ST7305_DL_IMMEDIATE) {
+        int32_t minX = INT32_MAX, minY = INT32_MAX, maxX = INT32_MIN, maxY = INT32_MIN;
+        for (uint8_t i = 0; i < count; i++) {
+            if (xs[i] < minX) minX = xs[i];
+            if (xs[i] > maxX) maxX = xs[i];
+            if (ys[i] < minY) minY = ys[i];
+            if (ys[i] > maxY) maxY = ys[i];
+        }
+        int32_t bx0 = (minX + originX) >> 8, bx1 = (maxX + originX + 0xFF) >> 8;
+        int32_t by0 = (minY + originY) >> 8, by1 = (maxY + originY + 0xFF) >> 8;
+        if (bx0 < _clipX0) bx0 = _clipX0;
+        if (by0 < _clipY0) by0 = _clipY0;
+        if (bx1 > _clipX1) bx1 = _clipX1;
+        if (by1 > _clipY1) by1 = _clipY1;
+        if ((bx0 > bx1) || (by0 > by1)) {
+            return;
+        }
+        
+        if ((_dlMode == ST7305_DL_RECORD) &&
+            (_dl->vertexCount + count > ST7305_DL_MAX_VERTICES)) {
+            _dlStats.overflowed = true;  // Vertex pool full: the frame is refused
+            return;
+        }
+        st7305_dl_cmd_t *cmd = recordCommand(ST7305_DL_POLY, color ? ST7305_DL_COLOR : 0,
+                                             bx0, by0, bx1, by1);
+        if (cmd) {
+            if ((_dlMode == ST7305_DL_RECORD) && !_dlStats.overflowed) {
+                int32_t *v = _dl->vertices + _dl->vertexCount * 2;
+                for (uint8_t i = 0; i < count; i++) {
+                    v[i] = xs[i] + originX;
+                    v[count + i] = ys[i] + originY;
+                }
+                cmd->p[0] = _dl->vertexCount;
+                cmd->p[1] = count;
+                _dl->vertexCount += count;
+            }
+            return;
+        }
+    }
+    
+    // Build edge table (horizontal edges cross no pixel centers)
+    st7305_scan_edge_t edges[ST7305_MAX_POLY_POINTS];
+    uint8_t edgeCount = 0;
+    int16_t yMin = INT16_MAX;
+    int16_t yMax = INT16_MIN;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t j = (i + 1 < count) ? i + 1 : 0;
+        int32_t ax = xs[i] + originX, ay = ys[i] + originY;
+        int32_t bx = xs[j] + originX, by = ys[j] + originY;
+        if (ay > by) {
+            int32_t t;
+            t = ax; ax = bx; bx = t;
+            t = ay; ay = by; by = t;
+        }
+        
+        int32_t top = (ay + 0xFF) >> 8;  // ceil: first pixel center at or below ay
+        int32_t end = (by + 0xFF) >> 8;  // exclusive
+        if (top < _clipY0) top = _clipY0;          // Rows outside the clip are never
+        if (end > _clipY1 + 1) end = _clipY1 + 1;  // scanned; start X at the first one
+        if (top >= end) {
+            continue;
+        }
+        
+        // X is floor(exact crossing) in 16.16 on every row: it starts at
+        // the first row (not stepped from ay) and carries the remainder
+        // of the step, so no error accumulates and the result does not
+        // depend on the clip. 64-bit: far-off vertices pass int32.
+        st7305_scan_edge_t e;
+        int32_t den = by - ay;
+        int64_t num = ((int64_t)top * 256 - ay) * (bx - ax) * 256;
+        int64_t step = (int64_t)(bx - ax) * 65536;
+        int64_t q = floorDiv(num, den);
+        int64_t qs = floorDiv(step, den);
+        e.x = (int64_t)ax * 256 + q;
+        e.rem = (int32_t)(num - q * den);
+        e.dxdy = qs;
+        e.remStep = (int32_t)(step - qs * den);
+        e.den = den;
+        e.yTop = top;
+        e.yEnd = end;
+        uint8_t k = edgeCount++;
+        while ((k > 0) && (edges[k - 1].yTop > e.yTop)) {
+            edges[k] = edges[k - 1];
+            k--;
+        }
+        edges[k] = e;
+        
+        if (top < yMin) yMin = top;
+        if (end > yMax) yMax = end;
+    }
+    if (edgeCount < 2) {
+        return;
+    }
+    
+    // Edge ranges are clipped, so the scanline range is too
+    int16_t y = yMin;
+    int16_t yLast = yMax - 1;
+    if (_clipX0 > _clipX1) {
+        return;
+    }
+    
+    uint8_t active[ST7305_MAX_POLY_POINTS];
+    uint8_t activeCount = 0;
+    uint8_t next = 0;
+    int16_t spansA[ST7305_MAX_POLY_POINTS];
+    int16_t spansB[ST7305_MAX_POLY_POINTS];
+    
+    // Dirty box: scanline range of the edge table, widest span seen
+    int16_t dirtyY0 = y;
+    int16_t dirtyY1 = yLast;
+    int16_t dirtyX0 = INT16_MAX;
+    int16_t dirtyX1 = INT16_MIN;
+    
+    if (y & 1) {  // Leading odd row
+        uint8_t n = collectSpans(edges, edgeCount, &next, active, &activeCount, y,
+                                 _clipX0, _clipX1, spansA);
+        if (n > 0) {
+            if (spansA[0] < dirtyX0) dirtyX0 = spansA[0];
+            if (spansA[n * 2 - 1] > dirtyX1) dirtyX1 = spansA[n * 2 - 1];
+        }
+        for (uint8_t i = 0; i < n; i++) {
+            writeSpan(y >> 1, spansA[i * 2], spansA[i * 2 + 1], ST7305_ROW_MASK_ODD, color);
+        }
+        y++;
+    }
+    
+    for (; y <= yLast; y += 2) {
+        uint8_t nA = collectSpans(edges, edgeCount, &next, active, &activeCount, y,
+                                  _clipX0, _clipX1, spansA);
+        if (nA > 0) {
+            if (spansA[0] < dirtyX0) dirtyX0 = spansA[0];
+            if (spansA[nA * 2 - 1] > dirtyX1) dirtyX1 = spansA[nA * 2 - 1];
+        }
+        if (y == yLast) {  // Trailing even row
+            for (uint8_t i = 0; i < nA; i++) {
+                writeSpan(y >> 1, spansA[i * 2], spansA[i * 2 + 1], ST7305_ROW_MASK_EVEN, color);
+            }
+            break;
+        }
+        
+        uint8_t nB = collectSpans(edges, edgeCount, &next, active, &activeCount, y + 1,
+                                  _clipX0, _clipX1, spansB);
+        if (nB > 0) {
+            if (spansB[0] < dirtyX0) dirtyX0 = spansB[0];
+            if (spansB[nB * 2 - 1] > dirtyX1) dirtyX1 = spansB[nB * 2 - 1];
+        }
+        if ((nA == nB) && (memcmp(spansA, spansB, nA * 2 * sizeof(int16_t)) == 0)) {
+            for (uint8_t i = 0; i < nA; i++) {
+                writeSpan(y >> 1, spansA[i * 2], spansA[i * 2 + 1], ST7305_ROW_MASK_BOTH, color);
+            }
+        } else {
+            for (uint8_t i = 0; i < nA; i++) {
+                writeSpan(y >> 1, spansA[i * 2], spansA[i * 2 + 1], ST7305_ROW_MASK_EVEN, color);
+            }
+            for (uint8_t i = 0; i < nB; i++) {
+                writeSpan(y >> 1, spansB[i * 2], spansB[i * 2 + 1], ST7305_ROW_MASK_ODD, color);
+            }
+        }
+    }
+    
+    if (dirtyX0 <= dirtyX1) {
+        markDirty(dirtyX0, dirtyY0, dirtyX1, dirtyY1);
+    }
+}
+
+/**
+ * Fill Polygon - Fill an integer-vertex polygon (even-odd rule)
+ * 
+ * @param points Vertex array
+ * @param count  Number of vertices (3 to ST7305_MAX_POLY_POINTS)
+ * @param color  0=BLACK, 1=WHITE
+ */
+void ST7305_Mono::fillPolygon(const st7305_point_t *points, uint8_t count, uint16_t color) {
+    if ((count < 3) || (count > ST7305_MAX_POLY_POINTS)) {
+        return;
+    }
+    
+    int32_t xs[ST7305_MAX_POLY_POINTS];
+    int32_t ys[ST7305_MAX_POLY_POINTS];
+    for (uint8_t i = 0; i < count; i++) {
+        xs[i] = (int32_t)points[i].x * 256;
+        ys[i] = (int32_t)points[i].y * 256;
+    }
+    fillPolygonFixed(xs, ys, count, color);
+}
+
+/**
+ * Draw Thick Line - Fill the quad around a line segment
+ * 
+ * The quad extends thickness/2 either side of the center line and half
+ * a pixel past each endpoint, so both endpoints are covered.
+ * 
+ * @param x0, y0    Start point
+ * @param x1, y1    End point
+ * @param thickness Width in pixels (0 or 1 draws a regular line)
+ * @param color     0=BLACK, 1=WHITE
+ */
+void ST7305_Mono::drawThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                uint8_t thickness, uint16_t color) {
+    if (thickness <= 1) {
+        drawLine(x0, y0, x1, y1, color);
+        return;
+    }
+    
+    float dx = (float)(x1 - x0);
+    float dy = (float)(y1 - y0);
+    float len = sqrtf(dx * dx + dy * dy);
+    if (len == 0.0f) {  // Degenerate: square dot
+        fillRect(x0 - thickness / 2, y0 - thickness / 2, thickness, thickness, color);
+        return;
+    }
+    
+    // Unit direction scaled to 24.8: half-pixel end caps and half-width normal
+    float ux = dx / len * 256.0f;
+    float uy = dy / len * 256.0f;
+    float hw = thickness * 0.5f;
+    int32_t ex = (int32_t)lroundf(ux * 0.5f), ey = (int32_t)lroundf(uy * 0.5f);
+    int32_t nx = (int32_t)lroundf(-uy * hw), ny = (int32_t)lroundf(ux * hw);
+    int32_t ax = (int32_t)x0 * 256 - ex, ay = (int32_t)y0 * 256 - ey;
+    int32_t bx = (int32_t)x1 * 256 + ex, by = (int32_t)y1 * 256 + ey;
+    
+    int32_t xs[4] = { ax + nx, bx + nx, bx - nx, ax - nx };
+    int32_t ys[4] = { ay + ny, by + ny, by - ny, ay - ny };
+    fillPolygonFixed(xs, ys, 4, color);
+}
+
+/**
+ * Fill Arc - Fill a ring sector or pie wedge
+ * 
+ * The outer edge is walked from startAngle to endAngle and the inner
+ * edge (or the center, for wedges) back again, producing a polygon.
+ * Segment count follows the outer radius so chord error stays under
+ * half a pixel. Arcs needing more than ST7305_MAX_ARC_SEGMENTS are
+ * filled as consecutive polygons of that many segments; neighbours
+ * share their radial edge exactly, so the fill rule leaves no seam.
+ * 
+ * @param cx, cy       Center
+ * @param innerRadius  Inner radius (0 for a pie wedge)
+ * @param outerRadius  Outer radius
+ * @param startAngle   Degrees, 0 = 3 o'clock, clockwise
+ * @param endAngle     Degrees, clockwise from startAngle
+ * @param color        0=BLACK, 1=WHITE
+ */
+void ST7305_Mono::fillArc(int16_t cx, int16_t cy, int16_t innerRadius, int16_t outerRadius,
+                          int16_t startAngle, int16_t endAngle, uint16_t color) {
+    if ((outerRadius <= 0) || (innerRadius < 0) || (innerRadius >= outerRadius)) {
+        return;
+    }
+    
+    int32_t sweep = (int32_t)endAngle - startAngle;
+    if (sweep == 0) {
+        return;
+    }
+    if (sweep >= 360) {
+        sweep = 360;
+    } else {
+        while (sweep < 0) sweep += 360;
+    }
+    
+    // Chord error < 0.5px: step <= 2*acos(1 - 0.5/r)
+    const float degToRad = 0.017453292f;
+    float maxStep = 2.0f * acosf(1.0f - 0.5f / (float)outerRadius);
+    int32_t segments = (int32_t)ceilf(sweep * degToRad / maxStep);
+    if (segments < 1) segments = 1;
+    
+    int32_t xs[ST7305_MAX_POLY_POINTS];
+    int32_t ys[ST7305_MAX_POLY_POINTS];
+    int32_t cx8 = (int32_t)cx * 256;
+    int32_t cy8 = (int32_t)cy * 256;
+    
+    for (int32_t first = 0; first < segments; first += ST7305_MAX_ARC_SEGMENTS) {
+        int32_t last = first + ST7305_MAX_ARC_SEGMENTS;
+        if (last > segments) last = segments;
+        uint8_t n = 0;
+        
+        // Outer edge, clockwise
+        for (int32_t i = first; i <= last; i++) {
+            float a = (startAngle + (float)sweep * i / segments) * degToRad;
+            xs[n] = cx8 + (int32_t)lroundf(cosf(a) * outerRadius * 256.0f);
+            ys[n] = cy8 + (int32_t)lroundf(sinf(a) * outerRadius * 256.0f);
+            n++;
+        }
+        
+        // Inner edge back, or the center for a wedge
+        if (innerRadius > 0) {
+            for (int32_t i = last; i >= first; i--) {
+                float a = (startAngle + (float)sweep * i / segments) * degToRad;
+                xs[n] = cx8 + (int32_t)lroundf(cosf(a) * innerRadius * 256.0f);
+                ys[n] = cy8 + (int32_t)lroundf(sinf(a) * innerRadius * 256.0f);
+                n++;
+            }
+        } else if ((sweep < 360) || (segments > ST7305_MAX_ARC_SEGMENTS)) {
+            xs[n] = cx8;
+            ys[n] = cy8;
+            n++;
+        }
+        
+        fillPolygonFixed(xs, ys, n, color);
+    }
+}
+
+// ===== Bitmap Blit =====
+
+// Spreads a nibble of 1bpp pixels (bit 3 = leftmost) onto the even-row
+// bits of one packed byte; shift right by one for the odd row.
+static const uint8_t st7305_spread[16] = {
+    0x00, 0x02, 0x08, 0x0A, 0x20, 0x22, 0x28, 0x2A,
+    0x80, 0x82, 0x88, 0x8A, 0xA0, 0xA2, 0xA8, 0xAA
+};
+
+/**
+ * Fetch 4 source pixels (MSB-first) starting at bit index idx
+ * 
+ * The following byte is only read if it holds pixels before end, so
+ * the last row of a bitmap is never read past its final byte.
+ */
+static inline uint8_t fetchNibble(const uint8_t *bits, int32_t idx, int32_t end) {
+    const uint8_t *p = bits + (idx >> 3);
+    uint8_t shift = idx & 7;
+    uint16_t window = (uint16_t)pgm_read_byte(p) << 8;
+    if ((shift > 4) && ((((idx >> 3) + 1) << 3) < end)) {
+        window |= pgm_read_byte(p + 1);
+    }
+    return (window >> (12 - shift)) & 0x0F;
+}
+
+/**
+ * Draw Bitmap - Clipped 1bpp blit, transparent background
+ * 
+ * @param x, y   Top-left corner
+ * @param bitmap 1bpp rows, MSB-first, byte-padded (PROGMEM or RAM)
+ * @param w, h   Size in pixels
+ * @param color  Color for set bits
+ */
+void ST7305_Mono::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h,
+                             uint16_t color) {
+    blitBitmap(x, y, bitmap, w, h, color, color, false);
+}
+
+/**
+ * Draw Bitmap - Clipped 1bpp blit, opaque background
+ * 
+ * @param color Color for set bits
+ * @param bg    Color for clear bits
+ */
+void ST7305_Mono::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h,
+                             uint16_t color, uint16_t bg) {
+    blitBitmap(x, y, bitmap, w, h, color, bg, true);
+}
+
+/**
+ * Blit Bitmap - Clip a 1bpp bitmap once, then blit its visible rows
+ */
+void ST7305_Mono::blitBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h,
+                             uint16_t color, uint16_t bg, bool opaque) {
+    int32_t x0 = (int32_t)x + _originX;
+    int32_t y0 = (int32_t)y + _originY;
+    int32_t x1 = x0 + w - 1;
+    int32_t y1 = y0 + h - 1;
+    int32_t cx0 = (x0 < _clipX0) ? _clipX0 : x0;
+    int32_t cy0 = (y0 < _clipY0) ? _clipY0 : y0;
+    int32_t cx1 = (x1 > _clipX1) ? _clipX1 : x1;
+    int32_t cy1 = (y1 > _clipY1) ? _clipY1 : y1;
+    if ((cx0 > cx1) || (cy0 > cy1)) {
+        return;
+    }
+    if (_dlMode != ST7305_DL_IMMEDIATE) {
+        uint8_t flags = (color ? ST7305_DL_COLOR : 0) | (opaque ? ST7305_DL_OPAQUE : 0) |
+                        (bg ? ST7305_DL_BG : 0);
+        st7305_dl_cmd_t *cmd = recordCommand(ST7305_DL_BITMAP, flags, cx0, cy0, cx1, cy1);
+        if (cmd) {
+            cmd->p[0] = x0; cmd->p[1] = y0;
+            cmd->p[2] = w;  cmd->p[3] = h;
+            cmd->data = bitmap;
+            return;
+        }
+    }
+    
+    markDirty(cx0, cy0, cx1, cy1);
+    int32_t byteWidth = (w + 7) / 8;
+    for (int32_t row = cy0; row <= cy1; row++) {
+        blitSpan(row >> 1, cx0, bitmap + (row - y0) * byteWidth, cx0 - x0, cx1 - cx0 + 1,
+                 ST7305_ROW_MASK_EVEN >> (row & 1), color, bg, opaque);
+    }
+}
+
+/**
+ * Blit Span - Write w pixels of a 1bpp row into the rows of one row-pair
+ * 
+ * Source pixels are fetched four at a time, aligned to the destination
+ * byte columns, and spread onto the selected rows' bits with a lookup
+ * table, so each buffer byte is read and written once. With both rows
+ * selected one source row fills whole bytes (used by the scaled blits).
+ * 
+ * @param pair      Destination row-pair (pre-clipped)
+ * @param x         Destination start column (absolute, pre-clipped)
+ * @param bits      Source row (MSB-first)
+ * @param bitOffset Index of the first source pixel in bits
+ * @param w         Number of pixels
+ * @param rowMask   ST7305_ROW_MASK_EVEN, _ODD or _BOTH
+ * @param color     Color for set bits
+ * @param bg        Color for clear bits (if opaque)
+ * @param opaque    false to leave clear bits untouched
+ */
+void ST7305_Mono::blitSpan(int16_t pair, int16_t x, const uint8_t *bits, int32_t bitOffset, int16_t w,
+                           uint8_t rowMask, uint16_t color, uint16_t bg, bool opaque) {
+    uint8_t *p = buffer + (uint32_t)pair * ST7305_BYTES_PER_ROW + (x >> 2);
+    int16_t lead = x & 3;               // Columns before x in the first byte
+    int32_t src = bitOffset - lead;     // Source index aligned to byte column 0
+    int32_t end = bitOffset + w;        // First source index past the row
+    int16_t remaining = w + lead;
+    uint8_t colMask = 0xFF >> (lead * 2);
+    
+    while (remaining > 0) {
+        if (remaining < 4) {
+            colMask &= (uint8_t)(0xFF << ((4 - remaining) * 2));
+        }
+        uint8_t nib;
+        if (src < 0) {  // First byte of an unaligned row
+            nib = fetchNibble(bits, 0, end) >> (-src);
+        } else {
+            nib = fetchNibble(bits, src, end);
+        }
+        uint8_t mask = rowMask & colMask;
+        uint8_t fg = (st7305_spread[nib] | (st7305_spread[nib] >> 1)) & mask;
+        uint8_t value = *p;
+        
+        if (color) value |= fg; else value &= ~fg;
+        if (opaque) {
+            uint8_t bgMask = mask & ~fg;
+            if (bg) value |= bgMask; else value &= ~bgMask;
+        }
+        *p++ = value;
+        
+        src += 4;
+        remaining -= 4;
+        colMask = 0xFF;
+    }
+}
+
+/**
+ * Draw Packed - Clipped blit of native 4x2 packed data
+ * 
+ * Aligned destinations copy source bytes straight into the buffer;
+ * only the bytes on the clip edges need a mask, built from the column
+ * mask of the byte and the row mask of the row-pair. Unaligned
+ * destinations shift every pixel, so they are moved one at a time.
+ * 
+ * @param x, y Top-left corner
+ * @param data Packed rows, (w + 3) / 4 bytes per row-pair
+ * @param w, h Size in pixels
+ */
+void ST7305_Mono::drawPacked(int16_t x, int16_t y, const uint8_t *data, int16_t w, int16_t h) {
+    int32_t x0 = (int32_t)x + _originX;
+    int32_t y0 = (int32_t)y + _originY;
+    int32_t x1 = x0 + w - 1;
+    int32_t y1 = y0 + h - 1;
+    int32_t cx0 = (x0 < _clipX0) ? _clipX0 : x0;
+    int32_t cy0 = (y0 < _clipY0) ? _clipY0 : y0;
+    int32_t cx1 = (x1 > _clipX1) ? _clipX1 : x1;
+    int32_t cy1 = (y1 > _clipY1) ? _clipY1 : y1;
+    if ((cx0 > cx1) || (cy0 > cy1)) {
+        return;
+    }
+    if (_dlMode != ST7305_DL_IMMEDIATE) {
+        st7305_dl_cmd_t *cmd = recordCommand(ST7305_DL_PACKED, ST7305_DL_OPAQUE, cx0, cy0, cx1, cy1);
+        if (cmd) {
+            cmd->p[0] = x0; cmd->p[1] = y0;
+            cmd->p[2] = w;  cmd->p[3] = h;
+            cmd->data = data;
+            return;
+        }
+    }
+    
+    markDirty(cx0, cy0, cx1, cy1);
+    int32_t stride = (w + 3) / 4;
+    
+    if (((x0 & 3) == 0) && ((y0 & 1) == 0)) {
+        int32_t b0 = cx0 >> 2;
+        int32_t b1 = cx1 >> 2;
+        uint8_t firstMask = 0xFF >> ((cx0 & 3) * 2);
+        uint8_t lastMask = (uint8_t)(0xFF << ((3 - (cx1 & 3)) * 2));
+        
+        for (int32_t pair = cy0 >> 1; pair <= (cy1 >> 1); pair++) {
+            uint8_t rowMask = ST7305_ROW_MASK_BOTH;
+            if ((pair << 1) < cy0) rowMask &= ST7305_ROW_MASK_ODD;
+            if ((pair << 1) + 1 > cy1) rowMask &= ST7305_ROW_MASK_EVEN;
+            
+            const uint8_t *src = data + (pair - (y0 >> 1)) * stride + (b0 - (x0 >> 2));
+            uint8_t *dst = buffer + pair * ST7305_BYTES_PER_ROW + b0;
+            
+            for (int32_t b = b0; b <= b1; b++) {
+                uint8_t mask = rowMask;
+                if (b == b0) mask &= firstMask;
+                if (b == b1) mask &= lastMask;
+                if (mask == 0xFF) {
+                    *dst = *src;
+                } else {
+                    *dst = (*dst & ~mask) | (*src & mask);
+                }
+                src++;
+                dst++;
+            }
+        }
+        return;
+    }
+    
+    for (int32_t row = cy0; row <= cy1; row++) {
+        int32_t sy = row - y0;
+        const uint8_t *src = data + (sy >> 1) * stride;
+        uint8_t *dst = buffer + (row >> 1) * ST7305_BYTES_PER_ROW;
+        for (int32_t col = cx0; col <= cx1; col++) {
+            int32_t sx = col - x0;
+            uint8_t on = (src[sx >> 2] >> (7 - (((sx & 3) << 1) | (sy & 1)))) & 1;
+            uint8_t bit = 0x80 >> (((col & 3) << 1) | (row & 1));
+            if (on) dst[col >> 2] |= bit; else dst[col >> 2] &= ~bit;
+        }
+    }
+}
+
+// ===== Integer-Scaled Blit =====
+
+// Bit-expansion tables: a nibble of 1bpp pixels (bit 3 = leftmost) with
+// every pixel repeated 2, 3 or 4 times, MSB-first.
+static const uint8_t st7305_expand2[16] = {
+    0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+    0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF
+};
+static const uint16_t st7305_expand3[16] = {
+    0x000, 0x007, 0x038, 0x03F, 0x1C0, 0x1C7, 0x1F8, 0x1FF,
+    0xE00, 0xE07, 0xE38, 0xE3F, 0xFC0, 0xFC7, 0xFF8, 0xFFF
+};
+static const uint16_t st7305_expand4[16] = {
+    0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF,
+    0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF
+};
+
+// Widened row: the visible width plus a partial block at each clip edge,
+// plus up to 3 pixels past the end expanded with the last nibble
+#define ST7305_SCALE_LINE_BYTES ((ST7305_WIDTH + 5 * ST7305_MAX_SCALE) / 8 + 1)
+
+/**
+ * Expand a 1bpp row horizontally by an integer factor
+ * 
+ * Whole nibbles are expanded, so up to 3 pixels past count may follow
+ * in out; callers only read the first count * scale bits.
+ * 
+ * @param bits  Source row (MSB-first, PROGMEM or RAM)
+ * @param first Index of the first source pixel
+ * @param count Number of source pixels
+ * @param scale Repeat factor (1 .. ST7305_MAX_SCALE)
+ * @param out   Expanded row, starting at bit 7 of out[0]
+ */
+static void expandRow(const uint8_t *bits, int32_t first, int32_t count, uint8_t scale,
+                      uint8_t *out) {
+    int32_t end = first + count;
+    uint32_t acc = 0;   // Pending bits in the low n bits
+    uint8_t n = 0;
+    for (int32_t i = first; i < end; i += 4) {
+        uint8_t nib = fetchNibble(bits, i, end);
+        switch (scale) {
+            case 1: acc = (acc << 4) | nib;                  n += 4;  break;
+            case 2: acc = (acc << 8) | st7305_expand2[nib];  n += 8;  break;
+            case 3: acc = (acc << 12) | st7305_expand3[nib]; n += 12; break;
+            case 4: acc = (acc << 16) | st7305_expand4[nib]; n += 16; break;
+            default: {
+                uint32_t ones = (1UL << scale) - 1;
+                for (int8_t b = 3; b >= 0; b--) {
+                    acc = (acc << scale) | (((nib >> b) & 1) ? ones : 0);
+                    n += scale;
+                    while (n >= 8) {
+                        n -= 8;
+                        *out++ = (uint8_t)(acc >> n);
+                    }
+                }
+                break;
+            }
+        }
+        while (n >= 8) {
+            n -= 8;
+            *out++ = (uint8_t)(acc >> n);
+        }
+    }
+    if (n > 0) {
+        *out = (uint8_t)(acc << (8 - n));
+    }
+}
+
+/**
+ * Unpack one row of native 4x2 data to 1bpp, whole source bytes
+ * 
+ * @param src    Source row-pair
+ * @param b0, b1 First and last source byte
+ * @param odd    1 for the odd row of the pair
+ * @param out    1bpp row, pixel 4 * b0 at bit 7 of out[0]
+ */
+static void unpackRow(const uint8_t *src, int32_t b0, int32_t b1, uint8_t odd, uint8_t *out) {
+    for (int32_t b = b0; b <= b1; b++) {
+        uint8_t v = (uint8_t)(src[b] << odd);   // Row bits to 7, 5, 3, 1
+        uint8_t nib = ((v >> 4) & 0x08) | ((v >> 3) & 0x04) | ((v >> 2) & 0x02) | ((v >> 1) & 0x01);
+        if ((b - b0) & 1) {
+            *out++ |= nib;
+        } else {
+            *out = nib << 4;
+        }
+    }
+}
+
+/**
+ * Draw Bitmap Scaled - Zoomed 1bpp blit, transparent background
+ * 
+ * @param scaleX, scaleY Zoom factors
+ * @param color          Color for set bits
+ */
+void ST7305_Mono::drawBitmapScaled(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h,
+                                   uint8_t scaleX, uint8_t scaleY, uint16_t color) {
+    if ((scaleX == 1) && (scaleY == 1)) {
+        blitBitmap(x, y, bitmap, w, h, color, color, false);
+        return;
+    }
+    blitScaled(x, y, bitmap, (int32_t)((w + 7) / 8) * 8, w, h, scaleX, scaleY, color, color,
+               false, false);
+}
+
+/**
+ * Draw Bitmap Scaled - Zoomed 1bpp blit, opaque background
+ * 
+ * @param color Color for set bits
+ * @param bg    Color for clear bits
+ */
+void ST7305_Mono::drawBitmapScaled(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h,
+                                   uint8_t scaleX, uint8_t scaleY, uint16_t color, uint16_t bg) {
+    if ((scaleX == 1) && (scaleY == 1)) {
+        blitBitmap(x, y, bitmap, w, h, color, bg, true);
+        return;
+    }
+    blitScaled(x, y, bitmap, (int32_t)((w + 7) / 8) * 8, w, h, scaleX, scaleY, color, bg,
+               true, false);
+}
+
+/**
+ * Draw Packed Scaled - Zoomed blit of native 4x2 packed data
+ */
+void ST7305_Mono::drawPackedScaled(int16_t x, int16_t y, const uint8_t *data, int16_t w, int16_t h,
+                                   uint8_t scaleX, uint8_t scaleY) {
+    if ((scaleX == 1) && (scaleY == 1)) {
+        drawPacked(x, y, data, w, h);
+        return;
+    }
+    blitScaled(x, y, data, 0, w, h, scaleX, scaleY, ST7305_WHITE, ST7305_BLACK, true, true);
+}
+
+/**
+ * Draw Char - One glyph at equal horizontal and vertical size
+ */
+void ST7305_Mono::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg,
+                           uint8_t size) {
+    drawChar(x, y, c, color, bg, size, size);
+}
+
+/**
+ * Draw Char - One glyph through the scaled blit
+ * 
+ * Adafruit_GFX keeps the classic 5x7 font private, so a classic glyph
+ * is drawn once at size 1 into an 8x8 canvas; its rows are the blit
+ * source (6 pixels wide when the background is drawn, the sixth column
+ * being spacing). Custom font glyphs are already rows of
+ * w bits with no padding, so they are blitted straight from the font,
+ * transparent, at the scaled glyph offset.
+ * 
+ * @param x, y           Cursor position (top-left, or baseline for custom fonts)
+ * @param c              Character
+ * @param color          Glyph color
+ * @param bg             Background color (drawn if different from color, classic font only)
+ * @param size_x, size_y Magnification
+ */
+void ST7305_Mono::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg,
+                           uint8_t size_x, uint8_t size_y) {
+    if (_dlMode == ST7305_DL_RECORD) {  // Measure the glyph, record one command
+        _dlMeasureX0 = INT16_MAX;
+        _dlMeasureY0 = INT16_MAX;
+        _dlMeasureX1 = INT16_MIN;
+        _dlMeasureY1 = INT16_MIN;
+        _dlMode = ST7305_DL_MEASURE;
+        Adafruit_GFX::drawChar(x, y, c, color, bg, size_x, size_y);
+        _dlMode = ST7305_DL_RECORD;
+        if (_dlMeasureX0 > _dlMeasureX1) {
+            return;
+        }
+        uint8_t flags = (color ? ST7305_DL_COLOR : 0) | (bg ? ST7305_DL_BG : 0) |
+                        ((bg != color) ? ST7305_DL_HAS_BG : 0);
+        st7305_dl_cmd_t *cmd = recordCommand(ST7305_DL_CHAR, flags, _dlMeasureX0, _dlMeasureY0,
+                                             _dlMeasureX1, _dlMeasureY1);
+        if (cmd) {
+            cmd->p[0] = x + _originX;
+            cmd->p[1] = y + _originY;
+            cmd->p[2] = c;
+            cmd->p[3] = size_x | (size_y << 8);
+            cmd->data = gfxFont;
+            return;
+        }
+    }
+    if ((_dlMode != ST7305_DL_IMMEDIATE) || (size_x < 1) || (size_y < 1) ||
+        (size_x > ST7305_MAX_SCALE) || (size_y > ST7305_MAX_SCALE)) {
+        Adafruit_GFX::drawChar(x, y, c, color, bg, size_x, size_y);
+        return;
+    }
+    
+    if (!gfxFont) {
+        uint8_t *rows = _glyphCanvas.getBuffer();
+        if (!rows) {
+            Adafruit_GFX::drawChar(x, y, c, color, bg, size_x, size_y);
+            return;
+        }
+        _glyphCanvas.fillScreen(0);
+        _glyphCanvas.cp437(_cp437);
+        _glyphCanvas.drawChar(0, 0, c, 1, 1, 1);
+        bool opaque = (bg != color);
+        blitScaled(x, y, rows, 8, opaque ? 6 : 5, 8, size_x, size_y, color, bg, opaque, false);
+        return;
+    }
+    
+    GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - (uint8_t)pgm_read_byte(&gfxFont->first));
+    uint8_t w = pgm_read_byte(&glyph->width);
+    uint8_t h = pgm_read_byte(&glyph->height);
+    if ((w == 0) || (h == 0)) {
+        return;
+    }
+    int8_t xo = pgm_read_byte(&glyph->xOffset);
+    int8_t yo = pgm_read_byte(&glyph->yOffset);
+    const uint8_t *bitmap = pgm_read_bitmap_ptr(gfxFont) + pgm_read_word(&glyph->bitmapOffset);
+    blitScaled(x + xo * size_x, y + yo * size_y, bitmap, w, w, h, size_x, size_y, color, color,
+               false, false);
+}
+
+/**
+ * Blit Scaled - Clip a zoomed source once, then widen and write its rows
+ * 
+ * Only the source columns and rows that reach the clip are processed.
+ * Each source row is expanded once into a stack row starting at the
+ * block of its first visible pixel, then written to every row-pair its
+ * scaleY destination rows touch; row-pairs fully inside the block take
+ * both rows in one pass.
+ * 
+ * @param x, y           Top-left corner
+ * @param src            1bpp rows (MSB-first) or packed row-pairs
+ * @param stride         Bits per 1bpp source row (unused for packed)
+ * @param w, h           Source size in pixels
+ * @param scaleX, scaleY Zoom factors (1 .. ST7305_MAX_SCALE)
+ * @param color, bg      Colors for set and clear bits
+ * @param opaque         false to leave clear bits untouched
+ * @param packed         src is in the native 4x2 layout
+ */
+void ST7305_Mono::blitScaled(int16_t x, int16_t y, const uint8_t *src, int32_t stride, int16_t w, int16_t h,
+                             uint8_t scaleX, uint8_t scaleY, uint16_t color, uint16_t bg, bool opaque,
+                             bool packed) {
+    if ((scaleX < 1) || (scaleY < 1) || (scaleX > ST7305_MAX_SCALE) || (scaleY > ST7305_MAX_SCALE)) {
+        return;
+    }
+    int32_t x0 = (int32_t)x + _originX;
+    int32_t y0 = (int32_t)y + _originY;
+    int32_t x1 = x0 + (int32_t)w * scaleX - 1;
+    int32_t y1 = y0 + (int32_t)h * scaleY - 1;
+    int32_t cx0 = (x0 < _clipX0) ? _clipX0 : x0;
+    int32_t cy0 = (y0 < _clipY0) ? _clipY0 : y0;
+    int32_t cx1 = (x1 > _clipX1) ? _clipX1 : x1;
+    int32_t cy1 = (y1 > _clipY1) ? _clipY1 : y1;
+    if ((cx0 > cx1) || (cy0 > cy1)) {
+        return;
+    }
+    if (_dlMode != ST7305_DL_IMMEDIATE) {
+        uint8_t flags = ST7305_DL_OPAQUE;
+        if (!packed) {
+            flags = (color ? ST7305_DL_COLOR : 0) | (opaque ? ST7305_DL_OPAQUE : 0) |
+                    (bg ? ST7305_DL_BG : 0);
+        }
+        st7305_dl_cmd_t *cmd = recordCommand(packed ? ST7305_DL_PACKED : ST7305_DL_BITMAP, flags,
+                                             cx0, cy0, cx1, cy1);
+        if (cmd) {
+            cmd->p[0] = x0; cmd->p[1] = y0;
+            cmd->p[2] = w;  cmd->p[3] = h;
+            cmd->scaleX = scaleX;
+            cmd->scaleY = scaleY;
+            cmd->data = src;
+            return;
+        }
+    }
+    
+    markDirty(cx0, cy0, cx1, cy1);
+    int32_t sc0 = (cx0 - x0) / scaleX;               // Visible source columns
+    int32_t sc1 = (cx1 - x0) / scaleX;
+    int32_t skip = cx0 - (x0 + sc0 * scaleX);         // Expanded pixels left of the clip
+    int32_t pairStride = (w + 3) / 4;
+    uint8_t line[ST7305_SCALE_LINE_BYTES];
+    uint8_t unpacked[ST7305_WIDTH / 8 + 2];
+    
+    for (int32_t sy = (cy0 - y0) / scaleY; sy <= (cy1 - y0) / scaleY; sy++) {
+        if (packed) {
+            unpackRow(src + (sy >> 1) * pairStride, sc0 >> 2, sc1 >> 2, sy & 1, unpacked);
+            expandRow(unpacked, sc0 & 3, sc1 - sc0 + 1, scaleX, line);
+        } else {
+            expandRow(src, sy * stride + sc0, sc1 - sc0 + 1, scaleX, line);
+        }
+        
+        int32_t dy0 = y0 + sy * scaleY;
+        int32_t dy1 = dy0 + scaleY - 1;
+        if (dy0 < cy0) dy0 = cy0;
+        if (dy1 > cy1) dy1 = cy1;
+        for (int32_t pair = dy0 >> 1; pair <= (dy1 >> 1); pair++) {
+            uint8_t rowMask = ST7305_ROW_MASK_BOTH;
+            if ((pair << 1) < dy0) rowMask &= ST7305_ROW_MASK_ODD;
+            if ((pair << 1) + 1 > dy1) rowMask &= ST7305_ROW_MASK_EVEN;
+            blitSpan(pair, cx0, line, skip, cx1 - cx0 + 1, rowMask, color, bg, opaque);
+        }
+    }
+}
+
+/**
+ * Display - Transfer frame buffer to display hardware
+ * 
+ * This function sends the entire 15KB frame buffer to the display using SPI.
+ * 
+ * Sequence:
+ * 1. Set column address range (0x2A): 0x12 to 0x2A
+ * 2. Set row address range (0x2B): 0x00 to 0xC7
+ * 3. Send memory write command (0x2C)
+ * 4. Transfer all 15,000 bytes via SPI in one transaction
+ * 
+ * Address ranges match reference implementation:
+ * - Column: 0x12 (18) to 0x2A (42)
+ * - Row: 0x00 (0) to 0xC7 (199)
+ * 
+ * Performance:
+ * - @ 1MHz: ~300ms for full screen update
+ * - @ 40MHz: ~100ms for full screen update
+ * 
+ * Note: This transfers the entire buffer. For partial updates,
+ * use displayRegion() or displayDirty().
+ */
+void ST7305_Mono::display() {
+    // Full window: columns 0x12-0x2A, rows 0x00-0xC7, all 15,000 bytes
+    // in one SPI transaction
+    sendWindow(buffer, 0, 0, ST7305_WIDTH, ST7305_HEIGHT);
+    
+    clearDirty();
+}
+
+/**
+ * Display Region - Transfer a window of the frame buffer
+ * 
+ * The controller addresses RAM in 12-pixel columns (3 buffer bytes)
+ * and row-pairs, so the region is widened to that grid. Each row-pair
+ * contributes one contiguous slice of the buffer; full-width windows
+ * are contiguous and go out as a single transfer.
+ * 
+ * @param x, y Top-left corner (absolute panel coordinates)
+ * @param w, h Size in pixels
+ */
+void ST7305_Mono::displayRegion(int16_t x, int16_t y, int16_t w, int16_t h) {
+    sendWindow(buffer, x, y, w, h);
+}
+
+/**
+ * Display Frame - Transfer regions of an external frame buffer
+ * 
+ * @param frame Frame buffer (native layout)
+ * @param rects Absolute regions
+ * @param count Number of regions, 0 for the whole frame
+ */
+void ST7305_Mono::displayFrame(const uint8_t *frame, const st7305_rect_t *rects, uint8_t count) {
+    if (count == 0) {
+        sendWindow(frame, 0, 0, ST7305_WIDTH, ST7305_HEIGHT);
+        return;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        sendWindow(frame, rects[i].x, rects[i].y, rects[i].w, rects[i].h);
+    }
+}
+
+/**
+ * Send Window - Windowed RAMWR of one region of a frame buffer
+ * 
+ * Each row-pair contributes one contiguous slice of src; full-width
+ * windows are contiguous and go out as a single run. Exactly the window
+ * is sent, also under mirrors (they gather from any source row), so
+ * bands and job slices keep their size; the damage that needs the
+ * reflection is widened where it is tracked (see coverMirrors()).
+ * 
+ * @param src  Frame buffer to read from
+ * @param x, y Top-left corner (absolute panel coordinates)
+ * @param w, h Size in pixels
+ */
+void ST7305_Mono::sendWindow(const uint8_t *src, int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (!beginWindowWrite(x, y, w, h)) {
+        return;
+    }
+    
+    uint16_t col0 = _windowX0 / ST7305_PIXELS_PER_COL;
+    uint16_t col1 = _windowX1 / ST7305_PIXELS_PER_COL;
+    uint16_t pair0 = _windowY0 / 2;
+    uint16_t pair1 = _windowY1 / 2;
+    uint32_t rowBytes = (uint32_t)(col1 - col0 + 1) * ST7305_BYTES_PER_COL;
+    
+    if (rowBytes == ST7305_BYTES_PER_ROW) {
+        rowBytes *= pair1 - pair0 + 1;  // One contiguous run
+        pair1 = pair0;
+    }
+    for (uint16_t pair = pair0; pair <= pair1; pair++) {
+        uint32_t offset = (uint32_t)pair * ST7305_BYTES_PER_ROW + col0 * ST7305_BYTES_PER_COL;
+        if (_transformsEnabled) {
+            writeTransformed(src, offset, rowBytes);
+        } else {
+            writeWindowData(src + offset, rowBytes);
+        }
+    }
+    endWindowWrite();
+}
+
+/**
+ * Begin Window Write - Set the address window and start a RAMWR
+ * 
+ * Leaves DC high, CS low and the SPI transaction open, so any number
+ * of writeWindowData() calls stream straight into display RAM. The
+ * snapped window is kept in _window* for callers that need its size.
+ * 
+ * @param x, y Top-left corner (absolute panel coordinates)
+ * @param w, h Size in pixels
+ * @return false if the region does not intersect the panel
+ */
+bool ST7305_Mono::beginWindowWrite(int16_t x, int16_t y, int16_t w, int16_t h) {
+    int32_t x0 = (x < 0) ? 0 : x;
+    int32_t y0 = (y < 0) ? 0 : y;
+    int32_t x1 = (int32_t)x + w - 1;
+    int32_t y1 = (int32_t)y + h - 1;
+    if (x1 > ST7305_WIDTH - 1) x1 = ST7305_WIDTH - 1;
+    if (y1 > ST7305_HEIGHT - 1) y1 = ST7305_HEIGHT - 1;
+    if ((x0 > x1) || (y0 > y1)) {
+        return false;
+    }
+    
+    _windowX0 = x0;
+    _windowY0 = y0;
+    _windowX1 = x1;
+    _windowY1 = y1;
+    
+    setAddressWindow(x0, y0, x1, y1);
+    sendCommand(ST7305_RAMWR);
+    
+    dcHigh();
+    csLow();
+    SPI.beginTransaction(_dataSettings);
+    return true;
+}
+
+/**
+ * Write Window Data - Stream bytes into the open RAMWR
+ * 
+ * SPI.transfer(buf, n) stores the received bytes back into buf, so the
+ * data is copied through a stack chunk first and the source (often the
+ * frame buffer, or a frame still shared with a pipeline) stays intact.
+ * The chunk size is set with setSpiChunkSize().
+ * 
+ * @param data Packed bytes
+ * @param len  Number of bytes
+ */
+void ST7305_Mono::writeWindowData(const uint8_t *data, uint32_t len) {
+    uint8_t chunk[ST7305_SPI_CHUNK_MAX];
+    if (_trace) {
+        _trace->data(data, len);
+    }
+    _spiStats.dataBytes += len;
+    while (len > 0) {
+        uint32_t n = (len > _spiConfig.chunkBytes) ? _spiConfig.chunkBytes : len;
+        memcpy(chunk, data, n);
+        SPI.transfer(chunk, n);
+        _spiStats.transfers++;
+        data += n;
+        len -= n;
+    }
+}
+
+/**
+ * Write Transformed - Stream frame bytes through the transforms
+ * 
+ * Like writeWindowData(), but each chunk is transformed in the bounce
+ * buffer after the copy, and the trace sees the bytes as sent.
+ * 
+ * @param src    Frame the bytes come from (mirrors read it)
+ * @param offset Frame index of the first byte
+ * @param len    Number of bytes
+ */
+void ST7305_Mono::writeTransformed(const uint8_t *src, uint32_t offset, uint32_t len) {
+    uint8_t chunk[ST7305_SPI_CHUNK_MAX];
+    _spiStats.dataBytes += len;
+    while (len > 0) {
+        uint32_t n = (len > _spiConfig.chunkBytes) ? _spiConfig.chunkBytes : len;
+        memcpy(chunk, src + offset, n);
+        applyTransforms(src, chunk, offset, n);
+        if (_trace) {
+            _trace->data(chunk, n);
+        }
+        SPI.transfer(chunk, n);
+        _spiStats.transfers++;
+        offset += n;
+        len -= n;
+    }
+}
+
+/**
+ * End Window Write - Finish the RAMWR started by beginWindowWrite()
+ */
+void ST7305_Mono::endWindowWrite() {
+    SPI.endTransaction();
+    csHigh();
+}
+
+/**
+ * Display Dirty - Transfer the dirty bounding box only
+ * 
+ * Typical use is redrawing a small readout and pushing just that part
+ * of the screen instead of the full 15KB buffer.
+ */
+void ST7305_Mono::displayDirty() {
+    st7305_rect_t dirty = getDirtyRect();
+    if (dirty.w <= 0) {
+        return;
+    }
+    displayRegion(dirty.x, dirty.y, dirty.w, dirty.h);
+    clearDirty();
+}
+
+/**
+ * Get Dirty Rect - Bounding box of changes since the last flush
+ * 
+ * Includes the reflection of changes inside enabled mirrors.
+ * 
+ * @return Absolute rectangle, w = h = 0 when clean
+ */
+st7305_rect_t ST7305_Mono::getDirtyRect() const {
+    st7305_rect_t r = { 0, 0, 0, 0 };
+    if (_dirtyX0 <= _dirtyX1) {
+        int16_t x0 = _dirtyX0, y0 = _dirtyY0, x1 = _dirtyX1, y1 = _dirtyY1;
+        if (_transformsEnabled) {
+            coverMirrors(x0, y0, x1, y1);
+        }
+        r.x = x0;
+        r.y = y0;
+        r.w = x1 - x0 + 1;
+        r.h = y1 - y0 + 1;
+    }
+    return r;
+}
+
+/**
+ * Invalidate Rect - Mark an absolute region dirty (clipped to the panel)
+ */
+void ST7305_Mono::invalidateRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+    int32_t x0 = (x < 0) ? 0 : x;
+    int32_t y0 = (y < 0) ? 0 : y;
+    int32_t x1 = (int32_t)x + w - 1;
+    int32_t y1 = (int32_t)y + h - 1;
+    if (x1 > ST7305_WIDTH - 1) x1 = ST7305_WIDTH - 1;
+    if (y1 > ST7305_HEIGHT - 1) y1 = ST7305_HEIGHT - 1;
+    if ((x0 <= x1) && (y0 <= y1)) {
+        markDirty(x0, y0, x1, y1);
+    }
+}
+
+/**
+ * Clear Dirty - Reset the dirty bounding box to empty
+ */
+void ST7305_Mono::clearDirty() {
+    _dirtyX0 = INT16_MAX;
+    _dirtyY0 = INT16_MAX;
+    _dirtyX1 = INT16_MIN;
+    _dirtyY1 = INT16_MIN;
+}
+
+// ===== Clipping & Viewports =====
+
+/**
+ * Push Clip - Intersect the active clip with a rectangle
+ * 
+ * @param x, y, w, h Rectangle in current viewport coordinates
+ * @return false if the clip stack is full
+ */
+bool ST7305_Mono::pushClip(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (_clipDepth >= ST7305_CLIP_STACK_DEPTH) {
+        return false;
+    }
+    
+    st7305_clip_t &saved = _clipStack[_clipDepth++];
+    saved.x0 = _clipX0;
+    saved.y0 = _clipY0;
+    saved.x1 = _clipX1;
+    saved.y1 = _clipY1;
+    saved.originX = _originX;
+    saved.originY = _originY;
+    
+    int32_t x0 = (int32_t)x + _originX;
+    int32_t y0 = (int32_t)y + _originY;
+    int32_t x1 = x0 + w - 1;
+    int32_t y1 = y0 + h - 1;
+    if (x0 > _clipX0) _clipX0 = x0;
+    if (y0 > _clipY0) _clipY0 = y0;
+    if (x1 < _clipX1) _clipX1 = x1;
+    if (y1 < _clipY1) _clipY1 = y1;
+    return true;
+}
+
+/**
+ * Push Viewport - Clip to a rectangle and translate the origin to it
+ * 
+ * @param x, y, w, h Rectangle in current viewport coordinates
+ * @return false if the clip stack is full
+ */
+bool ST7305_Mono::pushViewport(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (!pushClip(x, y, w, h)) {
+        return false;
+    }
+    _originX += x;
+    _originY += y;
+    return true;
+}
+
+/**
+ * Pop Clip - Restore the previous clip rectangle and origin
+ */
+void ST7305_Mono::popClip() {
+    if (_clipDepth == 0) {
+        return;
+    }
+    
+    const st7305_clip_t &saved = _clipStack[--_clipDepth];
+    _clipX0 = saved.x0;
+    _clipY0 = saved.y0;
+    _clipX1 = saved.x1;
+    _clipY1 = saved.y1;
+    _originX = saved.originX;
+    _originY = saved.originY;
+}
+
+/**
+ * Reset Clip - Full panel clip, origin at (0,0), empty stack
+ */
+void ST7305_Mono::resetClip() {
+    _clipX0 = 0;
+    _clipY0 = 0;
+    _clipX1 = ST7305_WIDTH - 1;
+    _clipY1 = ST7305_HEIGHT - 1;
+    _originX = 0;
+    _originY = 0;
+    _clipDepth = 0;
+}
+
+/**
+ * Get Clip Rect - Active clip in absolute panel coordinates
+ * 
+ * @return Clip rectangle (w/h of 0 if everything is clipped)
+ */
+st7305_rect_t ST7305_Mono::getClipRect() const {
+    st7305_rect_t r = { _clipX0, _clipY0, 0, 0 };
+    if ((_clipX0 <= _clipX1) && (_clipY0 <= _clipY1)) {
+        r.w = _clipX1 - _clipX0 + 1;
+        r.h = _clipY1 - _clipY0 + 1;
+    }
+    return r;
+}
+
+// ===== Display List (Recording Mode) =====
+
+/**
+ * FNV-1a step over the four bytes of a 32-bit value
+ */
+static inline uint32_t hashWord(uint32_t hash, uint32_t value) {
+    for (uint8_t i = 0; i < 4; i++) {
+        hash = (hash ^ (value & 0xFF)) * 16777619UL;
+        value >>= 8;
+    }
+    return hash;
+}
+
+/**
+ * Begin Recording - Start capturing draw calls for one frame
+ * 
+ * The list is allocated on first use. Tiles touched by immediate-mode
+ * drawing since the last frame (the pending dirty area) are marked
+ * unknown so they are repainted. A render job still running from the
+ * previous frame is finished first.
+ * 
+ * @return false if the list could not be allocated
+ */
+bool ST7305_Mono::beginRecording() {
+    if (_jobRender && (_jobPhase != ST7305_JOB_IDLE)) {
+        finishJob();  // Its tiles replay from the list about to be reused
+    }
+    if (!_dl) {
+        _dl = (st7305_display_list_t*)malloc(sizeof(st7305_display_list_t));
+        if (!_dl) {
+            return false;
+        }
+        memset(_dl->tileHash, 0, sizeof(_dl->tileHash));
+    }
+    
+    if (_dirtyX0 <= _dirtyX1) {
+        for (uint16_t t = 0; t < ST7305_TILE_COUNT; t++) {
+            int16_t x0, y0, x1, y1;
+            tileRect(t, x0, y0, x1, y1);
+            if ((x0 <= _dirtyX1) && (x1 >= _dirtyX0) && (y0 <= _dirtyY1) && (y1 >= _dirtyY0)) {
+                _dl->tileHash[t] = 0;
+            }
+        }
+        clearDirty();
+    }
+    
+    _dl->count = 0;
+    _dl->vertexCount = 0;
+    _dl->background = 0x00;
+    _dlMode = ST7305_DL_RECORD;
+    _dlFlattened = false;
+    memset(&_dlStats, 0, sizeof(_dlStats));
+    _dlStats.tilesTotal = ST7305_TILE_COUNT;
+    return true;
+}
+
+/**
+ * End Recording - Rasterize changed tiles and flush them
+ * 
+ * A changed tile is cleared to the frame background (unless an opaque
+ * command covers it), its visible commands are replayed with the clip
+ * set to each command's bounds within the tile, and adjacent changed
+ * tiles in a tile row are sent as one window.
+ * 
+ * @param flush false to leave the redrawn tiles in the dirty area
+ * @return false if not recording, or the frame overflowed and was refused
+ */
+bool ST7305_Mono::endRecording(bool flush) {
+    if (_dlFlattened) {
+        _dlFlattened = false;
+        _dlStats.tilesChanged = ST7305_TILE_COUNT;
+        if (flush) {
+            displayDirty();
+        }
+        return true;
+    }
+    if (_dlMode != ST7305_DL_RECORD) {
+        return false;
+    }
+    if (refuseRecording()) {
+        return false;
+    }
+    
+    st7305_clip_t saved = { _clipX0, _clipY0, _clipX1, _clipY1, _originX, _originY };
+    uint16_t visible[ST7305_DL_MAX_COMMANDS];
+    bool changed[ST7305_TILE_COUNT];
+    
+    for (uint16_t t = 0; t < ST7305_TILE_COUNT; t++) {
+        changed[t] = rasterizeTile(t, visible);
+    }
+    
+    _clipX0 = saved.x0;
+    _clipY0 = saved.y0;
+    _clipX1 = saved.x1;
+    _clipY1 = saved.y1;
+    _originX = saved.originX;
+    _originY = saved.originY;
+    
+    if (!flush) {
+        return true;
+    }
+    uint16_t tile = 0;
+    int16_t x0, y0, x1, y1;
+    while (nextTileRun(changed, tile, x0, y0, x1, y1)) {
+        displayRegion(x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+    }
+    clearDirty();
+    return true;
+}
+
+/**
+ * Refuse Recording - Leave recording mode; drop an overflowed frame
+ * 
+ * An overflowed frame is not drawn at all: the buffer and the tile
+ * hashes keep the previous frame. Tiles that beginRecording() marked
+ * unknown (immediate drawing not yet sent) are marked dirty again.
+ * 
+ * @return true if the frame overflowed and was dropped
+ */
+bool ST7305_Mono::refuseRecording() {
+    _dlMode = ST7305_DL_IMMEDIATE;
+    _dlStats.commands = _dl->count;
+    if (!_dlStats.overflowed) {
+        return false;
+    }
+    for (uint16_t t = 0; t < ST7305_TILE_COUNT; t++) {
+        if (_dl->tileHash[t] == 0) {
+            int16_t x0, y0, x1, y1;
+            tileRect(t, x0, y0, x1, y1);
+            markDirty(x0, y0, x1, y1);
+        }
+    }
+    _dl->count = 0;
+    _dl->vertexCount = 0;
+    return true;
+}
+
+/**
+ * Rasterize Tile - Redraw one tile if its hash changed
+ * 
+ * The tile is cleared to the frame background (unless an opaque
+ * command covers it) and its visible commands are replayed. Leaves the
+ * clip set by the last replay; callers restore it.
+ * 
+ * @param tile    Tile index
+ * @param visible Scratch for ST7305_DL_MAX_COMMANDS indices
+ * @return true if the tile changed (it is then marked dirty)
+ */
+bool ST7305_Mono::rasterizeTile(uint16_t tile, uint16_t *visible) {
+    uint16_t n;
+    uint32_t hash = hashTile(tile, visible, n);
+    if (hash == _dl->tileHash[tile]) {
+        return false;
+    }
+    _dl->tileHash[tile] = hash;
+    _dlStats.tilesChanged++;
+    _dlStats.replayed += n;
+    
+    int16_t x0, y0, x1, y1;
+    tileRect(tile, x0, y0, x1, y1);
+    markDirty(x0, y0, x1, y1);
+    
+    const st7305_dl_cmd_t *first = (n > 0) ? &_dl->cmds[visible[0]] : nullptr;
+    if (!first || !(first->flags & ST7305_DL_OPAQUE) ||
+        (first->x0 > x0) || (first->y0 > y0) || (first->x1 < x1) || (first->y1 < y1)) {
+        for (int16_t pair = y0 >> 1; pair <= (y1 >> 1); pair++) {
+            memset(buffer + (uint32_t)pair * ST7305_BYTES_PER_ROW + (x0 >> 2),
+                   _dl->background, (x1 - x0 + 1) >> 2);
+        }
+    }
+    
+    for (uint16_t i = 0; i < n; i++) {
+        const st7305_dl_cmd_t &cmd = _dl->cmds[visible[i]];
+        replayCommand(cmd, (cmd.x0 > x0) ? cmd.x0 : x0, (cmd.y0 > y0) ? cmd.y0 : y0,
+                      (cmd.x1 < x1) ? cmd.x1 : x1, (cmd.y1 < y1) ? cmd.y1 : y1);
+    }
+    return true;
+}
+
+/**
+ * Next Tile Run - Find the next run of adjacent changed tiles in a row
+ * 
+ * @param changed Per-tile flags
+ * @param tile    Index to scan from; set past the run found
+ * @param x0..y1  Receives the run's bounds (absolute, inclusive)
+ * @return false if no changed tile is left
+ */
+bool ST7305_Mono::nextTileRun(const bool *changed, uint16_t &tile,
+                              int16_t &x0, int16_t &y0, int16_t &x1, int16_t &y1) {
+    while ((tile < ST7305_TILE_COUNT) && !changed[tile]) {
+        tile++;
+    }
+    if (tile >= ST7305_TILE_COUNT) {
+        return false;
+    }
+    uint16_t rowEnd = (tile / ST7305_TILES_X + 1) * ST7305_TILES_X;
+    uint16_t run = tile;
+    while ((tile < rowEnd) && changed[tile]) {
+        tile++;
+    }
+    int16_t ex, ey;
+    tileRect(run, x0, y0, ex, ey);
+    tileRect(tile - 1, ex, ey, x1, y1);
+    if (_transformsEnabled) {
+        coverMirrors(x0, y0, x1, y1);
+    }
+    return true;
+}
+
+// ===== Time-Sliced Jobs =====
+
+/**
+ * Update Estimate - Move a running time estimate towards a new sample
+ */
+static inline void updateEstimate(uint32_t &estimate, uint32_t sample) {
+    if (estimate == 0) {
+        estimate = sample;
+    } else {
+        estimate = (uint32_t)((int32_t)estimate + (((int32_t)sample - (int32_t)estimate) >> ST7305_JOB_EMA_SHIFT));
+    }
+}
+
+/**
+ * Start Render Job - End recording, rasterize and flush in slices
+ * 
+ * @return false if not recording, overflowed or a job is running
+ */
+bool ST7305_Mono::startRenderJob() {
+    if (_jobPhase != ST7305_JOB_IDLE) {
+        return false;
+    }
+    if (_dlFlattened) {  // Flattened: already rasterized, send the dirty area
+        _dlFlattened = false;
+        _dlStats.tilesChanged = ST7305_TILE_COUNT;
+        return startFlushJob();
+    }
+    if ((_dlMode != ST7305_DL_RECORD) || refuseRecording()) {
+        return false;
+    }
+    
+    memset(&_jobProgress, 0, sizeof(_jobProgress));
+    _jobProgress.phase = ST7305_JOB_RENDER;
+    _jobProgress.tilesTotal = ST7305_TILE_COUNT;
+    _jobPhase = ST7305_JOB_RENDER;
+    _jobRender = true;
+    _jobTile = 0;
+    return true;
+}
+
+/**
+ * Start Flush Job - Take over the dirty area and send it in slices
+ * 
+ * @return false if clean or a job is running
+ */
+bool ST7305_Mono::startFlushJob() {
+    if ((_jobPhase != ST7305_JOB_IDLE) || (_dirtyX0 > _dirtyX1)) {
+        return false;
+    }
+    st7305_rect_t dirty = getDirtyRect();
+    clearDirty();
+    return startFlushJob(dirty.x, dirty.y, dirty.w, dirty.h);
+}
+
+/**
+ * Start Flush Job - Send a region in slices
+ * 
+ * @param x, y, w, h Region (absolute pixels, clipped to the panel)
+ * @return false if off-screen or a job is running
+ */
+bool ST7305_Mono::startFlushJob(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (_jobPhase != ST7305_JOB_IDLE) {
+        return false;
+    }
+    int32_t x0 = (x < 0) ? 0 : x;
+    int32_t y0 = (y < 0) ? 0 : y;
+    int32_t x1 = (int32_t)x + w - 1;
+    int32_t y1 = (int32_t)y + h - 1;
+    if (x1 > ST7305_WIDTH - 1) x1 = ST7305_WIDTH - 1;
+    if (y1 > ST7305_HEIGHT - 1) y1 = ST7305_HEIGHT - 1;
+    if ((x0 > x1) || (y0 > y1)) {
+        return false;
+    }
+    
+    _jobX0 = x0;
+    _jobX1 = x1;
+    _jobPair = y0 / 2;
+    _jobPair1 = y1 / 2;
+    memset(&_jobProgress, 0, sizeof(_jobProgress));
+    _jobProgress.phase = ST7305_JOB_FLUSH;
+    _jobProgress.bytesTotal = windowCost(x0, y0, x1, y1) - ST7305_WINDOW_OVERHEAD;
+    _jobPhase = ST7305_JOB_FLUSH;
+    _jobRender = false;
+    return true;
+}
+
+/**
+ * Step Job - Render tiles, then send row-pairs, until the budget is used
+ * 
+ * A tile is only started if the estimated tile time still fits. The
+ * row-pairs of one step go out as a single window, as many as the
+ * estimated time per byte (window setup included) allows.
+ * 
+ * @param budgetMicros Time for this call
+ * @param maxUnits     Cap on tiles + row-pairs (0 = none)
+ * @return true while work remains
+ */
+bool ST7305_Mono::stepJob(uint32_t budgetMicros, uint16_t maxUnits) {
+    if (_jobPhase == ST7305_JOB_IDLE) {
+        return false;
+    }
+    uint32_t start = micros();
+    uint16_t units = 0;
+    
+    if (_jobPhase == ST7305_JOB_RENDER) {
+        st7305_clip_t saved = { _clipX0, _clipY0, _clipX1, _clipY1, _originX, _originY };
+        uint16_t visible[ST7305_DL_MAX_COMMANDS];
+        while (_jobTile < ST7305_TILE_COUNT) {
+            uint32_t elapsed = micros() - start;
+            if ((units > 0) &&
+                ((maxUnits && (units >= maxUnits)) || (elapsed + _jobTileMicros > budgetMicros))) {
+                break;
+            }
+            uint32_t t0 = micros();
+            _jobChanged[_jobTile] = rasterizeTile(_jobTile, visible);
+            updateEstimate(_jobTileMicros, micros() - t0);
+            _jobTile++;
+            units++;
+        }
+        _clipX0 = saved.x0;
+        _clipY0 = saved.y0;
+        _clipX1 = saved.x1;
+        _clipY1 = saved.y1;
+        _originX = saved.originX;
+        _originY = saved.originY;
+        _jobProgress.tilesDone = _jobTile;
+        if (_jobTile < ST7305_TILE_COUNT) {
+            finishJobStep(start);
+            return true;
+        }
+        
+        // All tiles rendered: price the changed runs, then send them
+        uint16_t tile = 0;
+        int16_t x0, y0, x1, y1;
+        while (nextTileRun(_jobChanged, tile, x0, y0, x1, y1)) {
+            _jobProgress.bytesTotal += windowCost(x0, y0, x1, y1) - ST7305_WINDOW_OVERHEAD;
+        }
+        _jobTile = 0;
+        _jobPhase = ST7305_JOB_FLUSH;
+        nextJobWindow();
+    }
+    
+    while (_jobPhase == ST7305_JOB_FLUSH) {
+        uint32_t elapsed = micros() - start;
+        if ((units > 0) && ((maxUnits && (units >= maxUnits)) || (elapsed >= budgetMicros))) {
+            break;
+        }
+        uint32_t rowBytes = windowCost(_jobX0, 0, _jobX1, 1) - ST7305_WINDOW_OVERHEAD;
+        uint32_t pairs = ST7305_JOB_FIRST_PAIRS;
+        if (_jobByteNanos) {
+            uint32_t left = (budgetMicros > elapsed) ? budgetMicros - elapsed : 0;
+            uint64_t bytes = (uint64_t)left * 1000 / _jobByteNanos;
+            pairs = (bytes > ST7305_WINDOW_OVERHEAD)
+                  ? (uint32_t)((bytes - ST7305_WINDOW_OVERHEAD) / rowBytes) : 0;
+        }
+        if (pairs == 0) {
+            if (units > 0) {
+                break;
+            }
+            pairs = 1;
+        }
+        if (maxUnits && (pairs > (uint32_t)(maxUnits - units))) {
+            pairs = maxUnits - units;
+        }
+        if (pairs > (uint32_t)(_jobPair1 - _jobPair + 1)) {
+            pairs = _jobPair1 - _jobPair + 1;
+        }
+        
+        uint32_t t0 = micros();
+        sendWindow(buffer, _jobX0, _jobPair * 2, _jobX1 - _jobX0 + 1, pairs * 2);
+        uint32_t bytes = rowBytes * pairs;
+        uint32_t nanos = (uint32_t)((uint64_t)(micros() - t0) * 1000 / (bytes + ST7305_WINDOW_OVERHEAD));
+        updateEstimate(_jobByteNanos, nanos ? nanos : 1);
+        _jobProgress.bytesDone += bytes;
+        _jobPair += pairs;
+        units += pairs;
+        if (_jobPair > _jobPair1) {
+            nextJobWindow();
+        }
+    }
+    finishJobStep(start);
+    return _jobPhase != ST7305_JOB_IDLE;
+}
+
+/**
+ * Finish Job - Step without a time limit until done
+ */
+void ST7305_Mono::finishJob() {
+    while (stepJob(UINT32_MAX)) {
+    }
+}
+
+/**
+ * Cancel Job - Drop the rest of the job
+ * 
+ * A render job's tiles are marked dirty as they are rendered and stay
+ * so until the job completes; a flush job marks what it has not sent.
+ */
+void ST7305_Mono::cancelJob() {
+    if (_jobPhase == ST7305_JOB_IDLE) {
+        return;
+    }
+    if (!_jobRender && (_jobPair <= _jobPair1)) {
+        markDirty(_jobX0, _jobPair * 2, _jobX1, _jobPair1 * 2 + 1);
+    }
+    _jobPhase = ST7305_JOB_IDLE;
+    _jobProgress.phase = ST7305_JOB_IDLE;
+}
+
+/**
+ * Next Job Window - Move the flush on to the next run of changed tiles
+ * 
+ * Ends the job when none is left (a render job then clears the dirty
+ * area, like endRecording()).
+ * 
+ * @return false if the job is done
+ */
+bool ST7305_Mono::nextJobWindow() {
+    int16_t x0, y0, x1, y1;
+    if (_jobRender && nextTileRun(_jobChanged, _jobTile, x0, y0, x1, y1)) {
+        _jobX0 = x0;
+        _jobX1 = x1;
+        _jobPair = y0 / 2;
+        _jobPair1 = y1 / 2;
+        return true;
+    }
+    if (_jobRender) {
+        clearDirty();
+    }
+    _jobPhase = ST7305_JOB_IDLE;
+    return false;
+}
+
+/**
+ * Finish Job Step - Update the progress counters after a step
+ * 
+ * @param start micros() when the step began
+ */
+void ST7305_Mono::finishJobStep(uint32_t start) {
+    st7305_job_progress_t &p = _jobProgress;
+    uint32_t took = micros() - start;
+    p.steps++;
+    if (took > p.maxStepMicros) {
+        p.maxStepMicros = took;
+    }
+    p.phase = _jobPhase;
+    if (_jobPhase == ST7305_JOB_IDLE) {
+        p.percent = 100;
+    } else if (_jobRender) {
+        p.percent = (uint8_t)(p.tilesDone * 50 / p.tilesTotal);
+        if (_jobPhase == ST7305_JOB_FLUSH) {
+            p.percent += (uint8_t)(p.bytesTotal ? (uint64_t)p.bytesDone * 50 / p.bytesTotal : 50);
+        }
+    } else {
+        p.percent = (uint8_t)((uint64_t)p.bytesDone * 100 / p.bytesTotal);
+    }
+}
+
+/**
+ * Flatten Recording - Rasterize the list now, continue immediately
+ * 
+ * The whole buffer is redrawn from the frame background, so every
+ * tile hash is reset and the next frame repaints all tiles.
+ */
+void ST7305_Mono::flattenRecording() {
+    if (_dlMode != ST7305_DL_RECORD) {
+        return;
+    }
+    _dlMode = ST7305_DL_IMMEDIATE;
+    _dlFlattened = true;
+    _dlStats.commands = _dl->count;
+    _dlStats.replayed = _dl->count;
+    
+    st7305_clip_t saved = { _clipX0, _clipY0, _clipX1, _clipY1, _originX, _originY };
+    memset(buffer, _dl->background, ST7305_BUFFER_SIZE);
+    markDirty(0, 0, ST7305_WIDTH - 1, ST7305_HEIGHT - 1);
+    for (uint16_t i = 0; i < _dl->count; i++) {
+        const st7305_dl_cmd_t &cmd = _dl->cmds[i];
+        replayCommand(cmd, cmd.x0, cmd.y0, cmd.x1, cmd.y1);
+    }
+    _clipX0 = saved.x0;
+    _clipY0 = saved.y0;
+    _clipX1 = saved.x1;
+    _clipY1 = saved.y1;
+    _originX = saved.originX;
+    _originY = saved.originY;
+    
+    _dl->count = 0;
+    _dl->vertexCount = 0;
+    memset(_dl->tileHash, 0, sizeof(_dl->tileHash));
+}
+
+/**
+ * Invalidate Recording - Forget all tile hashes
+ */
+void ST7305_Mono::invalidateRecording() {
+    if (_dl) {
+        memset(_dl->tileHash, 0, sizeof(_dl->tileHash));
+    }
+}
+
+/**
+ * Record Deferred - Store a callback draw in the display list
+ * 
+ * @return true if recorded (or entirely clipped), false to draw directly
+ */
+bool ST7305_Mono::recordDeferred(int16_t x, int16_t y, int16_t w, int16_t h,
+                                 st7305_dl_replay_t replay, const void *data, bool opaque) {
+    if (_dlMode == ST7305_DL_IMMEDIATE) {
+        return false;
+    }
+    
+    int32_t x0 = (int32_t)x + _originX;
+    int32_t y0 = (int32_t)y + _originY;
+    int32_t cx0 = (x0 < _clipX0) ? _clipX0 : x0;
+    int32_t cy0 = (y0 < _clipY0) ? _clipY0 : y0;
+    int32_t cx1 = (x0 + w - 1 > _clipX1) ? _clipX1 : x0 + w - 1;
+    int32_t cy1 = (y0 + h - 1 > _clipY1) ? _clipY1 : y0 + h - 1;
+    if ((cx0 > cx1) || (cy0 > cy1)) {
+        return true;
+    }
+    
+    st7305_dl_cmd_t *cmd = recordCommand(ST7305_DL_DEFERRED, opaque ? ST7305_DL_OPAQUE : 0,
+                                         cx0, cy0, cx1, cy1);
+    if (!cmd) {
+        return false;
+    }
+    cmd->p[0] = x0; cmd->p[1] = y0;
+    cmd->p[2] = w;  cmd->p[3] = h;
+    cmd->data = data;
+    cmd->replay = replay;
+    return true;
+}
+
+/**
+ * Write - Print a character; one glyph command while recording
+ * 
+ * The glyph is first run through Adafruit_GFX::write() in measuring
+ * mode, which advances the cursor (including wrapping) and yields the
+ * glyph's clipped bounds. drawChar() ran one advance before the new
+ * cursor position, which is what gets recorded.
+ */
+size_t ST7305_Mono::write(uint8_t c) {
+    if (_dlMode != ST7305_DL_RECORD) {
+        return writeImmediate(c);
+    }
+    
+    int16_t cursorX = cursor_x, cursorY = cursor_y;
+    _dlMeasureX0 = INT16_MAX;
+    _dlMeasureY0 = INT16_MAX;
+    _dlMeasureX1 = INT16_MIN;
+    _dlMeasureY1 = INT16_MIN;
+    _dlMode = ST7305_DL_MEASURE;
+    Adafruit_GFX::write(c);
+    _dlMode = ST7305_DL_RECORD;
+    if (_dlMeasureX0 > _dlMeasureX1) {
+        return 1;  // Control character, blank glyph or clipped away
+    }
+    
+    int16_t advance = 6;
+    if (gfxFont) {
+        GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - (uint8_t)pgm_read_byte(&gfxFont->first));
+        advance = (uint8_t)pgm_read_byte(&glyph->xAdvance);
+    }
+    uint8_t flags = (textcolor ? ST7305_DL_COLOR : 0) | (textbgcolor ? ST7305_DL_BG : 0) |
+                    ((textbgcolor != textcolor) ? ST7305_DL_HAS_BG : 0);
+    st7305_dl_cmd_t *cmd = recordCommand(ST7305_DL_CHAR, flags, _dlMeasureX0, _dlMeasureY0,
+                                         _dlMeasureX1, _dlMeasureY1);
+    if (!cmd) {  // List full and flattened: draw this glyph now
+        cursor_x = cursorX;
+        cursor_y = cursorY;
+        return writeImmediate(c);
+    }
+    cmd->p[0] = cursor_x - advance * textsize_x + _originX;
+    cmd->p[1] = cursor_y + _originY;
+    cmd->p[2] = c;
+    cmd->p[3] = textsize_x | (textsize_y << 8);
+    cmd->data = gfxFont;
+    return 1;
+}
+
+/**
+ * Write Immediate - Adafruit_GFX::write() drawing through drawChar()
+ * 
+ * Same cursor advance and wrapping as the base class, which calls its
+ * own (non-virtual) drawChar() and so would miss the blit path.
+ */
+size_t ST7305_Mono::writeImmediate(uint8_t c) {
+    if (!gfxFont) {
+        if (c == '\n') {
+            cursor_x = 0;
+            cursor_y += textsize_y * 8;
+        } else if (c != '\r') {
+            if (wrap && ((cursor_x + textsize_x * 6) > _width)) {
+                cursor_x = 0;
+                cursor_y += textsize_y * 8;
+            }
+            drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+            cursor_x += textsize_x * 6;
+        }
+        return 1;
+    }
+    
+    uint8_t yAdvance = pgm_read_byte(&gfxFont->yAdvance);
+    if (c == '\n') {
+        cursor_x = 0;
+        cursor_y += (int16_t)textsize_y * yAdvance;
+        return 1;
+    }
+    uint8_t first = pgm_read_byte(&gfxFont->first);
+    if ((c == '\r') || (c < first) || (c > (uint8_t)pgm_read_byte(&gfxFont->last))) {
+        return 1;
+    }
+    GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - first);
+    uint8_t w = pgm_read_byte(&glyph->width);
+    uint8_t h = pgm_read_byte(&glyph->height);
+    if ((w > 0) && (h > 0)) {
+        int16_t xo = (int8_t)pgm_read_byte(&glyph->xOffset);
+        if (wrap && ((cursor_x + textsize_x * (xo + w)) > _width)) {
+            cursor_x = 0;
+            cursor_y += (int16_t)textsize_y * yAdvance;
+        }
+        drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+    }
+    cursor_x += (uint8_t)pgm_read_byte(&glyph->xAdvance) * (int16_t)textsize_x;
+    return 1;
+}
+
+/**
+ * Record Command - Append one entry
+ * 
+ * While measuring a glyph, only the bounds are accumulated and a
+ * scratch entry is returned. When the list is full the frame is marked
+ * overflowed and the scratch entry is returned too: the rest of the
+ * frame is dropped, and endRecording() refuses it. Nothing is
+ * rasterized here, so a draw call never turns into a whole frame.
+ * 
+ * @param op     Command type
+ * @param flags  ST7305_DL_* flags
+ * @param x0..y1 Clipped bounds (absolute, inclusive)
+ * @return Entry to fill in, or nullptr
+ */
+st7305_dl_cmd_t *ST7305_Mono::recordCommand(uint8_t op, uint8_t flags,
+                                            int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    if (_dlMode == ST7305_DL_MEASURE) {
+        if (x0 < _dlMeasureX0) _dlMeasureX0 = x0;
+        if (y0 < _dlMeasureY0) _dlMeasureY0 = y0;
+        if (x1 > _dlMeasureX1) _dlMeasureX1 = x1;
+        if (y1 > _dlMeasureY1) _dlMeasureY1 = y1;
+        return &_dlScratch;
+    }
+    if (_dl->count >= ST7305_DL_MAX_COMMANDS) {
+        _dlStats.overflowed = true;
+        return &_dlScratch;
+    }
+    
+    st7305_dl_cmd_t *cmd = &_dl->cmds[_dl->count++];
+    cmd->op = op;
+    cmd->flags = flags;
+    cmd->scaleX = cmd->scaleY = 1;
+    memset(cmd->p, 0, sizeof(cmd->p));
+    cmd->x0 = x0;
+    cmd->y0 = y0;
+    cmd->x1 = x1;
+    cmd->y1 = y1;
+    cmd->data = nullptr;
+    cmd->replay = nullptr;
+    return cmd;
+}
+
+/**
+ * Hash Tile - Bin, cull and hash the commands of one tile
+ * 
+ * Everything before the last opaque command covering the whole tile is
+ * hidden. Of the remaining commands touching the tile, any whose part
+ * of the tile lies inside a later opaque command is hidden too. The
+ * hash covers the background (when visible) and every surviving
+ * command's operands, bounds within the tile and data references.
+ * 
+ * @param tile    Tile index
+ * @param visible Receives surviving command indices in draw order
+ * @param count   Receives the number of surviving commands
+ * @return Non-zero hash
+ */
+uint32_t ST7305_Mono::hashTile(uint16_t tile, uint16_t *visible, uint16_t &count) {
+    int16_t tx0, ty0, tx1, ty1;
+    tileRect(tile, tx0, ty0, tx1, ty1);
+    const st7305_dl_cmd_t *cmds = _dl->cmds;
+    
+    uint16_t start = 0;
+    bool covered = false;
+    for (uint16_t i = _dl->count; i-- > 0;) {
+        const st7305_dl_cmd_t &c = cmds[i];
+        if ((c.flags & ST7305_DL_OPAQUE) &&
+            (c.x0 <= tx0) && (c.y0 <= ty0) && (c.x1 >= tx1) && (c.y1 >= ty1)) {
+            start = i;
+            covered = true;
+            break;
+        }
+    }
+    
+    uint16_t n = 0;
+    for (uint16_t i = start; i < _dl->count; i++) {
+        const st7305_dl_cmd_t &c = cmds[i];
+        if ((c.x0 <= tx1) && (c.x1 >= tx0) && (c.y0 <= ty1) && (c.y1 >= ty0)) {
+            visible[n++] = i;
+        }
+    }
+    
+    uint32_t hash = 2166136261UL;
+    if (!covered) {
+        hash = hashWord(hash, _dl->background);
+    }
+    
+    count = 0;
+    for (uint16_t a = 0; a < n; a++) {
+        const st7305_dl_cmd_t &c = cmds[visible[a]];
+        int16_t x0 = (c.x0 > tx0) ? c.x0 : tx0;
+        int16_t y0 = (c.y0 > ty0) ? c.y0 : ty0;
+        int16_t x1 = (c.x1 < tx1) ? c.x1 : tx1;
+        int16_t y1 = (c.y1 < ty1) ? c.y1 : ty1;
+        
+        bool hidden = false;
+        for (uint16_t b = a + 1; b < n; b++) {
+            const st7305_dl_cmd_t &o = cmds[visible[b]];
+            if ((o.flags & ST7305_DL_OPAQUE) &&
+                (o.x0 <= x0) && (o.y0 <= y0) && (o.x1 >= x1) && (o.y1 >= y1)) {
+                hidden = true;
+                break;
+            }
+        }
+        if (hidden) {
+            continue;
+        }
+        visible[count++] = visible[a];
+        
+        hash = hashWord(hash, ((uint32_t)c.scaleY << 24) | ((uint32_t)c.scaleX << 16) |
+                              ((uint32_t)c.op << 8) | c.flags);
+        hash = hashWord(hash, ((uint32_t)(uint16_t)x0 << 16) | (uint16_t)y0);
+        hash = hashWord(hash, ((uint32_t)(uint16_t)x1 << 16) | (uint16_t)y1);
+        if (c.op == ST7305_DL_POLY) {  // Vertices, not their pool offset
+            const int32_t *v = _dl->vertices + c.p[0] * 2;
+            for (int16_t i = 0; i < c.p[1] * 2; i++) {
+                hash = hashWord(hash, (uint32_t)v[i]);
+            }
+        } else {
+            hash = hashWord(hash, ((uint32_t)(uint16_t)c.p[0] << 16) | (uint16_t)c.p[1]);
+            hash = hashWord(hash, ((uint32_t)(uint16_t)c.p[2] << 16) | (uint16_t)c.p[3]);
+            hash = hashWord(hash, ((uint32_t)(uint16_t)c.p[4] << 16) | (uint16_t)c.p[5]);
+            hash = hashWord(hash, (uint32_t)(uintptr_t)c.data);
+            hash = hashWord(hash, (uint32_t)(uintptr_t)c.replay);
+        }
+    }
+    return hash ? hash : 1;
+}
+
+/**
+ * Replay Command - Rasterize one recorded command
+ * 
+ * The clip is set to the given bounds (the command's recorded bounds,
+ * possibly narrowed to a tile) with the origin at (0,0); since the
+ * bounds already include the clip that was active when recording, the
+ * same pixels are produced.
+ */
+void ST7305_Mono::replayCommand(const st7305_dl_cmd_t &cmd,
+                                int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    _clipX0 = x0;
+    _clipY0 = y0;
+    _clipX1 = x1;
+    _clipY1 = y1;
+    _originX = 0;
+    _originY = 0;
+    
+    uint16_t color = (cmd.flags & ST7305_DL_COLOR) ? 1 : 0;
+    switch (cmd.op) {
+        case ST7305_DL_PIXEL:
+            drawPixel(x0, y0, color);
+            break;
+        case ST7305_DL_RECT:
+            fillRectAbsolute(x0, y0, x1, y1, color);
+            break;
+        case ST7305_DL_LINE:
+            writeLineAbsolute((int32_t)cmd.p[0] + cmd.p[4], (int32_t)cmd.p[1] + cmd.p[5],
+                              (int32_t)cmd.p[2] + cmd.p[4], (int32_t)cmd.p[3] + cmd.p[5], color);
+            break;
+        case ST7305_DL_POLY: {
+            const int32_t *v = _dl->vertices + cmd.p[0] * 2;
+            fillPolygonFixed(v, v + cmd.p[1], cmd.p[1], color);
+            break;
+        }
+        case ST7305_DL_BITMAP:
+            if ((cmd.scaleX == 1) && (cmd.scaleY == 1)) {
+                blitBitmap(cmd.p[0], cmd.p[1], (const uint8_t*)cmd.data, cmd.p[2], cmd.p[3], color,
+                           (cmd.flags & ST7305_DL_BG) ? 1 : 0, (cmd.flags & ST7305_DL_OPAQUE) != 0);
+            } else {
+                blitScaled(cmd.p[0], cmd.p[1], (const uint8_t*)cmd.data, (int32_t)((cmd.p[2] + 7) / 8) * 8,
+                           cmd.p[2], cmd.p[3], cmd.scaleX, cmd.scaleY, color,
+                           (cmd.flags & ST7305_DL_BG) ? 1 : 0, (cmd.flags & ST7305_DL_OPAQUE) != 0, false);
+            }
+            break;
+        case ST7305_DL_PACKED:
+            drawPackedScaled(cmd.p[0], cmd.p[1], (const uint8_t*)cmd.data, cmd.p[2], cmd.p[3],
+                             cmd.scaleX, cmd.scaleY);
+            break;
+        case ST7305_DL_CHAR: {
+            // Two distinct colors make drawChar() paint the background cell
+            uint16_t bg = color;
+            if (cmd.flags & ST7305_DL_HAS_BG) {
+                bg = (cmd.flags & ST7305_DL_BG) ? (color ? 2 : 1) : 0;
+            }
+            GFXfont *font = gfxFont;
+            gfxFont = (GFXfont*)cmd.data;
+            drawChar(cmd.p[0], cmd.p[1], (uint8_t)cmd.p[2], color, bg,
+                     cmd.p[3] & 0xFF, cmd.p[3] >> 8);
+            gfxFont = font;
+            break;
+        }
+        case ST7305_DL_DEFERRED:
+            cmd.replay(*this, cmd.data, cmd.p[0], cmd.p[1]);
+            break;
+        case ST7305_DL_CIRCLE:
+            if (cmd.flags & ST7305_DL_FILL) {
+                Adafruit_GFX::fillCircle(cmd.p[0], cmd.p[1], cmd.p[2], color);
+            } else {
+                Adafruit_GFX::drawCircle(cmd.p[0], cmd.p[1], cmd.p[2], color);
+            }
+            break;
+        case ST7305_DL_ROUNDRECT:
+            if (cmd.flags & ST7305_DL_FILL) {
+                Adafruit_GFX::fillRoundRect(cmd.p[0], cmd.p[1], cmd.p[2], cmd.p[3], cmd.p[4], color);
+            } else {
+                Adafruit_GFX::drawRoundRect(cmd.p[0], cmd.p[1], cmd.p[2], cmd.p[3], cmd.p[4], color);
+            }
+            break;
+        case ST7305_DL_TRIANGLE:
+            if (cmd.flags & ST7305_DL_FILL) {
+                Adafruit_GFX::fillTriangle(cmd.p[0], cmd.p[1], cmd.p[2], cmd.p[3], cmd.p[4], cmd.p[5], color);
+            } else {
+                Adafruit_GFX::drawTriangle(cmd.p[0], cmd.p[1], cmd.p[2], cmd.p[3], cmd.p[4], cmd.p[5], color);
+            }
+            break;
+    }
+}
+
+/**
+ * Tile Rect - Inclusive pixel bounds of a tile (clamped to the panel)
+ */
+void ST7305_Mono::tileRect(uint16_t tile, int16_t &x0, int16_t &y0, int16_t &x1, int16_t &y1) {
+    x0 = (tile % ST7305_TILES_X) * ST7305_TILE_WIDTH;
+    y0 = (tile / ST7305_TILES_X) * ST7305_TILE_HEIGHT;
+    x1 = x0 + ST7305_TILE_WIDTH - 1;
+    y1 = y0 + ST7305_TILE_HEIGHT - 1;
+    if (x1 > ST7305_WIDTH - 1) x1 = ST7305_WIDTH - 1;
+    if (y1 > ST7305_HEIGHT - 1) y1 = ST7305_HEIGHT - 1;
+}
+
+/**
+ * Clear Display - Fill frame buffer with black
+ * 
+ * Sets all buffer bytes to 0x00 (black pixels).
+ * Call display() afterwards to update the screen.
+ */
+void ST7305_Mono::clearDisplay() {
+    if (_dlMode == ST7305_DL_RECORD) {  // Restart the frame on black
+        fill(0x00);
+        return;
+    }
+    memset(buffer, 0x00, ST7305_BUFFER_SIZE);  // Clear to black (0x00)
+    markDirty(0, 0, ST7305_WIDTH - 1, ST7305_HEIGHT - 1);
+}
+
+/**
+ * Fill - Fill frame buffer with specified byte value
+ * 
+ * Writes the whole buffer regardless of the active clip.
+ * 
+ * Useful for:
+ * - 0x00: All black
+ * - 0xFF: All white
+ * - 0xAA/0x55: Checkerboard patterns
+ * 
+ * @param data Byte value to fill buffer with
+ */
+void ST7305_Mono::fill(uint8_t data) {
+    if (_dlMode == ST7305_DL_RECORD) {  // Everything so far is covered
+        _dl->count = 0;
+        _dl->vertexCount = 0;
+        _dl->background = data;
+        return;
+    }
+    memset(buffer, data, ST7305_BUFFER_SIZE);
+    markDirty(0, 0, ST7305_WIDTH - 1, ST7305_HEIGHT - 1);
+}
+
+/**
+ * Set Buffer - Redirect drawing to an external frame buffer
+ * 
+ * @param frame ST7305_BUFFER_SIZE bytes, or nullptr for the own buffer
+ */
+void ST7305_Mono::setBuffer(uint8_t *frame) {
+    buffer = frame ? frame : _ownBuffer;
+}
+
+/**
+ * Invert Display - Hardware pixel inversion
+ * 
+ * Inverts all pixels on the display:
+ * - Black becomes white
+ * - White becomes black
+ * 
+ * This is a hardware feature and doesn't modify the frame buffer.
+ * 
+ * @param invert true to invert, false for normal display
+ */
+void ST7305_Mono::invertDisplay(bool invert) {
+    sendCommand(invert ? ST7305_INVON : ST7305_INVOFF);
+}
+
+/**
+ * Set Contrast - Adjust display contrast (placeholder)
+ * 
+ * ST7305 doesn't have a simple contrast command.
+ * Contrast adjustment requires modifying voltage/gamma settings.
+ * Implement this by adjusting specific voltage commands in init sequence.
+ * 
+ * @param contrast Contrast value (not currently used)
+ */
+void ST7305_Mono::setContrast(uint8_t contrast) {
+    // ST7305 doesn't have a simple contrast command
+    // Contrast would need to be adjusted through gamma/voltage settings
+    // This is a placeholder - implement if needed with specific voltage adjustments
+}
+
+/**
+ * Set High Power Mode - Enter high power mode
+ * 
+ * Sends 0xB9 command for high power operation.
+ */
+void ST7305_Mono::setHighPowerMode() {
+    sendCommand(ST7305_HPM);
+    _lowPower = false;
+}
+
+/**
+ * Set Low Power Mode - Enter low power mode
+ * 
+ * Sends 0xBA command for low power operation.
+ */
+void ST7305_Mono::setLowPowerMode() {
+    sendCommand(ST7305_LPM);
+    _lowPower = true;
+}
+
+/**
+ * Get Frame Period - Refresh period from FRCTRL and the power mode
+ * 
+ * High power: 16 Hz << bits 5:4 (62,500 us at 16 Hz).
+ * Low power:  0.25 Hz << bits 2:0, at most 8 Hz (4 s at 0.25 Hz).
+ * 
+ * @return Microseconds per panel frame
+ */
+uint32_t ST7305_Mono::getFramePeriodMicros() const {
+    return framePeriodMicros(_lowPower);
+}
+
+/**
+ * Frame Period - Refresh period of either power mode
+ */
+uint32_t ST7305_Mono::framePeriodMicros(bool lowPower) const {
+    if (lowPower) {
+        uint8_t rate = _frameRate & 0x07;
+        return 4000000UL >> ((rate > 5) ? 5 : rate);
+    }
+    return 62500UL >> ((_frameRate >> 4) & 0x03);
+}
+
+// ===== SPI Clock Tuning =====
+
+/**
+ * Set SPI Clocks - Rebuild the transaction settings of both phases
+ * 
+ * @param commandHz Clock for commands and parameters
+ * @param dataHz    Clock for pixel data
+ */
+void ST7305_Mono::setSpiClocks(uint32_t commandHz, uint32_t dataHz) {
+    _spiConfig.commandHz = commandHz;
+    _spiConfig.dataHz = dataHz;
+    _commandSettings = SPISettings(commandHz, MSBFIRST, SPI_MODE0);
+    _dataSettings = SPISettings(dataHz, MSBFIRST, SPI_MODE0);
+}
+
+/**
+ * Set SPI Chunk Size - Bytes per SPI.transfer() of pixel data
+ * 
+ * @param bytes Chunk size, clamped to 1 .. ST7305_SPI_CHUNK_MAX
+ */
+void ST7305_Mono::setSpiChunkSize(uint16_t bytes) {
+    if (bytes < 1) {
+        bytes = 1;
+    }
+    _spiConfig.chunkBytes = (bytes > ST7305_SPI_CHUNK_MAX) ? ST7305_SPI_CHUNK_MAX : bytes;
+}
+
+/**
+ * Set SPI Config - Restore a stored configuration
+ */
+void ST7305_Mono::setSpiConfig(const st7305_spi_config_t &config) {
+    setSpiClocks(config.commandHz, config.dataHz);
+    setSpiChunkSize(config.chunkBytes);
+}
+
+/**
+ * Calibrate SPI - Pick the clocks and chunk size from measurements
+ * 
+ * Each clock is measured on its own with both phases at that clock, so
+ * check covers commands and data. The buffer is sent again with the
+ * chosen configuration at the end, which also repairs anything a
+ * failing clock left on the panel.
+ * 
+ * @param clocks  Candidate clocks in Hz
+ * @param count   Number of candidates (at most ST7305_CALIBRATE_MAX_CLOCKS used)
+ * @param check   Stability check, or nullptr for the ID readback
+ * @param context Passed to check
+ * @return Chosen configuration and measurements
+ */
+st7305_spi_calibration_t ST7305_Mono::calibrateSpi(const uint32_t *clocks, uint8_t count,
+                                                   st7305_spi_check_t check, void *context) {
+    static const uint16_t chunkSizes[] = { 16, 32, 64, 128, ST7305_SPI_CHUNK_MAX };
+    const uint8_t chunkCount = sizeof(chunkSizes) / sizeof(chunkSizes[0]);
+    
+    uint32_t rate[ST7305_CALIBRATE_MAX_CLOCKS];         // Best pixel bytes/s per clock
+    uint16_t chunk[ST7305_CALIBRATE_MAX_CLOCKS];        // Chunk size giving it
+    uint32_t windowMicros[ST7305_CALIBRATE_MAX_CLOCKS]; // Command phase time
+    bool passed[ST7305_CALIBRATE_MAX_CLOCKS];
+    
+    st7305_spi_calibration_t result;
+    memset(&result, 0, sizeof(result));
+    result.config = _spiConfig;
+    if (count > ST7305_CALIBRATE_MAX_CLOCKS) {
+        count = ST7305_CALIBRATE_MAX_CLOCKS;
+    }
+    
+    // Built-in check: the ID read at the current (trusted) clock
+    uint32_t id = 0;
+    if (!check) {
+        id = readDisplayId();
+        if (!id) {  // No readback, no evidence: keep the current clocks
+            result.rejected = count;
+            return result;
+        }
+        check = checkDisplayId;
+        context = &id;
+    }
+    
+    uint32_t bestRate = 0;
+    uint32_t bestWindow = UINT32_MAX;
+    for (uint8_t i = 0; i < count; i++) {
+        setSpiClocks(clocks[i], clocks[i]);
+        
+        // Data phase: one full frame per chunk size; within 2% the smaller chunk wins
+        rate[i] = 0;
+        chunk[i] = ST7305_SPI_CHUNK;
+        for (uint8_t c = 0; c < chunkCount; c++) {
+            setSpiChunkSize(chunkSizes[c]);
+            uint32_t bytes = _spiStats.dataBytes;
+            uint32_t start = micros();
+            display();
+            uint32_t elapsed = micros() - start;
+            bytes = _spiStats.dataBytes - bytes;
+            uint32_t bytesPerSecond = (uint32_t)((uint64_t)bytes * 1000000UL / (elapsed ? elapsed : 1));
+            if ((uint64_t)bytesPerSecond * 50 > (uint64_t)rate[i] * 51) {
+                rate[i] = bytesPerSecond;
+                chunk[i] = chunkSizes[c];
+            }
+            result.trials++;
+        }
+        
+        // Command phase: address windows only, no pixel data
+        uint32_t start = micros();
+        for (uint8_t w = 0; w < ST7305_CALIBRATE_WINDOWS; w++) {
+            setAddressWindow(0, 0, ST7305_WIDTH - 1, ST7305_HEIGHT - 1);
+        }
+        windowMicros[i] = micros() - start;
+        
+        passed[i] = !check || check(*this, context);
+        if (!passed[i]) {
+            result.rejected++;
+            continue;
+        }
+        if (rate[i] > bestRate) {
+            bestRate = rate[i];
+        }
+        if (windowMicros[i] < bestWindow) {
+            bestWindow = windowMicros[i];
+        }
+    }
+    
+    // Lowest passing clock within 2% (data) / 10% (commands) of the best
+    int16_t data = -1;
+    int16_t command = -1;
+    for (uint8_t i = 0; i < count; i++) {
+        if (!passed[i]) {
+            continue;
+        }
+        if (((uint64_t)rate[i] * 50 >= (uint64_t)bestRate * 49) &&
+            ((data < 0) || (clocks[i] < clocks[data]))) {
+            data = i;
+        }
+        if (((uint64_t)windowMicros[i] * 10 <= (uint64_t)bestWindow * 11) &&
+            ((command < 0) || (clocks[i] < clocks[command]))) {
+            command = i;
+        }
+    }
+    
+    if (data >= 0) {
+        result.config.commandHz = clocks[command];
+        result.config.dataHz = clocks[data];
+        result.config.chunkBytes = chunk[data];
+        result.bytesPerSecond = rate[data];
+    }
+    setSpiConfig(result.config);
+    display();
+    return result;
+}
+
+/**
+ * Read Display ID - RDDID with CS held low through the reply
+ * 
+ * The reply is one dummy clock, then the 24-bit ID (manufacturer,
+ * version, driver). Four bytes are clocked in and the ID taken from
+ * bits 30..7.
+ * 
+ * @return ID, or 0 if MISO read all zeros or all ones
+ */
+uint32_t ST7305_Mono::readDisplayId() {
+    waitReady();
+    if (_trace) {
+        _trace->command(ST7305_RDDID);
+    }
+    _spiStats.commands++;
+    _spiStats.transfers += 5;
+    dcLow();
+    csLow();
+    SPI.beginTransaction(_commandSettings);
+    SPI.transfer(ST7305_RDDID);
+    dcHigh();
+    uint32_t raw = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        raw = (raw << 8) | SPI.transfer(0x00);
+    }
+    SPI.endTransaction();
+    csHigh();
+    
+    uint32_t id = (raw >> 7) & 0xFFFFFF;
+    return ((id == 0) || (id == 0xFFFFFF)) ? 0 : id;
+}
+
+/**
+ * Check Display ID - The ID reads back unchanged at the current clock
+ * 
+ * @param display Display being calibrated
+ * @param context Pointer to the expected uint32_t ID
+ * @return true if the ID matches
+ */
+bool ST7305_Mono::checkDisplayId(ST7305_Mono &display, void *context) {
+    uint32_t expected = *(const uint32_t *)context;
+    return (expected != 0) && (display.readDisplayId() == expected);
+}
+
+// ===== Frame Budget =====
+
+/**
+ * Set Frame Budget - New present() policy, full byte credit
+ * 
+ * @param budget Latency, traffic / power limits and power mode switching
+ */
+void ST7305_Mono::setFrameBudget(const st7305_frame_budget_t &budget) {
+    _budget = budget;
+    _budgetCredit = ST7305_BUFFER_SIZE + ST7305_WINDOW_OVERHEAD;
+    _presentTime = millis();
+    _sendTime = _presentTime;
+    _pending = false;
+}
+
+/**
+ * Present - Decide what to do with the dirty window and do it
+ * 
+ * Order of checks: nothing dirty (idle, maybe drop to LPM), then the
+ * latency deadline, which overrides both reasons to wait: the panel
+ * not having shown the previous send yet, and the byte credit.
+ * 
+ * @return Decision and estimated cost
+ */
+st7305_frame_report_t ST7305_Mono::present() {
+    st7305_frame_report_t &r = _frameReport;
+    memset(&r, 0, sizeof(r));
+    uint32_t now = millis();
+    uint32_t interval = now - _presentTime;
+    _presentTime = now;
+    
+    // Refill the byte credit, capped at one full frame
+    const int32_t fullCost = ST7305_BUFFER_SIZE + ST7305_WINDOW_OVERHEAD;
+    uint32_t rate = budgetRate();
+    int64_t credit = (rate == UINT32_MAX) ? fullCost
+                                          : _budgetCredit + (int64_t)interval * rate / 1000;
+    _budgetCredit = (credit > fullCost) ? fullCost : (int32_t)credit;
+    
+    st7305_rect_t dirty = getDirtyRect();
+    if ((dirty.w == 0) || isRecording()) {
+        _pending = false;
+        r.action = ST7305_FRAME_IDLE;
+        if (_budget.autoPower && !_lowPower && (now - _sendTime >= _budget.idleMs)) {
+            setLowPowerMode();
+            r.modeChanged = true;
+            r.bytes = 1;
+        }
+    } else {
+        if (!_pending) {
+            _pending = true;
+            _pendingSince = now;
+        }
+        r.pendingMs = now - _pendingSince;
+        
+        uint32_t cost = windowCost(dirty.x, dirty.y, dirty.x + dirty.w - 1, dirty.y + dirty.h - 1);
+        bool full = (cost * 100 >= (uint32_t)fullCost * ST7305_FULL_FRAME_PERCENT);
+        if (full) {
+            cost = fullCost;
+        }
+        _pendingCost = cost;
+        
+        bool low = _budget.autoPower ? lowPowerFits() : _lowPower;
+        bool hold = false;
+        if (r.pendingMs < _budget.latencyMs) {
+            uint32_t period = framePeriodMicros(low);
+            uint32_t since = micros() - _sendMicros;
+            if (_sent && (since < period) &&
+                ((uint64_t)r.pendingMs * 1000 + (period - since) <= (uint64_t)_budget.latencyMs * 1000)) {
+                hold = true;  // Panel has not shown the last send yet: coalesce
+            }
+            if ((rate != UINT32_MAX) && ((int32_t)cost > _budgetCredit)) {
+                hold = true;
+            }
+        }
+        
+        if (hold) {
+            r.action = ST7305_FRAME_DEFERRED;
+            r.pendingBytes = cost;
+        } else {
+            if (_budget.autoPower && (low != _lowPower)) {
+                if (low) {
+                    setLowPowerMode();
+                } else {
+                    setHighPowerMode();
+                }
+                r.modeChanged = true;
+                r.bytes = 1;
+            }
+            r.overBudget = (rate != UINT32_MAX) && ((int32_t)cost > _budgetCredit);
+            
+            uint32_t start = micros();
+            if (full) {
+                display();
+            } else {
+                displayDirty();
+            }
+            _sendMicros = micros();
+            r.busMicros = _sendMicros - start;
+            r.action = full ? ST7305_FRAME_FULL : ST7305_FRAME_PARTIAL;
+            r.bytes += cost;
+            _budgetCredit -= cost;
+            _sendTime = now;
+            _pending = false;
+            _sent = true;
+        }
+    }
+    
+    r.lowPower = _lowPower;
+    uint32_t panel = _lowPower ? _energy.lowPowerMicrowatts : _energy.highPowerMicrowatts;
+    r.energyMicrojoules = (uint32_t)(((uint64_t)r.bytes * _energy.nanojoulesPerByte) / 1000 +
+                                     ((uint64_t)panel * interval) / 1000);
+    return r;
+}
+
+/**
+ * Get Present Delay - Time until present() next changes something
+ * 
+ * @return Milliseconds (0 = now, UINT32_MAX = nothing scheduled)
+ */
+uint32_t ST7305_Mono::getPresentDelay() const {
+    uint32_t now = millis();
+    if (!_pending) {
+        if (getDirtyRect().w > 0) {
+            return 0;  // Not seen by present() yet
+        }
+        if (_budget.autoPower && !_lowPower) {
+            uint32_t idle = now - _sendTime;
+            return (idle >= _budget.idleMs) ? 0 : _budget.idleMs - idle;
+        }
+        return UINT32_MAX;
+    }
+    
+    uint32_t age = now - _pendingSince;
+    uint32_t wait = (age >= _budget.latencyMs) ? 0 : _budget.latencyMs - age;
+    
+    // Earliest time both reasons to hold back are gone
+    uint32_t ready = 0;
+    uint32_t since = micros() - _sendMicros;
+    uint32_t period = framePeriodMicros(_budget.autoPower ? lowPowerFits() : _lowPower);
+    if (_sent && (since < period)) {
+        ready = (period - since + 999) / 1000;
+    }
+    uint32_t rate = budgetRate();
+    if ((rate != UINT32_MAX) && ((int32_t)_pendingCost > _budgetCredit)) {
+        uint32_t refill = (rate == 0) ? UINT32_MAX
+                                      : (uint32_t)(((uint64_t)(_pendingCost - _budgetCredit) * 1000 +
+                                                    rate - 1) / rate);
+        refill = (refill > now - _presentTime) ? refill - (now - _presentTime) : 0;
+        if (refill > ready) {
+            ready = refill;
+        }
+    }
+    return (ready < wait) ? ready : wait;
+}
+
+/**
+ * Budget Rate - Bytes per second present() may send on average
+ * 
+ * The smaller of bytesPerSecond and what the microwatt budget leaves
+ * after the panel's draw in the current power mode.
+ * 
+ * @return Bytes per second, UINT32_MAX without a limit
+ */
+uint32_t ST7305_Mono::budgetRate() const {
+    uint32_t rate = UINT32_MAX;
+    if (_budget.bytesPerSecond) {
+        rate = _budget.bytesPerSecond;
+    }
+    if (_budget.microwatts && _energy.nanojoulesPerByte) {
+        uint32_t panel = _lowPower ? _energy.lowPowerMicrowatts : _energy.highPowerMicrowatts;
+        uint32_t spare = (_budget.microwatts > panel) ? _budget.microwatts - panel : 0;
+        uint64_t bytes = (uint64_t)spare * 1000 / _energy.nanojoulesPerByte;  // uW = 1000 nJ/s
+        if (bytes < rate) {
+            rate = (uint32_t)bytes;
+        }
+    }
+    return rate;
+}
+
+/**
+ * Low Power Fits - A change may wait one LPM frame period
+ */
+bool ST7305_Mono::lowPowerFits() const {
+    return (uint64_t)_budget.latencyMs * 1000 >= framePeriodMicros(true);
+}
+
+/**
+ * Window Cost - Bus bytes of one windowed RAMWR
+ * 
+ * The region is priced on the controller's 12 x 2 grid, plus the
+ * address window setup.
+ * 
+ * @param x0, y0, x1, y1 Region (absolute, inclusive, on the panel)
+ * @return Bytes including ST7305_WINDOW_OVERHEAD
+ */
+uint32_t ST7305_Mono::windowCost(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    int16_t cols = x1 / ST7305_PIXELS_PER_COL - x0 / ST7305_PIXELS_PER_COL + 1;
+    int16_t pairs = y1 / 2 - y0 / 2 + 1;
+    return (uint32_t)cols * ST7305_BYTES_PER_COL * pairs + ST7305_WINDOW_OVERHEAD;
+}
+
+// ===== Flush-Time Transforms =====
+
+/**
+ * Pattern Bytes - Apply a pattern operation to a run of packed bytes
+ * 
+ * @param bytes Bytes in the bounce buffer
+ * @param count Number of bytes
+ * @param op    ST7305_TRANSFORM_INVERT / _SET / _CLEAR
+ * @param mask  Bits affected in every byte (pattern and edge masks)
+ */
+static void patternBytes(uint8_t *bytes, int32_t count, uint8_t op, uint8_t mask) {
+    switch (op) {
+        case ST7305_TRANSFORM_INVERT:
+            for (int32_t i = 0; i < count; i++) bytes[i] ^= mask;
+            break;
+        case ST7305_TRANSFORM_SET:
+            for (int32_t i = 0; i < count; i++) bytes[i] |= mask;
+            break;
+        case ST7305_TRANSFORM_CLEAR:
+            for (int32_t i = 0; i < count; i++) bytes[i] &= ~mask;
+            break;
+    }
+}
+
+/**
+ * Mirror Byte - Gather one packed byte of a mirrored region
+ * 
+ * Regions whose mirrored axis is on the byte grid read a single source
+ * byte and reorder it: the four pixel columns for MIRROR_X, the two
+ * rows for MIRROR_Y. Other regions are gathered pixel by pixel.
+ * 
+ * @param src  Source frame
+ * @param t    Mirror transform
+ * @param col  Byte column (x / 4)
+ * @param pair Row-pair (y / 2)
+ * @param mask Pixels of the byte inside the region
+ * @return Mirrored pixels (bits outside mask are 0)
+ */
+static uint8_t mirrorByte(const uint8_t *src, const st7305_transform_t &t, int16_t col, int16_t pair,
+                          uint8_t mask) {
+    if (t.op == ST7305_TRANSFORM_MIRROR_X) {
+        if (((t.x0 & 3) == 0) && ((t.x1 & 3) == 3)) {
+            uint8_t v = src[(uint32_t)pair * ST7305_BYTES_PER_ROW + (t.x0 / 4 + t.x1 / 4 - col)];
+            v = ((v & 0xC0) >> 6) | ((v & 0x30) >> 2) | ((v & 0x0C) << 2) | ((v & 0x03) << 6);
+            return v & mask;
+        }
+    } else if (((t.y0 & 1) == 0) && ((t.y1 & 1) == 1)) {
+        uint8_t v = src[(uint32_t)(t.y0 / 2 + t.y1 / 2 - pair) * ST7305_BYTES_PER_ROW + col];
+        v = ((v & ST7305_ROW_MASK_EVEN) >> 1) | ((v & ST7305_ROW_MASK_ODD) << 1);
+        return v & mask;
+    }
+    
+    uint8_t v = 0;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        uint8_t m = 0x80 >> bit;
+        if (!(mask & m)) {
+            continue;
+        }
+        int16_t x = col * 4 + bit / 2;
+        int16_t y = pair * 2 + (bit & 1);
+        if (t.op == ST7305_TRANSFORM_MIRROR_X) {
+            x = t.x0 + t.x1 - x;
+        } else {
+            y = t.y0 + t.y1 - y;
+        }
+        uint8_t b = src[(uint32_t)(y / 2) * ST7305_BYTES_PER_ROW + x / 4];
+        if (b & (0x80 >> ((x & 3) * 2 + (y & 1)))) {
+            v |= m;
+        }
+    }
+    return v;
+}
+
+/**
+ * Apply Transforms - Transform a chunk of frame bytes in the bounce buffer
+ * 
+ * The chunk may end mid-row or span several row-pairs (full-width
+ * windows). Each transform is clipped to it: rows outside the region
+ * drop out through the row mask of the first and last row-pair, columns
+ * through the edge masks of the first and last byte; the bytes between
+ * take the plain pattern.
+ * 
+ * @param src    Frame the chunk was copied from
+ * @param chunk  Bytes to transform
+ * @param offset Frame index of chunk[0]
+ * @param len    Number of bytes
+ */
+void ST7305_Mono::applyTransforms(const uint8_t *src, uint8_t *chunk, uint32_t offset, uint32_t len) {
+    int32_t first = offset;
+    int32_t last = offset + len - 1;
+    
+    for (uint8_t pass = 0; pass < 2; pass++) {  // Mirrors read src, so they go first
+        for (uint8_t i = 0; i < ST7305_MAX_TRANSFORMS; i++) {
+            const st7305_transform_t &t = _transforms[i];
+            bool mirror = (t.op == ST7305_TRANSFORM_MIRROR_X) || (t.op == ST7305_TRANSFORM_MIRROR_Y);
+            if (!t.enabled || (mirror != (pass == 0))) {
+                continue;
+            }
+            int16_t pair0 = t.y0 / 2;
+            int16_t pair1 = t.y1 / 2;
+            if (pair0 < first / ST7305_BYTES_PER_ROW) pair0 = first / ST7305_BYTES_PER_ROW;
+            if (pair1 > last / ST7305_BYTES_PER_ROW) pair1 = last / ST7305_BYTES_PER_ROW;
+            int16_t col0 = t.x0 / 4;
+            int16_t col1 = t.x1 / 4;
+            uint8_t leftMask = 0xFF >> ((t.x0 & 3) * 2);
+            uint8_t rightMask = 0xFF << ((3 - (t.x1 & 3)) * 2);
+            
+            for (int16_t pair = pair0; pair <= pair1; pair++) {
+                uint8_t rowMask = ST7305_ROW_MASK_BOTH;
+                if (pair * 2 < t.y0) rowMask &= ST7305_ROW_MASK_ODD;
+                if (pair * 2 + 1 > t.y1) rowMask &= ST7305_ROW_MASK_EVEN;
+                int32_t b0 = (int32_t)pair * ST7305_BYTES_PER_ROW + col0;
+                int32_t b1 = (int32_t)pair * ST7305_BYTES_PER_ROW + col1;
+                int32_t s = (b0 > first) ? b0 : first;
+                int32_t e = (b1 < last) ? b1 : last;
+                if (s > e) {
+                    continue;
+                }
+                
+                if (mirror) {
+                    for (int32_t b = s; b <= e; b++) {
+                        uint8_t mask = rowMask;
+                        if (b == b0) mask &= leftMask;
+                        if (b == b1) mask &= rightMask;
+                        uint8_t &c = chunk[b - first];
+                        c = (c & ~mask) | mirrorByte(src, t, col0 + (b - b0), pair, mask);
+                    }
+                    continue;
+                }
+                
+                uint8_t mask = rowMask & t.pattern;
+                if (s == b0) {
+                    patternBytes(&chunk[s - first], 1, t.op, mask & leftMask & ((b0 == b1) ? rightMask : 0xFF));
+                    s++;
+                }
+                if ((e == b1) && (e >= s)) {
+                    patternBytes(&chunk[e - first], 1, t.op, mask & rightMask);
+                    e--;
+                }
+                patternBytes(&chunk[s - first], e - s + 1, t.op, mask);
+            }
+        }
+    }
+}
+
+/**
+ * Cover Mirrors - Damage rectangle plus its reflection in enabled mirrors
+ * 
+ * @param damage Changed region (absolute pixels)
+ * @return Region to send, w = h = 0 for an empty one
+ */
+st7305_rect_t ST7305_Mono::coverMirrors(const st7305_rect_t &damage) const {
+    st7305_rect_t r = damage;
+    if ((r.w <= 0) || (r.h <= 0)) {
+        r.w = 0;
+        r.h = 0;
+        return r;
+    }
+    int16_t x0 = r.x, y0 = r.y;
+    int16_t x1 = (int16_t)(r.x + r.w - 1), y1 = (int16_t)(r.y + r.h - 1);
+    coverMirrors(x0, y0, x1, y1);
+    r.x = x0;
+    r.y = y0;
+    r.w = x1 - x0 + 1;
+    r.h = y1 - y0 + 1;
+    return r;
+}
+
+/**
+ * Cover Mirrors - Widen damage by the mirror image of what it changes
+ * 
+ * Inside a mirrored region a buffer pixel shows up at its reflection,
+ * so damage over part of the region also damages the reflected part.
+ * Repeats until no mirror widens the rectangle any further. Applied
+ * where damage is read (getDirtyRect(), changed tile runs), not to the
+ * windows being sent, so fixed-size bands and slices stay as asked.
+ * 
+ * @param x0, y0, x1, y1 Damage (absolute pixels, inclusive), updated in place
+ */
+void ST7305_Mono::coverMirrors(int16_t &x0, int16_t &y0, int16_t &x1, int16_t &y1) const {
+    bool grown = true;
+    while (grown) {
+        grown = false;
+        for (uint8_t i = 0; i < ST7305_MAX_TRANSFORMS; i++) {
+            const st7305_transform_t &t = _transforms[i];
+            if (!t.enabled || ((t.op != ST7305_TRANSFORM_MIRROR_X) && (t.op != ST7305_TRANSFORM_MIRROR_Y))) {
+                continue;
+            }
+            int32_t ix0 = (x0 > t.x0) ? x0 : t.x0;
+            int32_t iy0 = (y0 > t.y0) ? y0 : t.y0;
+            int32_t ix1 = (x1 < t.x1) ? x1 : t.x1;
+            int32_t iy1 = (y1 < t.y1) ? y1 : t.y1;
+            if ((ix0 > ix1) || (iy0 > iy1)) {
+                continue;
+            }
+            if (t.op == ST7305_TRANSFORM_MIRROR_X) {
+                int32_t m0 = t.x0 + t.x1 - ix1;
+                int32_t m1 = t.x0 + t.x1 - ix0;
+                if (m0 < x0) { x0 = m0; grown = true; }
+                if (m1 > x1) { x1 = m1; grown = true; }
+            } else {
+                int32_t m0 = t.y0 + t.y1 - iy1;
+                int32_t m1 = t.y0 + t.y1 - iy0;
+                if (m0 < y0) { y0 = m0; grown = true; }
+                if (m1 > y1) { y1 = m1; grown = true; }
+            }
+        }
+    }
+}
+
+/**
+ * Add Transform - Take a free slot
+ * 
+ * @param x, y, w, h Region (absolute pixels)
+ * @param op         ST7305_TRANSFORM_*
+ * @param pattern    Pixels of each packed byte affected
+ * @param flush      Resend the region now (false: mark it dirty)
+ * @return Slot id, -1 if none is free or the region is off-screen
+ */
+int8_t ST7305_Mono::addTransform(int16_t x, int16_t y, int16_t w, int16_t h, st7305_transform_op_t op,
+                                 uint8_t pattern, bool flush) {
+    for (uint8_t i = 0; i < ST7305_MAX_TRANSFORMS; i++) {
+        if (_transforms[i].used) {
+            continue;
+        }
+        st7305_transform_t &t = _transforms[i];
+        t.op = op;
+        t.pattern = pattern;
+        t.enabled = false;
+        t.used = true;
+        if (!moveTransform(i, x, y, w, h, false)) {
+            t.used = false;
+            return -1;
+        }
+        enableTransform(i, true, flush);
+        return i;
+    }
+    return -1;
+}
+
+/**
+ * Move Transform - New region, resend what changed
+ * 
+ * The old and new regions go out as one window if it costs no more
+ * bytes than two.
+ * 
+ * @param id         Slot from addTransform()
+ * @param x, y, w, h New region (absolute pixels)
+ * @param flush      Resend now (false: mark dirty)
+ * @return false for an unused slot or an off-screen region
+ */
+bool ST7305_Mono::moveTransform(int8_t id, int16_t x, int16_t y, int16_t w, int16_t h, bool flush) {
+    if ((id < 0) || (id >= ST7305_MAX_TRANSFORMS) || !_transforms[id].used) {
+        return false;
+    }
+    int32_t x0 = (x < 0) ? 0 : x;
+    int32_t y0 = (y < 0) ? 0 : y;
+    int32_t x1 = (int32_t)x + w - 1;
+    int32_t y1 = (int32_t)y + h - 1;
+    if (x1 > ST7305_WIDTH - 1) x1 = ST7305_WIDTH - 1;
+    if (y1 > ST7305_HEIGHT - 1) y1 = ST7305_HEIGHT - 1;
+    if ((x0 > x1) || (y0 > y1)) {
+        return false;
+    }
+    
+    st7305_transform_t &t = _transforms[id];
+    st7305_transform_t old = t;
+    t.x0 = x0;
+    t.y0 = y0;
+    t.x1 = x1;
+    t.y1 = y1;
+    if (!t.enabled) {
+        return true;
+    }
+    
+    int16_t ux0 = (old.x0 < t.x0) ? old.x0 : t.x0;
+    int16_t uy0 = (old.y0 < t.y0) ? old.y0 : t.y0;
+    int16_t ux1 = (old.x1 > t.x1) ? old.x1 : t.x1;
+    int16_t uy1 = (old.y1 > t.y1) ? old.y1 : t.y1;
+    if (windowCost(ux0, uy0, ux1, uy1) <=
+        windowCost(old.x0, old.y0, old.x1, old.y1) + windowCost(t.x0, t.y0, t.x1, t.y1)) {
+        refreshArea(ux0, uy0, ux1, uy1, flush);
+    } else {
+        refreshArea(old.x0, old.y0, old.x1, old.y1, flush);
+        refreshArea(t.x0, t.y0, t.x1, t.y1, flush);
+    }
+    return true;
+}
+
+/**
+ * Enable Transform - Switch a slot on or off
+ * 
+ * @param id      Slot from addTransform()
+ * @param enabled New state (no resend if unchanged)
+ * @param flush   Resend the region now (false: mark it dirty)
+ * @return false for an unused slot
+ */
+bool ST7305_Mono::enableTransform(int8_t id, bool enabled, bool flush) {
+    if ((id < 0) || (id >= ST7305_MAX_TRANSFORMS) || !_transforms[id].used) {
+        return false;
+    }
+    st7305_transform_t &t = _transforms[id];
+    if (t.enabled != enabled) {
+        t.enabled = enabled;
+        if (enabled) {
+            _transformsEnabled++;
+        } else {
+            _transformsEnabled--;
+        }
+        refreshArea(t.x0, t.y0, t.x1, t.y1, flush);
+    }
+    return true;
+}
+
+/**
+ * Remove Transform - Disable a slot and free it
+ */
+bool ST7305_Mono::removeTransform(int8_t id, bool flush) {
+    if (!enableTransform(id, false, flush)) {
+        return false;
+    }
+    _transforms[id].used = false;
+    return true;
+}
+
+/**
+ * Clear Transforms - Free every slot
+ */
+void ST7305_Mono::clearTransforms(bool flush) {
+    for (uint8_t i = 0; i < ST7305_MAX_TRANSFORMS; i++) {
+        removeTransform(i, flush);
+    }
+}
+
+/**
+ * Get Transform - Read a slot
+ * 
+ * @return Slot, nullptr if id is out of range or unused
+ */
+const st7305_transform_t *ST7305_Mono::getTransform(int8_t id) const {
+    if ((id < 0) || (id >= ST7305_MAX_TRANSFORMS) || !_transforms[id].used) {
+        return nullptr;
+    }
+    return &_transforms[id];
+}
+
+/**
+ * Refresh Area - Resend a region from the frame buffer, or mark it dirty
+ */
+void ST7305_Mono::refreshArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1, bool flush) {
+    if (flush) {
+        sendWindow(buffer, x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+    } else {
+        markDirty(x0, y0, x1, y1);
+    }
+}
+
+/**
+ * Set Address Window - Define rectangular update region
+ * 
+ * Sets the active RAM window for partial updates. Subsequent memory
+ * writes fill this window row-pair by row-pair.
+ * 
+ * The ST7305 addresses columns in units of 12 pixels (3 buffer bytes,
+ * starting at 0x12) and rows in row-pairs, with single-byte parameters,
+ * so pixel coordinates are snapped outwards to that grid.
+ * 
+ * @param x0 Start column (0-299)
+ * @param y0 Start row (0-399)
+ * @param x1 End column (0-299)
+ * @param y1 End row (0-399)
+ */
+void ST7305_Mono::setAddressWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    // Column address set
+    sendCommand(ST7305_CASET);
+    sendData(ST7305_COL_ADDR_START + x0 / ST7305_PIXELS_PER_COL);
+    sendData(ST7305_COL_ADDR_START + x1 / ST7305_PIXELS_PER_COL);
+    
+    // Row address set
+    sendCommand(ST7305_RASET);
+    sendData(ST7305_ROW_ADDR_START + y0 / 2);
+    sendData(ST7305_ROW_ADDR_START + y1 / 2);
+}
+
+// ===== Low-Level SPI Communication Functions =====
+
+/**
+ * Send Command - Send single command byte
+ * 
+ * Waits out a pending controller delay first (see waitReady()).
+ * 
+ * @param cmd Command byte to send
+ */
+void ST7305_Mono::sendCommand(uint8_t cmd) {
+    waitReady();
+    if (_trace) {
+        _trace->command(cmd);
+    }
+    _spiStats.commands++;
+    _spiStats.transfers++;
+    dcLow();
+    csLow();
+    SPI.beginTransaction(_commandSettings);
+    SPI.transfer(cmd);
+    SPI.endTransaction();
+    csHigh();
+}
+
+/**
+ * Send Data - Send single data byte
+ * 
+ * @param data Data byte to send
+ */
+void ST7305_Mono::sendData(uint8_t data) {
+    if (_trace) {
+        _trace->data(data);
+    }
+    _spiStats.dataBytes++;
+    _spiStats.transfers++;
+    dcHigh();
+    csLow();
+    SPI.beginTransaction(_commandSettings);
+    SPI.transfer(data);
+    SPI.endTransaction();
+    csHigh();
+}
+
+/**
+ * Send Data Batch - Send multiple data bytes efficiently
+ * 
+ * Transfers data in chunks in one transaction at the data clock; the
+ * source is not modified (see writeWindowData()).
+ * 
+ * @param data Pointer to data array
+ * @param size Number of bytes to send
+ */
+void ST7305_Mono::sendDataBatch(const uint8_t *data, uint32_t size) {
+    dcHigh();
+    csLow();
+    SPI.beginTransaction(_dataSettings);
+    writeWindowData(data, size);
     SPI.endTransaction();
     csHigh();
 }
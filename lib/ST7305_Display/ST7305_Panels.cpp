@@ -0,0 +1,143 @@
+/**
+ * ST7305_Panels.cpp
+ *
+ * Panel profile registry and encoded init sequences
+ *
+ * The sequences are defined here only, so they are stored in flash once
+ * however many files include the driver headers.
+ */
+
+#include "ST7305_Panels.h"
+
+// ============================================================================
+// Init Sequences
+// ============================================================================
+
+// Manufacturer settings for the TT420FSN21A (ST7305)
+static const uint8_t st7305_init_tt420fsn21a[] PROGMEM = {
+    26,                                                                   // Commands
+    0xD6, 2, 0x17, 0x02,                                                  // NVM Load Control
+    0xD1, 1, 0x01,                                                        // Booster Enable
+    0xC0, 2, 0x11, 0x04,                                                  // Gate Voltage Setting
+    0xC1, 4, 0x69, 0x69, 0x69, 0x69,                                      // VSHP Setting (4.8V)
+    0xC2, 4, 0x19, 0x19, 0x19, 0x19,                                      // VSLP Setting (0.98V)
+    0xC4, 4, 0x4B, 0x4B, 0x4B, 0x4B,                                      // VSHN Setting (-3.6V)
+    0xC5, 4, 0x19, 0x19, 0x19, 0x19,                                      // VSLN Setting (0.22V)
+    0xD8, 2, 0xA6, 0xE9,                                                  // OSC Setting
+    0xB2, 1, 0x02,                                                        // Frame Rate Control
+    0xB3, 10, 0xE5, 0xF6, 0x05, 0x46, 0x77, 0x77, 0x77, 0x77, 0x76, 0x45, // Gate EQ HPM
+    0xB4, 8, 0x05, 0x46, 0x77, 0x77, 0x77, 0x77, 0x76, 0x45,              // Gate EQ LPM
+    0x62, 3, 0x32, 0x03, 0x1F,                                            // Gate Timing Control
+    0xB7, 1, 0x13,                                                        // Source EQ Enable
+    0xB0, 1, 0x64,                                                        // Gate Line Setting: 384 lines
+    0x11, ST7305_INIT_DELAY | 0, 100,                                     // Sleep Out
+    0xC9, 1, 0x00,                                                        // Source Voltage Select
+    0x36, 1, 0x48,                                                        // Memory Data Access Control
+    0x3A, 1, 0x11,                                                        // Data Format Select
+    0xB9, 1, 0x20,                                                        // Gamma Mode Setting: Mono
+    0xB8, 1, 0x29,                                                        // Panel Setting
+    0x21, 0,                                                              // Display Inversion On
+    0x2A, 2, 0x12, 0x2A,                                                  // Column Address Setting
+    0x2B, 2, 0x00, 0xC7,                                                  // Row Address Setting
+    0xD0, 1, 0xFF,                                                        // Auto Power Down
+    0x38, 0,                                                              // High Power Mode
+    0x29, ST7305_INIT_DELAY | 0, 100,                                     // Display On
+};
+
+// Manufacturer settings for the LH420NB-F07 (ST7306), HPM 16Hz / LPM 8Hz
+static const uint8_t st7305_init_lh420nb_f07[] PROGMEM = {
+    27,                                                                   // Commands
+    0xD6, 2, 0x17, 0x02,                                                  // NVM Load Control
+    0xD1, 1, 0x01,                                                        // Booster Enable
+    0xC0, 2, 0x11, 0x04,                                                  // Gate Voltage Setting
+    0xC1, 4, 0x41, 0x41, 0x41, 0x41,                                      // VSHP Setting
+    0xC2, 4, 0x19, 0x19, 0x19, 0x19,                                      // VSLP Setting
+    0xC4, 4, 0x41, 0x41, 0x41, 0x41,                                      // VSHN Setting (-3.8V)
+    0xC5, 4, 0x19, 0x19, 0x19, 0x19,                                      // VSLN Setting (0.5V)
+    0xD8, 2, 0xA6, 0xE9,                                                  // OSC Setting
+    0xB2, 1, 0x05,                                                        // Frame Rate Control HPM=16 Hz, LPM= 8Hz
+    0xB3, 10, 0xE5, 0xF6, 0x05, 0x46, 0x77, 0x77, 0x77, 0x77, 0x76, 0x45, // Gate EQ HPM
+    0xB4, 8, 0x05, 0x46, 0x77, 0x77, 0x77, 0x77, 0x76, 0x45,              // Gate EQ LPM
+    0x62, 3, 0x32, 0x03, 0x1F,                                            // Gate Timing Control
+    0xB7, 1, 0x13,                                                        // Source EQ Enable
+    0xB0, 1, 0x64,                                                        // Gate Line Setting: 384 lines
+    0x11, ST7305_INIT_DELAY | 0, 100,                                     // Sleep Out
+    0xC9, 1, 0x00,                                                        // Source Voltage Select
+    0x36, 1, 0x48,                                                        // Memory Data Access Control Vertical, if horizontal 0x4C
+    0x3A, 1, 0x11,                                                        // Data Format Select
+    0xB9, 1, 0x20,                                                        // Gamma Mode Setting: Mono
+    0xB8, 1, 0x29,                                                        // Panel Setting
+    0x35, 0,                                                              // TE off
+    0x21, 0,                                                              // Display Inversion On
+    0x2A, 2, 0x12, 0x2A,                                                  // Column Address Setting
+    0x2B, 2, 0x00, 0xC7,                                                  // Row Address Setting
+    0xD0, 1, 0xFF,                                                        // Auto Power Down
+    0x38, 0,                                                              // High Power Mode
+    0x29, ST7305_INIT_DELAY | 0, 100,                                     // Display On
+};
+
+// Standard initialization sequence for ST7305 displays
+static const uint8_t st7305_init_generic[] PROGMEM = {
+    25,                                                                   // Commands
+    0xD6, 2, 0x17, 0x00,                                                  // NVM Load Control
+    0xD1, 1, 0x01,                                                        // Booster Enable
+    0xC0, 2, 0x0E, 0x0A,                                                  // Gate Voltage Setting
+    0xC1, 4, 0x41, 0x41, 0x41, 0x41,                                      // VSHP Setting
+    0xC2, 4, 0x32, 0x32, 0x32, 0x32,                                      // VSLP Setting
+    0xC4, 4, 0x46, 0x46, 0x46, 0x46,                                      // VSHN Setting
+    0xC5, 4, 0x46, 0x46, 0x46, 0x46,                                      // VSLN Setting
+    0xB2, 1, 0x12,                                                        // Frame Rate Control
+    0xB3, 10, 0xE5, 0xF6, 0x05, 0x46, 0x77, 0x77, 0x77, 0x77, 0x76, 0x45, // Gate EQ HPM
+    0xB4, 8, 0x05, 0x46, 0x77, 0x77, 0x77, 0x77, 0x76, 0x45,              // Gate EQ LPM
+    0xB7, 1, 0x13,                                                        // Source EQ Enable
+    0xB0, 1, 0x64,                                                        // Gate Line Setting: 400 lines
+    0x11, ST7305_INIT_DELAY | 0, 120,                                     // Sleep Out
+    0xD8, 2, 0x26, 0xE9,                                                  // OSC Setting
+    0xC9, 1, 0x00,                                                        // Source Voltage Select
+    0x36, 1, 0x00,                                                        // Memory Data Access Control
+    0x3A, 1, 0x11,                                                        // Data Format Select
+    0xB9, 1, 0x20,                                                        // Gamma Mode Setting: Mono
+    0xB8, 1, 0x29,                                                        // Panel Setting
+    0x2A, 2, 0x13, 0x28,                                                  // Column Address Setting
+    0x2B, 2, 0x00, 0xC7,                                                  // Row Address Setting
+    0x35, 1, 0x00,                                                        // Tearing Effect Line On
+    0xD0, 1, 0xFF,                                                        // Auto Power Down
+    0x39, 0,                                                              // Low Power Mode
+    0x29, ST7305_INIT_DELAY | 0, 10,                                      // Display On
+};
+
+// ============================================================================
+// Registry
+// ============================================================================
+
+// Indexed by st7305_panel_t
+static const st7305_panel_profile_t st7305_panels[ST7305_PANEL_COUNT] = {
+    { "TT420FSN21A", "ST7305", st7305_init_tt420fsn21a },
+    { "LH420NB-F07", "ST7306", st7305_init_lh420nb_f07 },
+    { "generic",     "ST7305", st7305_init_generic },
+};
+
+/**
+ * Get Panel - Registry entry of a known panel
+ */
+const st7305_panel_profile_t *st7305_get_panel(st7305_panel_t panel) {
+    if ((unsigned)panel >= ST7305_PANEL_COUNT) {
+        return nullptr;
+    }
+    return &st7305_panels[panel];
+}
+
+/**
+ * Find Panel - Registry entry by part number
+ */
+const st7305_panel_profile_t *st7305_find_panel(const char *name) {
+    if (!name) {
+        return nullptr;
+    }
+    for (uint8_t i = 0; i < ST7305_PANEL_COUNT; i++) {
+        if (strcmp(st7305_panels[i].name, name) == 0) {
+            return &st7305_panels[i];
+        }
+    }
+    return nullptr;
+}
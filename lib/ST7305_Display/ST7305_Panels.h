@@ -0,0 +1,77 @@
+/**
+ * ST7305_Panels.h
+ *
+ * Panel profiles and encoded init sequences for the ST7305 Monochrome
+ * Display Driver
+ *
+ * An init sequence is a variable-length byte stream kept once in flash:
+ *
+ *   count                                    Number of commands
+ *   cmd, len, data[len]                      Command without delay
+ *   cmd, len | ST7305_INIT_DELAY, data[len], delay_ms
+ *   ...
+ *
+ * so a command costs 2 bytes plus its parameters (and 1 for a delay)
+ * instead of a fixed 14-byte st7305_lcd_init_cmd_t. begin() sends it with
+ * CS held across runs of commands; the bus is only released while a
+ * delay runs, and the last delay overlaps whatever the sketch does next.
+ *
+ * A profile ties a sequence to the panel it was tuned for. begin() takes
+ * a st7305_panel_t and looks the profile up at run time, so one firmware
+ * image can drive either panel (e.g. chosen by a strap pin or a setting):
+ *
+ *   display.begin(1000000, ST7305_PANEL_LH420NB_F07);
+ *
+ * Custom sequences use the same format:
+ *
+ *   static const uint8_t myInit[] PROGMEM = {
+ *       2,
+ *       0x11, ST7305_INIT_DELAY | 0, 120,       // Sleep Out, 120ms
+ *       0x29, 0,                                // Display On
+ *   };
+ *   static const st7305_panel_profile_t myPanel = { "custom", "ST7305", myInit };
+ *   display.begin(1000000, myPanel);
+ */
+
+#ifndef ST7305_PANELS_H
+#define ST7305_PANELS_H
+
+#include <Arduino.h>
+
+// Length byte flag: a delay byte (milliseconds) follows the parameters
+#define ST7305_INIT_DELAY 0x80
+
+/**
+ * Known panels
+ */
+typedef enum {
+    ST7305_PANEL_TT420FSN21A = 0,   // 4.2" TT420FSN21A (ST7305), manufacturer settings
+    ST7305_PANEL_LH420NB_F07,       // 4.2" LH420NB-F07 (ST7306), manufacturer settings
+    ST7305_PANEL_GENERIC,           // ST7305 standard initialization
+    ST7305_PANEL_COUNT
+} st7305_panel_t;
+
+/**
+ * Panel profile (registry entry)
+ */
+typedef struct {
+    const char *name;           // Panel part number
+    const char *controller;     // Driver IC
+    const uint8_t *init;        // Encoded init sequence (PROGMEM)
+} st7305_panel_profile_t;
+
+/**
+ * st7305_get_panel - Profile of a known panel
+ *
+ * @return Profile, or nullptr if panel is out of range
+ */
+const st7305_panel_profile_t *st7305_get_panel(st7305_panel_t panel);
+
+/**
+ * st7305_find_panel - Profile by part number (e.g. read from a config file)
+ *
+ * @return Profile, or nullptr if no panel has that name
+ */
+const st7305_panel_profile_t *st7305_find_panel(const char *name);
+
+#endif // ST7305_PANELS_H
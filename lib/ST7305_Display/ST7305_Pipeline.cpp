@@ -0,0 +1,214 @@
+/**
+ * ST7305_Pipeline.cpp
+ *
+ * Producer/consumer frame pipeline implementation
+ *
+ * Slot ownership only changes through _mailbox.exchange(): the producer
+ * swaps its back slot in (marked fresh), the consumer swaps its front
+ * slot in (not fresh). Whatever comes back is the caller's new slot, so
+ * each slot has exactly one owner at any time. Everything else is
+ * private to one side and needs no synchronization.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "ST7305_Pipeline.h"
+
+// Mailbox flag: the slot holds a frame the consumer has not taken
+#define ST7305_PIPELINE_FRESH 0x80
+
+/**
+ * Constructor - Empty pipeline, call begin() before use
+ */
+ST7305_FramePipeline::ST7305_FramePipeline()
+    : _memory(nullptr), _mailbox(1), _front(2), _back(0), _latest(0),
+      _acquired(false), _sequence(0), _carryCount(0),
+      _submitted(0), _dropped(0), _taken(0) {
+    memset(_slots, 0, sizeof(_slots));
+    memset(_staleCount, 0, sizeof(_staleCount));
+}
+
+/**
+ * Destructor - Free the frame buffers
+ */
+ST7305_FramePipeline::~ST7305_FramePipeline() {
+    release();
+}
+
+/**
+ * Begin - Allocate and fill the slots, reset all state
+ *
+ * Not thread-safe: call before the consumer starts taking frames.
+ *
+ * @param initial Starting picture, or nullptr for white
+ * @return false if out of memory
+ */
+bool ST7305_FramePipeline::begin(const uint8_t *initial) {
+    release();
+    _memory = (uint8_t*)malloc((size_t)ST7305_BUFFER_SIZE * ST7305_PIPELINE_SLOTS);
+    if (!_memory) {
+        return false;
+    }
+
+    for (uint8_t s = 0; s < ST7305_PIPELINE_SLOTS; s++) {
+        _slots[s].buffer = _memory + (size_t)s * ST7305_BUFFER_SIZE;
+        _slots[s].rectCount = 0;
+        _slots[s].sequence = 0;
+        if (initial) {
+            memcpy(_slots[s].buffer, initial, ST7305_BUFFER_SIZE);
+        } else {
+            memset(_slots[s].buffer, 0xFF, ST7305_BUFFER_SIZE);
+        }
+        _staleCount[s] = 0;
+    }
+
+    _back = 0;
+    _latest = 0;
+    _mailbox.store(1);
+    _front = 2;
+    _acquired = false;
+    _sequence = 0;
+    _carryCount = 0;
+    _submitted.store(0);
+    _dropped.store(0);
+    _taken.store(0);
+    return true;
+}
+
+/**
+ * Acquire - Bring the back slot up to date and hand it to the producer
+ *
+ * Only the regions drawn since this slot last held the newest frame
+ * are copied (row-pair by row-pair, whole bytes).
+ *
+ * @return Back buffer
+ */
+uint8_t *ST7305_FramePipeline::acquire() {
+    if (!_memory) {
+        return nullptr;
+    }
+    if (!_acquired) {
+        uint8_t *dst = _slots[_back].buffer;
+        const uint8_t *src = _slots[_latest].buffer;
+        for (uint8_t i = 0; i < _staleCount[_back]; i++) {
+            const st7305_rect_t &r = _stale[_back][i];
+            uint32_t offset = (uint32_t)(r.y / 2) * ST7305_BYTES_PER_ROW + r.x / 4;
+            for (int16_t pair = 0; pair < r.h / 2; pair++) {
+                memcpy(dst + offset, src + offset, r.w / 4);
+                offset += ST7305_BYTES_PER_ROW;
+            }
+        }
+        _staleCount[_back] = 0;
+        _acquired = true;
+    }
+    return _slots[_back].buffer;
+}
+
+/**
+ * Submit - Publish the back slot and pick up a free one
+ *
+ * @param rects Damage since acquire()
+ * @param count Number of rects
+ * @return true if a frame was published
+ */
+bool ST7305_FramePipeline::submit(const st7305_rect_t *rects, uint8_t count) {
+    if (!_acquired) {
+        return false;
+    }
+
+    st7305_rect_t damage[ST7305_PIPELINE_MAX_RECTS];
+    uint8_t damageCount = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        st7305_rect_t r;
+        if (st7305_snap_rect(rects[i], r)) {
+            st7305_add_rect(damage, damageCount, ST7305_PIPELINE_MAX_RECTS, r);
+        }
+    }
+    if (damageCount == 0) {
+        return false;
+    }
+
+    // Every other slot is now behind by this damage
+    for (uint8_t s = 0; s < ST7305_PIPELINE_SLOTS; s++) {
+        if (s == _back) {
+            continue;
+        }
+        for (uint8_t i = 0; i < damageCount; i++) {
+            st7305_add_rect(_stale[s], _staleCount[s], ST7305_PIPELINE_MAX_RECTS, damage[i]);
+        }
+    }
+
+    // Once the previous frame is taken its damage has reached the consumer
+    if (!(_mailbox.load(std::memory_order_acquire) & ST7305_PIPELINE_FRESH)) {
+        _carryCount = 0;
+    }
+    st7305_frame_t &frame = _slots[_back];
+    memcpy(frame.rects, _carry, _carryCount * sizeof(st7305_rect_t));
+    frame.rectCount = _carryCount;
+    for (uint8_t i = 0; i < damageCount; i++) {
+        st7305_add_rect(frame.rects, frame.rectCount, ST7305_PIPELINE_MAX_RECTS, damage[i]);
+    }
+    frame.sequence = ++_sequence;
+
+    // Kept in case this frame is replaced before the consumer sees it
+    memcpy(_carry, frame.rects, frame.rectCount * sizeof(st7305_rect_t));
+    _carryCount = frame.rectCount;
+
+    _latest = _back;
+    uint8_t previous = _mailbox.exchange(_back | ST7305_PIPELINE_FRESH, std::memory_order_acq_rel);
+    _back = previous & ~ST7305_PIPELINE_FRESH;
+    _acquired = false;
+
+    _submitted.fetch_add(1, std::memory_order_relaxed);
+    if (previous & ST7305_PIPELINE_FRESH) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+/**
+ * Take - Swap the front slot for the waiting frame
+ *
+ * @return Newest frame, or nullptr if none is waiting
+ */
+const st7305_frame_t *ST7305_FramePipeline::take() {
+    if (!(_mailbox.load(std::memory_order_acquire) & ST7305_PIPELINE_FRESH)) {
+        return nullptr;
+    }
+    // Only the producer sets the flag, so the exchange always gets a fresh frame
+    uint8_t previous = _mailbox.exchange(_front, std::memory_order_acq_rel);
+    _front = previous & ~ST7305_PIPELINE_FRESH;
+    _taken.fetch_add(1, std::memory_order_relaxed);
+    return &_slots[_front];
+}
+
+/**
+ * Pending - Frame waiting in the mailbox
+ */
+bool ST7305_FramePipeline::pending() const {
+    return (_mailbox.load(std::memory_order_acquire) & ST7305_PIPELINE_FRESH) != 0;
+}
+
+/**
+ * Get Stats - Snapshot of the counters
+ */
+st7305_pipeline_stats_t ST7305_FramePipeline::getStats() const {
+    st7305_pipeline_stats_t stats;
+    stats.submitted = _submitted.load(std::memory_order_relaxed);
+    stats.dropped = _dropped.load(std::memory_order_relaxed);
+    stats.taken = _taken.load(std::memory_order_relaxed);
+    return stats;
+}
+
+/**
+ * Release - Free the slot buffers
+ */
+void ST7305_FramePipeline::release() {
+    if (_memory) {
+        free(_memory);
+        _memory = nullptr;
+    }
+    for (uint8_t s = 0; s < ST7305_PIPELINE_SLOTS; s++) {
+        _slots[s].buffer = nullptr;
+    }
+}
@@ -0,0 +1,167 @@
+/**
+ * ST7305_Pipeline.h
+ *
+ * Producer/consumer frame pipeline for the ST7305 Monochrome Display Driver
+ *
+ * Lets one task draw the next frame while another task pushes the
+ * previous one over SPI. Three frame buffers rotate between the two
+ * sides:
+ * - back:    owned by the producer, being drawn
+ * - mailbox: the latest submitted frame, waiting to be taken
+ * - front:   owned by the consumer, being sent
+ *
+ * The mailbox is a single atomic byte (slot index + "fresh" flag), so the
+ * exchange is lock-free and wait-free on both sides. It holds at most one
+ * frame: a producer that runs ahead replaces the waiting frame (latest
+ * frame wins) instead of blocking. The damage of a replaced frame is
+ * carried into the next one, so every frame handed to the consumer lists
+ * all regions that changed since the frame it took before.
+ *
+ * Each slot also keeps the regions where it is behind the newest frame.
+ * acquire() copies just those regions from the last submitted frame, so
+ * the producer always draws on top of the current picture and only the
+ * damage has to be redrawn.
+ *
+ * This file has no Arduino dependencies (std::atomic only).
+ *
+ * Usage:
+ *   // Producer
+ *   display.setBuffer(pipeline.acquire());
+ *   ... draw ...
+ *   pipeline.submit(display.getDirtyRect());
+ *   display.clearDirty();
+ *
+ *   // Consumer
+ *   const st7305_frame_t *frame = pipeline.take();
+ *   if (frame) display.displayFrame(frame->buffer, frame->rects, frame->rectCount);
+ */
+
+#ifndef ST7305_PIPELINE_H
+#define ST7305_PIPELINE_H
+
+#include <atomic>
+#include "ST7305_Types.h"
+
+// Frame buffers in rotation (back, mailbox, front)
+#define ST7305_PIPELINE_SLOTS     3
+
+// Damage rectangles kept per frame; more are merged into a bounding box
+#define ST7305_PIPELINE_MAX_RECTS 8
+
+/**
+ * A submitted frame as seen by the consumer
+ * Rectangles are absolute, snapped to the 12-pixel / 2-row RAM window
+ * grid and never overlap.
+ */
+typedef struct {
+    uint8_t *buffer;                                  // ST7305_BUFFER_SIZE bytes
+    st7305_rect_t rects[ST7305_PIPELINE_MAX_RECTS];   // Changed since the previous taken frame
+    uint8_t rectCount;                                // At least 1
+    uint32_t sequence;                                // Submit counter, gaps = dropped frames
+} st7305_frame_t;
+
+/**
+ * Pipeline counters
+ */
+typedef struct {
+    uint32_t submitted;   // Frames published by submit()
+    uint32_t dropped;     // Frames replaced in the mailbox before take()
+    uint32_t taken;       // Frames returned by take()
+} st7305_pipeline_stats_t;
+
+// ============================================================================
+// ST7305_FramePipeline Class
+// ============================================================================
+
+class ST7305_FramePipeline {
+public:
+    ST7305_FramePipeline();
+    ~ST7305_FramePipeline();
+
+    /**
+     * begin - Allocate the frame buffers
+     *
+     * @param initial Picture to start from (e.g. the current display
+     *                buffer), or nullptr for all white
+     * @return false if allocation fails
+     */
+    bool begin(const uint8_t *initial = nullptr);
+
+    // ========================================================================
+    // Producer Side
+    // ========================================================================
+
+    /**
+     * acquire - Get the buffer to draw the next frame into
+     *
+     * The buffer holds the last submitted frame. Calling again before
+     * submit() returns the same buffer.
+     *
+     * @return Frame buffer, nullptr before begin()
+     */
+    uint8_t *acquire();
+
+    /**
+     * submit - Publish the acquired buffer as the newest frame
+     *
+     * Damage is clipped to the panel and widened to the RAM window grid.
+     * If the consumer has not taken the previous frame yet, that frame
+     * is dropped and its damage is merged into this one.
+     *
+     * @param rects Regions drawn since acquire() (absolute)
+     * @param count Number of rects
+     * @return false if nothing was acquired or the damage is empty
+     *         (the buffer stays acquired)
+     */
+    bool submit(const st7305_rect_t *rects, uint8_t count);
+    bool submit(const st7305_rect_t &damage) { return submit(&damage, 1); }
+
+    // ========================================================================
+    // Consumer Side
+    // ========================================================================
+
+    /**
+     * take - Get the newest submitted frame, if any
+     *
+     * The frame stays valid (and is not written by the producer) until
+     * the next take() call.
+     *
+     * @return Frame, or nullptr if nothing new was submitted
+     */
+    const st7305_frame_t *take();
+
+    /**
+     * pending - A frame is waiting to be taken
+     */
+    bool pending() const;
+
+    /**
+     * getStats - Counters since begin()
+     */
+    st7305_pipeline_stats_t getStats() const;
+
+private:
+    st7305_frame_t _slots[ST7305_PIPELINE_SLOTS];
+    uint8_t *_memory;                                 // All slot buffers
+
+    std::atomic<uint8_t> _mailbox;                    // Slot index | ST7305_PIPELINE_FRESH
+
+    // Consumer state
+    uint8_t _front;
+
+    // Producer state
+    uint8_t _back;
+    uint8_t _latest;                                  // Slot of the last submitted frame
+    bool _acquired;
+    uint32_t _sequence;
+    st7305_rect_t _stale[ST7305_PIPELINE_SLOTS][ST7305_PIPELINE_MAX_RECTS]; // Behind _latest
+    uint8_t _staleCount[ST7305_PIPELINE_SLOTS];
+    st7305_rect_t _carry[ST7305_PIPELINE_MAX_RECTS];  // Damage not yet seen by the consumer
+    uint8_t _carryCount;
+
+    std::atomic<uint32_t> _submitted, _dropped, _taken;
+
+    void release();
+};
+
+#endif // ST7305_PIPELINE_H
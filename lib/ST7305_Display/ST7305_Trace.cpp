@@ -0,0 +1,128 @@
+/**
+ * ST7305_Trace.cpp
+ *
+ * SPI wire-trace recorder implementation
+ *
+ * Data bytes are held back until a command, a frame marker or end(), so
+ * a RAMWR that reaches the recorder one row-pair at a time still shows
+ * up as a few large bursts.
+ */
+
+#include "ST7305_Trace.h"
+
+/**
+ * Constructor - Idle recorder, nothing written yet
+ *
+ * @param out     Sink for the log
+ * @param payload Keep data bytes
+ */
+ST7305_WireTrace::ST7305_WireTrace(Print &out, bool payload)
+    : _out(out), _payload(payload), _burstLen(0) {
+    memset(&_stats, 0, sizeof(_stats));
+    memset(&_frameStats, 0, sizeof(_frameStats));
+}
+
+/**
+ * Begin - Start a new log
+ */
+void ST7305_WireTrace::begin() {
+    static const uint8_t header[8] = { 'S', '7', 'T', 'R', ST7305_TRACE_VERSION, 0, 0, 0 };
+    _burstLen = 0;
+    memset(&_stats, 0, sizeof(_stats));
+    memset(&_frameStats, 0, sizeof(_frameStats));
+    put(header, sizeof(header));
+}
+
+/**
+ * Frame - Write a frame marker
+ *
+ * @param tag Value kept in the marker
+ */
+void ST7305_WireTrace::frame(uint8_t tag) {
+    flushBurst();
+    uint8_t record[2] = { ST7305_TRACE_FRAME, tag };
+    put(record, sizeof(record));
+    _stats.frames++;
+    memset(&_frameStats, 0, sizeof(_frameStats));
+}
+
+/**
+ * Command - Record a command byte
+ *
+ * @param cmd Byte sent with DC low
+ */
+void ST7305_WireTrace::command(uint8_t cmd) {
+    flushBurst();
+    uint8_t record[2] = { ST7305_TRACE_CMD, cmd };
+    put(record, sizeof(record));
+    _stats.commands++;
+    _frameStats.commands++;
+}
+
+/**
+ * Data - Record data bytes
+ *
+ * @param bytes Bytes sent with DC high
+ * @param len   Number of bytes
+ */
+void ST7305_WireTrace::data(const uint8_t *bytes, uint32_t len) {
+    _stats.dataBytes += len;
+    _frameStats.dataBytes += len;
+    if (!_payload) {
+        _burstLen += len;
+        return;
+    }
+    while (len > 0) {
+        uint32_t n = ST7305_TRACE_BURST - _burstLen;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(_burst + _burstLen, bytes, n);
+        _burstLen += n;
+        bytes += n;
+        len -= n;
+        if (_burstLen == ST7305_TRACE_BURST) {
+            flushBurst();
+        }
+    }
+}
+
+/**
+ * Flush Burst - Write the pending data bytes as one record
+ */
+void ST7305_WireTrace::flushBurst() {
+    if (_burstLen == 0) {
+        return;
+    }
+    if (_payload) {
+        putRecord(ST7305_TRACE_DATA, _burstLen);
+        put(_burst, _burstLen);
+    } else {
+        putRecord(ST7305_TRACE_COUNT, _burstLen);
+    }
+    _burstLen = 0;
+}
+
+/**
+ * Put Record - Record type followed by a varint length
+ */
+void ST7305_WireTrace::putRecord(uint8_t type, uint32_t length) {
+    uint8_t record[6];
+    size_t n = 0;
+    record[n++] = type;
+    do {
+        uint8_t b = length & 0x7F;
+        length >>= 7;
+        record[n++] = length ? (b | 0x80) : b;
+    } while (length);
+    put(record, n);
+}
+
+/**
+ * Put - Write to the sink and count what it accepted
+ */
+void ST7305_WireTrace::put(const uint8_t *bytes, size_t len) {
+    size_t written = _out.write(bytes, len);
+    _stats.logBytes += written;
+    _stats.dropped += len - written;
+}
@@ -0,0 +1,134 @@
+/**
+ * ST7305_Trace.h
+ *
+ * SPI wire-trace recorder for the ST7305 Monochrome Display Driver
+ *
+ * Records every byte the driver puts on the bus - commands, parameters
+ * and pixel data, with the DC state - into a compact binary log written
+ * to any Print (Serial, a File, a RAM buffer). The log is replayed on the
+ * host by tools/st7305_trace.py, which rebuilds the panel RAM frame by
+ * frame, diffs two traces and reports bytes and commands per frame, so
+ * a workload's bus cost can be checked against a budget.
+ *
+ * Log format (little-endian):
+ *
+ *   'S','7','T','R', version, 0, 0, 0        Header
+ *   0x01, cmd                                Command byte (DC low)
+ *   0x02, length (varint), bytes[length]     Data burst (DC high)
+ *   0x03, length (varint)                    Data burst, bytes not kept
+ *   0x04, tag                                Frame marker from frame()
+ *
+ * A varint holds 7 bits per byte, low bits first, bit 7 set on all but
+ * the last byte. Consecutive data bytes are merged into one burst (up to
+ * ST7305_TRACE_BURST bytes with payload), so a full frame costs about
+ * 15KB plus a few hundred bytes of record headers; without payload the
+ * same frame is a few dozen bytes.
+ *
+ * Usage:
+ *   ST7305_WireTrace trace(Serial);
+ *   trace.begin();
+ *   display.setTrace(&trace);
+ *   ... draw, display() ...
+ *   trace.frame();                        // One workload step done
+ *   display.setTrace(nullptr);
+ *   trace.end();
+ *
+ *   $ python3 tools/st7305_trace.py summary run.s7tr --budget-bytes 16000
+ *
+ * Notes:
+ * - Tracing costs CPU time and sink bandwidth; timing-sensitive paths
+ *   (grayscale planes) run slower while it is on.
+ * - Chip select is not recorded: give each display its own trace.
+ */
+
+#ifndef ST7305_TRACE_H
+#define ST7305_TRACE_H
+
+#include <Arduino.h>
+
+// Log format version written in the header
+#define ST7305_TRACE_VERSION 1
+
+// Data bytes buffered before a burst record is written (RAM)
+#define ST7305_TRACE_BURST   128
+
+// Record types
+#define ST7305_TRACE_CMD     0x01
+#define ST7305_TRACE_DATA    0x02
+#define ST7305_TRACE_COUNT   0x03
+#define ST7305_TRACE_FRAME   0x04
+
+/**
+ * Trace counters
+ */
+typedef struct {
+    uint32_t commands;    // Command bytes (DC low)
+    uint32_t dataBytes;   // Parameter and pixel bytes (DC high)
+    uint32_t frames;      // frame() markers
+    uint32_t logBytes;    // Bytes written to the sink
+    uint32_t dropped;     // Bytes the sink did not accept
+} st7305_trace_stats_t;
+
+// ============================================================================
+// ST7305_WireTrace Class
+// ============================================================================
+
+class ST7305_WireTrace {
+public:
+    /**
+     * Constructor
+     * @param out     Sink for the log
+     * @param payload Keep data bytes (false: record burst lengths only)
+     */
+    ST7305_WireTrace(Print &out, bool payload = true);
+
+    /**
+     * begin - Write the header and zero the counters
+     */
+    void begin();
+
+    /**
+     * end - Write out the buffered burst
+     */
+    void end() { flushBurst(); }
+
+    /**
+     * frame - Mark the end of a workload step
+     *
+     * The host tool reports traffic and reconstructs the panel per
+     * marked frame.
+     *
+     * @param tag Free-form value kept in the log (e.g. a scene number)
+     */
+    void frame(uint8_t tag = 0);
+
+    /**
+     * Recording hooks (called by ST7305_Mono for every byte it sends)
+     */
+    void command(uint8_t cmd);
+    void data(const uint8_t *bytes, uint32_t len);
+    void data(uint8_t value) { data(&value, 1); }
+
+    /**
+     * Statistics
+     *
+     * getStats() covers everything since begin(); getFrameStats() the
+     * traffic since the last frame() (frames and logBytes are not kept).
+     */
+    st7305_trace_stats_t getStats() const { return _stats; }
+    st7305_trace_stats_t getFrameStats() const { return _frameStats; }
+
+private:
+    Print &_out;
+    bool _payload;
+    uint8_t _burst[ST7305_TRACE_BURST];
+    uint32_t _burstLen;                  // Pending data bytes (kept in _burst with payload)
+    st7305_trace_stats_t _stats;
+    st7305_trace_stats_t _frameStats;
+
+    void flushBurst();
+    void put(const uint8_t *bytes, size_t len);
+    void putRecord(uint8_t type, uint32_t length);  // Type and varint length
+};
+
+#endif // ST7305_TRACE_H
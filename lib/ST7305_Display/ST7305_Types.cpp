@@ -0,0 +1,99 @@
+/**
+ * ST7305_Types.cpp
+ *
+ * Damage rectangle helpers shared by the frame pipeline, the widget
+ * screen and the grayscale planes
+ *
+ * Like ST7305_Types.h, free of Arduino headers.
+ */
+
+#include <stdint.h>
+#include "ST7305_Types.h"
+
+/**
+ * Snap Rect - Clip to the panel and widen to the RAM window grid
+ *
+ * @return false if nothing is left
+ */
+bool st7305_snap_rect(const st7305_rect_t &r, st7305_rect_t &out) {
+    int32_t x0 = (r.x < 0) ? 0 : r.x;
+    int32_t y0 = (r.y < 0) ? 0 : r.y;
+    int32_t x1 = (int32_t)r.x + r.w - 1;
+    int32_t y1 = (int32_t)r.y + r.h - 1;
+    if (x1 > ST7305_WIDTH - 1) x1 = ST7305_WIDTH - 1;
+    if (y1 > ST7305_HEIGHT - 1) y1 = ST7305_HEIGHT - 1;
+    if ((r.w <= 0) || (r.h <= 0) || (x0 > x1) || (y0 > y1)) {
+        return false;
+    }
+
+    x0 -= x0 % ST7305_PIXELS_PER_COL;
+    x1 += ST7305_PIXELS_PER_COL - 1 - x1 % ST7305_PIXELS_PER_COL;
+    if (x1 > ST7305_WIDTH - 1) x1 = ST7305_WIDTH - 1;
+    y0 &= ~1;
+    y1 |= 1;
+    if (y1 > ST7305_HEIGHT - 1) y1 = ST7305_HEIGHT - 1;
+
+    out.x = x0;
+    out.y = y0;
+    out.w = x1 - x0 + 1;
+    out.h = y1 - y0 + 1;
+    return true;
+}
+
+/**
+ * Union - Bounding box of two rectangles (either may be empty)
+ */
+st7305_rect_t st7305_union_rect(const st7305_rect_t &a, const st7305_rect_t &b) {
+    if ((a.w <= 0) || (a.h <= 0)) {
+        return b;
+    }
+    if ((b.w <= 0) || (b.h <= 0)) {
+        return a;
+    }
+    int16_t x0 = (a.x < b.x) ? a.x : b.x;
+    int16_t y0 = (a.y < b.y) ? a.y : b.y;
+    int16_t x1 = (a.x + a.w > b.x + b.w) ? a.x + a.w : b.x + b.w;
+    int16_t y1 = (a.y + a.h > b.y + b.h) ? a.y + a.h : b.y + b.h;
+    st7305_rect_t r = { x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0) };
+    return r;
+}
+
+/**
+ * Mergeable - Rectangles overlap or share part of an edge
+ */
+static bool mergeable(const st7305_rect_t &a, const st7305_rect_t &b) {
+    bool overlapX = (a.x < b.x + b.w) && (b.x < a.x + a.w);
+    bool overlapY = (a.y < b.y + b.h) && (b.y < a.y + a.h);
+    bool touchX = (a.x <= b.x + b.w) && (b.x <= a.x + a.w);
+    bool touchY = (a.y <= b.y + b.h) && (b.y <= a.y + a.h);
+    return (overlapX && touchY) || (touchX && overlapY);
+}
+
+/**
+ * Add Rect - Merge into a disjoint list, or take the cheapest entry when full
+ */
+void st7305_add_rect(st7305_rect_t *list, uint8_t &count, uint8_t capacity, st7305_rect_t r) {
+    for (;;) {
+        uint8_t i = 0;
+        while ((i < count) && !mergeable(list[i], r)) {
+            i++;
+        }
+        if (i == count) {
+            if (count < capacity) {
+                list[count++] = r;
+                return;
+            }
+            int32_t best = INT32_MAX;
+            for (uint8_t j = 0; j < count; j++) {
+                st7305_rect_t u = st7305_union_rect(list[j], r);
+                int32_t growth = (int32_t)u.w * u.h - (int32_t)list[j].w * list[j].h;
+                if (growth < best) {
+                    best = growth;
+                    i = j;
+                }
+            }
+        }
+        r = st7305_union_rect(list[i], r);
+        list[i] = list[--count];
+    }
+}
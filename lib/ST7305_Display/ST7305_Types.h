@@ -0,0 +1,86 @@
+/**
+ * ST7305_Types.h
+ *
+ * Panel geometry and plain data types shared by the ST7305 driver
+ *
+ * Kept free of Arduino headers so that code which only moves frame
+ * buffers around (see ST7305_Pipeline.h) can also be built and
+ * exercised on a host.
+ */
+
+#ifndef ST7305_TYPES_H
+#define ST7305_TYPES_H
+
+#include <stdint.h>
+
+// Display resolution
+// NOTE: ST7305 datasheet specifies 264x320, but supporting 300x400 as specified
+// Adjust these values to match your actual display panel
+#define ST7305_WIDTH  300
+#define ST7305_HEIGHT 400
+
+// Display buffer size calculation:
+// ST7305 uses 4 pixels per byte horizontally, 2 rows per vertical group
+// Formula: (WIDTH / 4) * (HEIGHT / 2) = 75 * 200 = 15,000 bytes
+// DO NOT change this formula unless hardware layout changes
+#define ST7305_BUFFER_SIZE (((ST7305_WIDTH / 4) * (ST7305_HEIGHT / 2)))
+
+// Bytes per row-pair in the frame buffer (75 for a 300 pixel wide panel)
+#define ST7305_BYTES_PER_ROW (ST7305_WIDTH / 4)
+
+// Controller RAM window granularity:
+// one column address covers 12 pixels (3 buffer bytes),
+// one row address covers a row-pair (2 pixel rows)
+#define ST7305_PIXELS_PER_COL 12
+#define ST7305_BYTES_PER_COL  (ST7305_PIXELS_PER_COL / 4)
+
+/**
+ * Point structure for polygon and batched drawing primitives
+ */
+typedef struct {
+    int16_t x;
+    int16_t y;
+} st7305_point_t;
+
+/**
+ * Rectangle structure for clipping, dirty tracking and partial updates
+ * A rectangle with w or h <= 0 is empty.
+ */
+typedef struct {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+} st7305_rect_t;
+
+// ============================================================================
+// Damage Rectangle Helpers (ST7305_Types.cpp)
+// ============================================================================
+
+/**
+ * st7305_snap_rect - Clip to the panel and widen to the RAM window grid
+ *
+ * @return false if nothing is left
+ */
+bool st7305_snap_rect(const st7305_rect_t &r, st7305_rect_t &out);
+
+/**
+ * st7305_union_rect - Bounding box of two rectangles (either may be empty)
+ */
+st7305_rect_t st7305_union_rect(const st7305_rect_t &a, const st7305_rect_t &b);
+
+/**
+ * st7305_add_rect - Insert a snapped rectangle into a disjoint rect list
+ *
+ * Overlapping or adjacent entries are merged with it. When the list is
+ * full it is merged into the entry whose area grows least. Either way
+ * the merged rectangle is re-inserted, so the list stays disjoint.
+ *
+ * @param list     Rectangles, pairwise disjoint
+ * @param count    Entries in use, updated
+ * @param capacity Size of list
+ * @param r        Rectangle to add
+ */
+void st7305_add_rect(st7305_rect_t *list, uint8_t &count, uint8_t capacity, st7305_rect_t r);
+
+#endif // ST7305_TYPES_H
@@ -0,0 +1,555 @@
+/**
+ * ST7305_Widgets.cpp
+ *
+ * Retained widget implementation
+ *
+ * Widgets only record damage when their state changes; nothing is drawn
+ * until ST7305_WidgetScreen::render(). Damage is one local rectangle per
+ * widget (the union of everything changed since the last render).
+ */
+
+#include "ST7305_Widgets.h"
+
+// Classic font cell at text size 1
+#define ST7305_WIDGET_CHAR_W 6
+#define ST7305_WIDGET_CHAR_H 8
+
+// Inset of a bar's fill from its bounds (1 pixel outline, 1 pixel space)
+#define ST7305_BAR_INSET     2
+
+// ===== ST7305_Widget =====
+
+/**
+ * Constructor - White on black, fully damaged
+ */
+ST7305_Widget::ST7305_Widget(int16_t x, int16_t y, int16_t w, int16_t h)
+    : _fg(ST7305_WHITE), _bg(ST7305_BLACK), _next(nullptr) {
+    _bounds.x = x;
+    _bounds.y = y;
+    _bounds.w = (w > 0) ? w : 0;
+    _bounds.h = (h > 0) ? h : 0;
+    invalidate();
+}
+
+/**
+ * Set Colors - Foreground and background
+ */
+void ST7305_Widget::setColors(uint16_t fg, uint16_t bg) {
+    if ((fg != _fg) || (bg != _bg)) {
+        _fg = fg;
+        _bg = bg;
+        invalidate();
+    }
+}
+
+/**
+ * Invalidate - Damage the whole widget
+ */
+void ST7305_Widget::invalidate() {
+    _damage.x = 0;
+    _damage.y = 0;
+    _damage.w = _bounds.w;
+    _damage.h = _bounds.h;
+}
+
+/**
+ * Invalidate - Add a local rectangle to the damage
+ *
+ * @param x, y Top-left corner (local coordinates)
+ * @param w, h Size in pixels
+ */
+void ST7305_Widget::invalidate(int16_t x, int16_t y, int16_t w, int16_t h) {
+    int16_t x0 = (x < 0) ? 0 : x;
+    int16_t y0 = (y < 0) ? 0 : y;
+    int16_t x1 = (x + w > _bounds.w) ? _bounds.w : x + w;
+    int16_t y1 = (y + h > _bounds.h) ? _bounds.h : y + h;
+    if ((x0 >= x1) || (y0 >= y1)) {
+        return;
+    }
+    st7305_rect_t r = { x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0) };
+    _damage = st7305_union_rect(_damage, r);
+}
+
+// ===== ST7305_Label =====
+
+/**
+ * Constructor
+ *
+ * @param text  Initial text
+ * @param size  Text size
+ * @param align Horizontal placement
+ */
+ST7305_Label::ST7305_Label(int16_t x, int16_t y, int16_t w, int16_t h, const char *text,
+                           uint8_t size, st7305_align_t align)
+    : ST7305_Widget(x, y, w, h), _size((size > 0) ? size : 1), _align(align) {
+    strncpy(_text, text ? text : "", ST7305_LABEL_MAX_CHARS);
+    _text[ST7305_LABEL_MAX_CHARS] = '\0';
+}
+
+/**
+ * Set Text - Damage the character cells that change
+ *
+ * A cell is kept when the other string has the same character at the
+ * same pixel position, which also covers right-aligned text whose
+ * length does not change.
+ *
+ * @param text New text
+ */
+void ST7305_Label::setText(const char *text) {
+    char next[ST7305_LABEL_MAX_CHARS + 1];
+    strncpy(next, text ? text : "", ST7305_LABEL_MAX_CHARS);
+    next[ST7305_LABEL_MAX_CHARS] = '\0';
+    if (strcmp(next, _text) == 0) {
+        return;
+    }
+
+    int16_t cw = ST7305_WIDGET_CHAR_W * _size;
+    size_t oldLen = strlen(_text);
+    size_t newLen = strlen(next);
+    int16_t oldX = textX(oldLen);
+    int16_t newX = textX(newLen);
+    int16_t x0 = INT16_MAX;
+    int16_t x1 = INT16_MIN;
+
+    for (uint8_t pass = 0; pass < 2; pass++) {
+        const char *s = pass ? next : _text;
+        const char *other = pass ? _text : next;
+        size_t len = pass ? newLen : oldLen;
+        size_t otherLen = pass ? oldLen : newLen;
+        int16_t sx = pass ? newX : oldX;
+        int16_t ox = pass ? oldX : newX;
+        for (size_t i = 0; i < len; i++) {
+            int16_t cx = sx + i * cw;
+            int32_t offset = cx - ox;
+            if ((offset >= 0) && (offset % cw == 0) && ((size_t)(offset / cw) < otherLen) &&
+                (other[offset / cw] == s[i])) {
+                continue;
+            }
+            if (cx < x0) x0 = cx;
+            if (cx + cw > x1) x1 = cx + cw;
+        }
+    }
+
+    strcpy(_text, next);
+    if (x0 < x1) {
+        invalidate(x0, textY(), x1 - x0, ST7305_WIDGET_CHAR_H * _size);
+    }
+}
+
+/**
+ * Draw - Background, then the text
+ */
+void ST7305_Label::draw(ST7305_Mono &display) {
+    st7305_rect_t bounds = getBounds();
+    display.fillRect(0, 0, bounds.w, bounds.h, _bg);
+
+    int16_t cw = ST7305_WIDGET_CHAR_W * _size;
+    int16_t x = textX(strlen(_text));
+    int16_t y = textY();
+    for (const char *c = _text; *c; c++, x += cw) {
+        display.drawChar(x, y, (unsigned char)*c, _fg, _fg, _size);
+    }
+}
+
+/**
+ * Text X - Left edge of a string of len characters
+ */
+int16_t ST7305_Label::textX(size_t len) const {
+    int16_t width = len * ST7305_WIDGET_CHAR_W * _size;
+    switch (_align) {
+        case ST7305_ALIGN_CENTER: return (getBounds().w - width) / 2;
+        case ST7305_ALIGN_RIGHT:  return getBounds().w - width;
+        default:                  return 0;
+    }
+}
+
+/**
+ * Text Y - Top of the text, vertically centered
+ */
+int16_t ST7305_Label::textY() const {
+    int16_t y = (getBounds().h - ST7305_WIDGET_CHAR_H * _size) / 2;
+    return (y > 0) ? y : 0;
+}
+
+// ===== ST7305_Readout =====
+
+/**
+ * Constructor - Blank until the first setValue()
+ *
+ * @param decimals Digits after the decimal point
+ * @param unit     Suffix, or nullptr
+ */
+ST7305_Readout::ST7305_Readout(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t decimals,
+                               const char *unit, uint8_t size, st7305_align_t align)
+    : ST7305_Label(x, y, w, h, "", size, align), _unit(unit),
+      _decimals((decimals > 6) ? 6 : decimals), _value(0), _valid(false) {
+}
+
+/**
+ * Set Value - Format a fixed-point value
+ *
+ * @param scaled Value * 10^decimals
+ */
+void ST7305_Readout::setValue(int32_t scaled) {
+    if (_valid && (scaled == _value)) {
+        return;
+    }
+    _value = scaled;
+    _valid = true;
+
+    uint32_t scale = 1;
+    for (uint8_t i = 0; i < _decimals; i++) {
+        scale *= 10;
+    }
+    uint32_t magnitude = (scaled < 0) ? (uint32_t)0 - (uint32_t)scaled : (uint32_t)scaled;
+
+    char text[ST7305_LABEL_MAX_CHARS + 1];
+    int n = snprintf(text, sizeof(text), "%s%lu", (scaled < 0) ? "-" : "",
+                     (unsigned long)(magnitude / scale));
+    if (_decimals && (n > 0) && (n < (int)sizeof(text))) {
+        n += snprintf(text + n, sizeof(text) - n, ".%0*lu", _decimals,
+                      (unsigned long)(magnitude % scale));
+    }
+    if (_unit && (n > 0) && (n < (int)sizeof(text))) {
+        snprintf(text + n, sizeof(text) - n, "%s", _unit);
+    }
+    setText(text);
+}
+
+/**
+ * Set Value - Round a float to the readout's decimals
+ */
+void ST7305_Readout::setValue(float value) {
+    for (uint8_t i = 0; i < _decimals; i++) {
+        value *= 10.0f;
+    }
+    if (value > 2147483520.0f) value = 2147483520.0f;
+    if (value < -2147483520.0f) value = -2147483520.0f;
+    setValue((int32_t)lroundf(value));
+}
+
+// ===== ST7305_Bar =====
+
+/**
+ * Constructor - Empty bar
+ *
+ * @param min, max Range
+ * @param vertical Bottom-up fill
+ */
+ST7305_Bar::ST7305_Bar(int16_t x, int16_t y, int16_t w, int16_t h, int32_t min, int32_t max,
+                       bool vertical)
+    : ST7305_Widget(x, y, w, h), _min(min), _max(max), _value(min), _vertical(vertical), _fill(0) {
+}
+
+/**
+ * Set Value - Damage the strip between the old and new fill
+ */
+void ST7305_Bar::setValue(int32_t value) {
+    _value = value;
+    int16_t fill = fillFor(value);
+    if (fill == _fill) {
+        return;
+    }
+    int16_t lo = (fill < _fill) ? fill : _fill;
+    int16_t hi = (fill < _fill) ? _fill : fill;
+    _fill = fill;
+
+    st7305_rect_t b = getBounds();
+    if (_vertical) {
+        invalidate(ST7305_BAR_INSET, b.h - ST7305_BAR_INSET - hi,
+                   b.w - 2 * ST7305_BAR_INSET, hi - lo);
+    } else {
+        invalidate(ST7305_BAR_INSET + lo, ST7305_BAR_INSET,
+                   hi - lo, b.h - 2 * ST7305_BAR_INSET);
+    }
+}
+
+/**
+ * Set Range - New min and max (keeps the value)
+ */
+void ST7305_Bar::setRange(int32_t min, int32_t max) {
+    _min = min;
+    _max = max;
+    setValue(_value);
+}
+
+/**
+ * Draw - Outline, filled part, empty part
+ */
+void ST7305_Bar::draw(ST7305_Mono &display) {
+    st7305_rect_t b = getBounds();
+    int16_t iw = b.w - 2 * ST7305_BAR_INSET;
+    int16_t ih = b.h - 2 * ST7305_BAR_INSET;
+    display.drawRect(0, 0, b.w, b.h, _fg);
+    display.drawRect(1, 1, b.w - 2, b.h - 2, _bg);
+    if (_vertical) {
+        display.fillRect(ST7305_BAR_INSET, ST7305_BAR_INSET, iw, ih - _fill, _bg);
+        display.fillRect(ST7305_BAR_INSET, ST7305_BAR_INSET + ih - _fill, iw, _fill, _fg);
+    } else {
+        display.fillRect(ST7305_BAR_INSET, ST7305_BAR_INSET, _fill, ih, _fg);
+        display.fillRect(ST7305_BAR_INSET + _fill, ST7305_BAR_INSET, iw - _fill, ih, _bg);
+    }
+}
+
+/**
+ * Length - Pixels between empty and full
+ */
+int16_t ST7305_Bar::length() const {
+    int16_t len = (_vertical ? getBounds().h : getBounds().w) - 2 * ST7305_BAR_INSET;
+    return (len > 0) ? len : 0;
+}
+
+/**
+ * Fill For - Filled pixels for a value (rounded, clamped)
+ */
+int16_t ST7305_Bar::fillFor(int32_t value) const {
+    if (_max <= _min) {
+        return 0;
+    }
+    if (value <= _min) {
+        return 0;
+    }
+    if (value >= _max) {
+        return length();
+    }
+    int64_t range = (int64_t)_max - _min;
+    return (int16_t)(((int64_t)(value - _min) * length() + range / 2) / range);
+}
+
+// ===== ST7305_ChartStrip =====
+
+/**
+ * Constructor - Empty chart
+ *
+ * @param min, max Value range
+ */
+ST7305_ChartStrip::ST7305_ChartStrip(int16_t x, int16_t y, int16_t w, int16_t h,
+                                     int32_t min, int32_t max)
+    : ST7305_Widget(x, y, (w > ST7305_CHART_MAX_POINTS) ? ST7305_CHART_MAX_POINTS : w,
+                    (h > 256) ? 256 : h),
+      _min(min), _max(max), _cursor(0), _wrapped(false) {
+    memset(_level, 0, sizeof(_level));
+}
+
+/**
+ * Push - Draw a sample at the sweep position
+ *
+ * The damage covers the new column, the blank gap ahead of it and the
+ * column after the gap, whose line no longer starts from its left
+ * neighbour. At the right edge the gap restarts at the left edge, which
+ * is damaged separately (the union then spans the chart once per sweep).
+ */
+void ST7305_ChartStrip::push(int32_t value) {
+    st7305_rect_t b = getBounds();
+    if ((b.w <= 0) || (b.h <= 0)) {
+        return;
+    }
+    if (value < _min) value = _min;
+    if (value > _max) value = _max;
+    int32_t row = 0;
+    if (_max > _min) {
+        int64_t range = (int64_t)_max - _min;
+        row = (int32_t)(((int64_t)(_max - value) * (b.h - 1) + range / 2) / range);
+    }
+
+    int16_t column = _cursor;
+    _level[column] = row;
+    _cursor++;
+    invalidate(column, 0, ST7305_CHART_GAP + 2, b.h);
+    if (_cursor >= b.w) {
+        _cursor = 0;
+        _wrapped = true;
+        invalidate(0, 0, ST7305_CHART_GAP + 1, b.h);   // The gap moves to the left edge
+    }
+}
+
+/**
+ * Clear - No samples, whole chart damaged
+ */
+void ST7305_ChartStrip::clear() {
+    _cursor = 0;
+    _wrapped = false;
+    invalidate();
+}
+
+/**
+ * Draw - Background and the damaged columns
+ *
+ * Column x holds a sample if it was written and is not in the gap; it
+ * is drawn as a vertical span joining it to column x - 1.
+ */
+void ST7305_ChartStrip::draw(ST7305_Mono &display) {
+    st7305_rect_t d = getDamage();
+    display.fillRect(d.x, d.y, d.w, d.h, _bg);
+
+    for (int16_t x = d.x; x < d.x + d.w; x++) {
+        if (!hasSample(x)) {
+            continue;
+        }
+        int16_t y0 = _level[x];
+        int16_t y1 = y0;
+        if (hasSample(x - 1)) {
+            int16_t prev = _level[x - 1];
+            if (prev < y0) y0 = prev;
+            if (prev > y1) y1 = prev;
+        }
+        display.drawFastVLine(x, y0, y1 - y0 + 1, _fg);
+    }
+}
+
+/**
+ * Has Sample - Column was written and is not in the gap
+ */
+bool ST7305_ChartStrip::hasSample(int16_t x) const {
+    if ((x < 0) || (x >= getBounds().w)) {
+        return false;
+    }
+    if ((x >= _cursor) && (x < _cursor + ST7305_CHART_GAP)) {
+        return false;
+    }
+    return _wrapped || (x < _cursor);
+}
+
+// ===== ST7305_Icon =====
+
+/**
+ * Constructor
+ *
+ * @param bitmap 1bpp bitmap, or nullptr
+ */
+ST7305_Icon::ST7305_Icon(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *bitmap)
+    : ST7305_Widget(x, y, w, h), _bitmap(bitmap) {
+}
+
+/**
+ * Set Bitmap - Damage the icon if the bitmap changes
+ */
+void ST7305_Icon::setBitmap(const uint8_t *bitmap) {
+    if (bitmap != _bitmap) {
+        _bitmap = bitmap;
+        invalidate();
+    }
+}
+
+/**
+ * Draw - Opaque bitmap, or background only
+ */
+void ST7305_Icon::draw(ST7305_Mono &display) {
+    st7305_rect_t b = getBounds();
+    if (_bitmap) {
+        display.drawBitmap(0, 0, _bitmap, b.w, b.h, _fg, _bg);
+    } else {
+        display.fillRect(0, 0, b.w, b.h, _bg);
+    }
+}
+
+// ===== ST7305_WidgetScreen =====
+
+/**
+ * Constructor - No widgets
+ *
+ * @param display Output display
+ */
+ST7305_WidgetScreen::ST7305_WidgetScreen(ST7305_Mono &display)
+    : _display(display), _first(nullptr), _rectCount(0) {
+    memset(_rects, 0, sizeof(_rects));
+}
+
+/**
+ * Add - Append a widget (ignored if already added)
+ */
+void ST7305_WidgetScreen::add(ST7305_Widget &widget) {
+    ST7305_Widget **link = &_first;
+    while (*link) {
+        if (*link == &widget) {
+            return;
+        }
+        link = &(*link)->_next;
+    }
+    widget._next = nullptr;
+    widget.invalidate();
+    *link = &widget;
+}
+
+/**
+ * Remove - Unlink a widget
+ */
+void ST7305_WidgetScreen::remove(ST7305_Widget &widget) {
+    for (ST7305_Widget **link = &_first; *link; link = &(*link)->_next) {
+        if (*link == &widget) {
+            *link = widget._next;
+            widget._next = nullptr;
+            return;
+        }
+    }
+}
+
+/**
+ * Invalidate All - Damage every widget
+ */
+void ST7305_WidgetScreen::invalidateAll() {
+    for (ST7305_Widget *w = _first; w; w = w->_next) {
+        w->invalidate();
+    }
+}
+
+/**
+ * Render - Repaint damage and collect the windows to send
+ *
+ * @return Number of rectangles
+ */
+uint8_t ST7305_WidgetScreen::render() {
+    _rectCount = 0;
+    for (ST7305_Widget *w = _first; w; w = w->_next) {
+        if (!w->isDirty()) {
+            continue;
+        }
+        st7305_rect_t d = w->_damage;
+        if (_display.pushViewport(w->_bounds)) {
+            if (_display.pushClip(d)) {
+                w->draw(_display);
+                _display.popClip();
+            }
+            _display.popClip();
+        }
+
+        st7305_rect_t r = { (int16_t)(w->_bounds.x + d.x), (int16_t)(w->_bounds.y + d.y), d.w, d.h };
+        st7305_rect_t snapped;
+        if (st7305_snap_rect(_display.coverMirrors(r), snapped)) {
+            st7305_add_rect(_rects, _rectCount, ST7305_WIDGET_MAX_RECTS, snapped);
+        }
+        w->_damage.w = 0;
+        w->_damage.h = 0;
+    }
+    return _rectCount;
+}
+
+/**
+ * Update - Render and send the damaged windows
+ *
+ * @return Number of windows sent
+ */
+uint8_t ST7305_WidgetScreen::update() {
+    st7305_rect_t before = _display.getDirtyRect();
+    uint8_t count = render();
+    if (count == 0) {
+        return 0;
+    }
+    _display.displayFrame(_display.getBuffer(), _rects, count);
+    _display.clearDirty();
+    if ((before.w > 0) && (before.h > 0)) {
+        _display.invalidateRect(before.x, before.y, before.w, before.h);
+    }
+    return count;
+}
+
+/**
+ * Last Update Bytes - Pixel bytes covered by the last rectangles
+ */
+uint32_t ST7305_WidgetScreen::lastUpdateBytes() const {
+    uint32_t bytes = 0;
+    for (uint8_t i = 0; i < _rectCount; i++) {
+        bytes += (uint32_t)(_rects[i].w / ST7305_PIXELS_PER_COL) * ST7305_BYTES_PER_COL * (_rects[i].h / 2);
+    }
+    return bytes;
+}
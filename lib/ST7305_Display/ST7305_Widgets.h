@@ -0,0 +1,356 @@
+/**
+ * ST7305_Widgets.h
+ *
+ * Retained widgets for the ST7305 Monochrome Display Driver
+ *
+ * Instead of clearing and redrawing a whole screen for every change, a
+ * screen is built once from widgets that keep their own state: label,
+ * numeric readout, bar, chart strip and icon. Setting a value that does
+ * not change any pixel does nothing; otherwise the widget records the
+ * exact local rectangle that changes (the characters that differ, the
+ * part of a bar between old and new fill, the columns a chart sweeps).
+ *
+ * ST7305_WidgetScreen::update() repaints only those rectangles - each
+ * widget is drawn with the viewport set to its bounds and the clip set
+ * to its damage - and sends them with displayFrame() as a few small
+ * windowed RAMWRs. A 1 Hz telemetry screen with a few changing digits
+ * costs a few hundred bytes per update instead of 15KB.
+ *
+ * Usage:
+ *   ST7305_WidgetScreen screen(display);
+ *   ST7305_Label title(0, 0, 300, 16, "Telemetry", 2);
+ *   ST7305_Readout temp(0, 40, 150, 24, 1, " C", 3);   // 1 decimal
+ *   ST7305_Bar battery(0, 80, 300, 16, 0, 100);
+ *   ST7305_ChartStrip history(0, 120, 300, 80, -20, 60);
+ *   screen.add(title); screen.add(temp); screen.add(battery); screen.add(history);
+ *
+ *   void loop() {
+ *       temp.setValue(readTemperature());
+ *       battery.setValue(readBattery());
+ *       history.push(readTemperature());
+ *       screen.update();                  // Only the damaged rectangles
+ *       delay(1000);
+ *   }
+ *
+ * Notes:
+ * - Text widgets use the built-in 6x8 font scaled by their text size;
+ *   keep setFont() at the default while widgets are drawn.
+ * - Call update() in immediate mode with no clip or viewport pushed.
+ * - Widgets must not overlap; each one paints all of its bounds.
+ */
+
+#ifndef ST7305_WIDGETS_H
+#define ST7305_WIDGETS_H
+
+#include <Arduino.h>
+#include "ST7305_Mono.h"
+
+// Rectangles collected per update(); more are merged
+#define ST7305_WIDGET_MAX_RECTS   16
+
+// Characters kept by a label (longer text is cut)
+#define ST7305_LABEL_MAX_CHARS    32
+
+// Columns of a chart strip (one sample per column)
+#define ST7305_CHART_MAX_POINTS   ST7305_WIDTH
+
+// Blank columns kept ahead of the chart's sweep position
+#define ST7305_CHART_GAP          4
+
+/**
+ * Text alignment within a label's bounds
+ */
+typedef enum {
+    ST7305_ALIGN_LEFT = 0,
+    ST7305_ALIGN_CENTER,
+    ST7305_ALIGN_RIGHT
+} st7305_align_t;
+
+class ST7305_WidgetScreen;
+
+// ============================================================================
+// ST7305_Widget - Base Class
+// ============================================================================
+
+class ST7305_Widget {
+public:
+    /**
+     * Constructor
+     * @param x, y Top-left corner (absolute panel coordinates)
+     * @param w, h Size in pixels
+     */
+    ST7305_Widget(int16_t x, int16_t y, int16_t w, int16_t h);
+    virtual ~ST7305_Widget() {}
+
+    /**
+     * setColors - Foreground and background (repaints the widget)
+     */
+    void setColors(uint16_t fg, uint16_t bg);
+
+    /**
+     * invalidate - Repaint the whole widget on the next update()
+     */
+    void invalidate();
+
+    /**
+     * invalidate - Repaint part of the widget (local coordinates)
+     */
+    void invalidate(int16_t x, int16_t y, int16_t w, int16_t h);
+
+    st7305_rect_t getBounds() const { return _bounds; }
+    st7305_rect_t getDamage() const { return _damage; }   // Local, empty if clean
+    bool isDirty() const { return _damage.w > 0; }
+
+protected:
+    /**
+     * draw - Paint the widget in local coordinates
+     *
+     * Called with the viewport at the widget's bounds and the clip
+     * narrowed to its damage, so painting everything only writes the
+     * damaged pixels. Widgets with costly content can use getDamage()
+     * to skip the rest.
+     */
+    virtual void draw(ST7305_Mono &display) = 0;
+
+    uint16_t _fg, _bg;
+
+private:
+    friend class ST7305_WidgetScreen;
+
+    st7305_rect_t _bounds;
+    st7305_rect_t _damage;
+    ST7305_Widget *_next;           // Screen list
+};
+
+// ============================================================================
+// ST7305_Label - Single Line of Text
+// ============================================================================
+
+class ST7305_Label : public ST7305_Widget {
+public:
+    /**
+     * Constructor
+     * @param text  Initial text (copied)
+     * @param size  Text size (6 x 8 pixels per character at size 1)
+     * @param align Placement within the bounds (vertically centered)
+     */
+    ST7305_Label(int16_t x, int16_t y, int16_t w, int16_t h, const char *text = "",
+                 uint8_t size = 1, st7305_align_t align = ST7305_ALIGN_LEFT);
+
+    /**
+     * setText - Change the text
+     *
+     * Only character cells whose glyph or position changes are damaged,
+     * so "12:34" -> "12:35" repaints one character.
+     */
+    void setText(const char *text);
+    const char *getText() const { return _text; }
+
+protected:
+    void draw(ST7305_Mono &display) override;
+
+private:
+    char _text[ST7305_LABEL_MAX_CHARS + 1];
+    uint8_t _size;
+    st7305_align_t _align;
+
+    int16_t textX(size_t len) const;
+    int16_t textY() const;
+};
+
+// ============================================================================
+// ST7305_Readout - Fixed-Point Number with Unit
+// ============================================================================
+
+class ST7305_Readout : public ST7305_Label {
+public:
+    /**
+     * Constructor
+     * @param decimals Digits after the decimal point (0 .. 6)
+     * @param unit     Suffix such as " V" (not copied, may be nullptr)
+     */
+    ST7305_Readout(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t decimals = 0,
+                   const char *unit = nullptr, uint8_t size = 1,
+                   st7305_align_t align = ST7305_ALIGN_RIGHT);
+
+    /**
+     * setValue - Show value / 10^decimals (e.g. 1234 with 2 decimals = 12.34)
+     */
+    void setValue(int32_t scaled);
+
+    /**
+     * setValue - Show a float rounded to the readout's decimals
+     */
+    void setValue(float value);
+
+    int32_t getValue() const { return _value; }
+
+private:
+    const char *_unit;
+    uint8_t _decimals;
+    int32_t _value;
+    bool _valid;                    // A value has been set
+};
+
+// ============================================================================
+// ST7305_Bar - Filled Level Bar
+// ============================================================================
+
+class ST7305_Bar : public ST7305_Widget {
+public:
+    /**
+     * Constructor
+     * @param min, max Values shown as empty and full
+     * @param vertical Fill bottom-up instead of left to right
+     */
+    ST7305_Bar(int16_t x, int16_t y, int16_t w, int16_t h, int32_t min, int32_t max,
+               bool vertical = false);
+
+    /**
+     * setValue - Change the level (clamped to min .. max)
+     *
+     * Only the strip between the old and new fill is damaged; a value
+     * that rounds to the same fill does nothing.
+     */
+    void setValue(int32_t value);
+
+    void setRange(int32_t min, int32_t max);
+
+protected:
+    void draw(ST7305_Mono &display) override;
+
+private:
+    int32_t _min, _max, _value;
+    bool _vertical;
+    int16_t _fill;                  // Filled pixels along the bar
+
+    int16_t length() const;         // Inner length in pixels
+    int16_t fillFor(int32_t value) const;
+};
+
+// ============================================================================
+// ST7305_ChartStrip - Sweeping Line Chart
+// ============================================================================
+
+class ST7305_ChartStrip : public ST7305_Widget {
+public:
+    /**
+     * Constructor
+     * @param min, max Values at the bottom and top edge (h at most 256)
+     */
+    ST7305_ChartStrip(int16_t x, int16_t y, int16_t w, int16_t h, int32_t min, int32_t max);
+
+    /**
+     * push - Add a sample at the sweep position
+     *
+     * Like an ECG monitor, the chart is not scrolled: the new sample is
+     * drawn in the next column and ST7305_CHART_GAP columns ahead of it
+     * are blanked, wrapping to the left edge at the end. Each push
+     * damages only those few columns.
+     */
+    void push(int32_t value);
+
+    /**
+     * clear - Drop all samples
+     */
+    void clear();
+
+protected:
+    void draw(ST7305_Mono &display) override;
+
+private:
+    uint8_t _level[ST7305_CHART_MAX_POINTS];   // Row of each column's sample
+    int32_t _min, _max;
+    int16_t _cursor;                           // Next column to write
+    bool _wrapped;                             // Every column holds a sample
+
+    bool hasSample(int16_t x) const;
+};
+
+// ============================================================================
+// ST7305_Icon - 1bpp Bitmap
+// ============================================================================
+
+class ST7305_Icon : public ST7305_Widget {
+public:
+    /**
+     * Constructor
+     * @param bitmap Adafruit_GFX 1bpp bitmap of w x h (PROGMEM), or nullptr
+     */
+    ST7305_Icon(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *bitmap = nullptr);
+
+    /**
+     * setBitmap - Show another bitmap of the same size (nullptr = blank)
+     */
+    void setBitmap(const uint8_t *bitmap);
+
+protected:
+    void draw(ST7305_Mono &display) override;
+
+private:
+    const uint8_t *_bitmap;
+};
+
+// ============================================================================
+// ST7305_WidgetScreen - Widget List and Partial Flush
+// ============================================================================
+
+class ST7305_WidgetScreen {
+public:
+    /**
+     * Constructor
+     * @param display Initialized display (widgets draw into its buffer)
+     */
+    ST7305_WidgetScreen(ST7305_Mono &display);
+
+    /**
+     * add / remove - Widgets on this screen
+     *
+     * The widget is not copied and must stay alive while added. Adding
+     * damages the whole widget. Removing leaves its pixels in place.
+     */
+    void add(ST7305_Widget &widget);
+    void remove(ST7305_Widget &widget);
+
+    /**
+     * invalidateAll - Repaint every widget on the next update()
+     */
+    void invalidateAll();
+
+    /**
+     * render - Repaint damaged widgets into the frame buffer
+     *
+     * The damaged rectangles are snapped to the 12-pixel / 2-row RAM
+     * window grid and merged; send them yourself (e.g. through an
+     * ST7305_SPIBus) or use update().
+     *
+     * @return Number of rectangles (see getRects())
+     */
+    uint8_t render();
+
+    /**
+     * update - render() and send the rectangles
+     *
+     * The display's own dirty rectangle is left as it was before, so
+     * drawing done outside the widgets still goes out with the next
+     * displayDirty().
+     *
+     * @return Number of windows sent (0 if nothing changed)
+     */
+    uint8_t update();
+
+    /**
+     * Last render() / update()
+     */
+    const st7305_rect_t *getRects() const { return _rects; }
+    uint8_t getRectCount() const { return _rectCount; }
+    uint32_t lastUpdateBytes() const;   // Pixel bytes in the rectangles
+
+private:
+    ST7305_Mono &_display;
+    ST7305_Widget *_first;
+    st7305_rect_t _rects[ST7305_WIDGET_MAX_RECTS];
+    uint8_t _rectCount;
+};
+
+#endif // ST7305_WIDGETS_H
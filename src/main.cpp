@@ -1,5 +1,6 @@
 #include <Arduino.h>
 #include "ST7305_Mono.h"
+#include "ST7305_Widgets.h"
 
 // =======================================================
 // --- Pin Configuration for 4-wire SPI ---
@@ -112,11 +113,14 @@ void testFillScreen() {
 void testPixels() {
     display.clearDisplay();
     
-    // Draw random pixels
-    for (int i = 0; i < 1000; i++) {
-        int x = random(0, ST7305_WIDTH);
-        int y = random(0, ST7305_HEIGHT);
-        display.drawPixel(x, y, ST7305_WHITE);
+    // Draw random pixels in batches (one clipped pass, no per-pixel dirty update)
+    st7305_point_t points[100];
+    for (int batch = 0; batch < 10; batch++) {
+        for (int i = 0; i < 100; i++) {
+            points[i].x = random(0, ST7305_WIDTH);
+            points[i].y = random(0, ST7305_HEIGHT);
+        }
+        display.drawPixels(points, 100, ST7305_WHITE);
     }
     
     display.display();
@@ -158,6 +162,175 @@ void drawBitmap() {
     display.display();
 }
 
+void testTelemetry() {
+    display.clearDisplay();
+    display.display();
+    
+    // Built once; each update() only sends what changed
+    ST7305_WidgetScreen screen(display);
+    ST7305_Label title(0, 0, ST7305_WIDTH, 24, "Telemetry", 2, ST7305_ALIGN_CENTER);
+    ST7305_Readout uptime(0, 40, 140, 24, 0, " s", 2, ST7305_ALIGN_LEFT);
+    ST7305_Readout level(150, 40, 150, 24, 1, " %", 2);
+    ST7305_Bar bar(0, 80, ST7305_WIDTH, 16, 0, 1000);
+    ST7305_ChartStrip chart(0, 110, ST7305_WIDTH, 120, 0, 1000);
+    screen.add(title);
+    screen.add(uptime);
+    screen.add(level);
+    screen.add(bar);
+    screen.add(chart);
+    
+    for (int i = 0; i < 10; i++) {
+        int32_t value = random(0, 1001);
+        uptime.setValue((int32_t)(millis() / 1000));
+        level.setValue(value);
+        bar.setValue(value);
+        chart.push(value);
+        screen.update();
+        
+        Serial.print("  update: ");
+        Serial.print(screen.getRectCount());
+        Serial.print(" windows, ");
+        Serial.print(screen.lastUpdateBytes());
+        Serial.println(" bytes");
+        delay(1000);
+    }
+}
+
+void testFrameBudget() {
+    display.clearDisplay();
+    display.display();
+    
+    // A 20 Hz sampling loop that redraws its readout on every pass;
+    // present() decides what actually goes to the panel: at most 0.5 s
+    // late, about 2 KB/s on average, low power after 2 s without changes
+    st7305_frame_budget_t budget = { 500, 2000, 0, 2000, true };
+    display.setFrameBudget(budget);
+    display.setTextSize(3);
+    display.setTextColor(ST7305_WHITE, ST7305_BLACK);
+    
+    uint32_t sent = 0, deferred = 0, bytes = 0, energy = 0, switches = 0;
+    uint32_t start = millis();
+    while (millis() - start < 10000) {
+        if (millis() - start < 6000) {        // Then idle, to show the LPM switch
+            display.setCursor(60, 180);
+            display.print((millis() - start) / 100);   // Stand-in for a sensor reading
+            display.print("   ");
+        }
+        st7305_frame_report_t r = display.present();
+        if (r.action == ST7305_FRAME_DEFERRED) {
+            deferred++;
+        } else if (r.action != ST7305_FRAME_IDLE) {
+            sent++;
+        }
+        bytes += r.bytes;
+        energy += r.energyMicrojoules;
+        switches += r.modeChanged ? 1 : 0;
+        delay(50);                            // Sensor period
+    }
+    
+    Serial.print("  ");
+    Serial.print(sent);
+    Serial.print(" sent, ");
+    Serial.print(deferred);
+    Serial.print(" deferred, ");
+    Serial.print(bytes);
+    Serial.print(" bytes, ~");
+    Serial.print(energy / 1000);
+    Serial.print(" mJ, ");
+    Serial.print(switches);
+    Serial.println(" power mode switches");
+    
+    st7305_frame_budget_t none = { 0, 0, 0, 0, false };
+    display.setFrameBudget(none);
+    display.setHighPowerMode();
+    display.setTextSize(1);
+}
+
+void testMenuHighlight() {
+    static const char *items[] = { "Start", "Settings", "History", "Power off" };
+    display.clearDisplay();
+    display.setTextSize(2);
+    display.setTextColor(ST7305_WHITE);
+    for (uint8_t i = 0; i < 4; i++) {
+        display.setCursor(20, 60 + i * 30 + 7);
+        display.print(items[i]);
+    }
+    display.display();
+    
+    // The menu is drawn once; the highlight and the greyed-out item are
+    // applied on the way to the panel, so moving the selection only
+    // resends the rows it leaves and enters
+    display.addTransform(0, 60 + 3 * 30, 300, 30, ST7305_TRANSFORM_SET, ST7305_PATTERN_CHECKER);
+    int8_t highlight = display.addTransform(0, 60, 300, 30, ST7305_TRANSFORM_INVERT);
+    display.resetSpiStats();
+    for (uint8_t step = 1; step < 12; step++) {
+        delay(400);
+        display.moveTransform(highlight, 0, 60 + (step % 3) * 30, 300, 30);
+    }
+    
+    st7305_spi_stats_t stats = display.getSpiStats();
+    Serial.print("  11 moves: ");
+    Serial.print(stats.dataBytes);
+    Serial.println(" bytes");
+    
+    display.clearTransforms();
+    display.setTextSize(1);
+}
+
+void testTimeSliced() {
+    // A 2 ms sampling deadline while a busy screen is redrawn: the frame
+    // is recorded, then rendered and flushed a slice at a time between
+    // samples instead of holding loop() for the whole frame. Each circle
+    // and glyph is one command, so the ~50-command frame fits the list
+    uint32_t samples = 0, frames = 0, refused = 0, worstGap = 0;
+    uint32_t lastSample = micros();
+    uint32_t start = millis();
+    display.setTextSize(2);
+    display.setTextColor(ST7305_WHITE);
+    while (millis() - start < 5000) {
+        if (!display.isJobBusy()) {
+            display.beginRecording();
+            display.fillScreen(ST7305_BLACK);
+            for (uint8_t i = 0; i < 40; i++) {
+                display.drawCircle(150 + (int16_t)((i * 37 + frames * 5) % 120) - 60,
+                                   200 + (int16_t)((i * 53) % 160) - 80, 10 + i % 30, ST7305_WHITE);
+            }
+            display.setCursor(10, 10);
+            display.print(frames);
+            if (display.startRenderJob()) {
+                frames++;
+            } else {
+                refused++;                    // Overflowed: nothing drawn
+            }
+        }
+        display.stepJob(1500);                // Leaves ~0.5 ms of the period
+        
+        uint32_t now = micros();
+        if (now - lastSample > worstGap) {
+            worstGap = now - lastSample;
+        }
+        lastSample = now;
+        samples++;                            // Stand-in for reading a sensor
+        while (micros() - lastSample < 2000) {
+        }
+    }
+    display.finishJob();
+    
+    st7305_dl_stats_t st = display.getRecordingStats();
+    Serial.print("  ");
+    Serial.print(frames);
+    Serial.print(" frames of ");
+    Serial.print(st.commands);
+    Serial.print(" commands (");
+    Serial.print(refused);
+    Serial.print(" refused), ");
+    Serial.print(samples);
+    Serial.print(" samples, longest interval ");
+    Serial.print(worstGap);
+    Serial.println(" us");
+    display.setTextSize(1);
+}
+
 // =======================================================
 // --- Setup Function ---
 // =======================================================
@@ -171,13 +344,42 @@ void setup() {
     
     // Initialize display
     Serial.print("Initializing display... ");
-    if (!display.begin(1000000)) {  // 40 MHz SPI
+    if (!display.begin(1000000)) {  // 1 MHz bring-up clock, tuned below
         Serial.println("FAILED!");
         Serial.println("ERROR: Could not allocate frame buffer");
         while (1) delay(1000);
     }
     Serial.println("OK");
     
+    // Measure the candidate clocks and keep the fastest one whose ID
+    // readback still matches the one read at 1 MHz (the SAMD51 SERCOM
+    // tops out at 24 MHz). Without MISO wired, stay at the bring-up clock.
+    static const uint32_t spiClocks[] = { 1000000, 4000000, 8000000, 12000000, 24000000 };
+    uint32_t displayId = display.readDisplayId();
+    st7305_spi_calibration_t spi;
+    memset(&spi, 0, sizeof(spi));
+    if (displayId) {
+        spi = display.calibrateSpi(spiClocks, sizeof(spiClocks) / sizeof(spiClocks[0]),
+                                   ST7305_Mono::checkDisplayId, &displayId);
+        Serial.print("SPI: rejected ");
+        Serial.print(spi.rejected);
+        Serial.print(" of ");
+        Serial.print(sizeof(spiClocks) / sizeof(spiClocks[0]));
+        Serial.println(" clocks");
+    } else {
+        spi.config = display.getSpiConfig();
+        Serial.println("SPI: no ID readback (MISO not wired?), keeping the bring-up clock");
+    }
+    Serial.print("SPI: commands ");
+    Serial.print(spi.config.commandHz / 1000000);
+    Serial.print(" MHz, data ");
+    Serial.print(spi.config.dataHz / 1000000);
+    Serial.print(" MHz, chunk ");
+    Serial.print(spi.config.chunkBytes);
+    Serial.print(" bytes, ");
+    Serial.print(spi.bytesPerSecond / 1000);
+    Serial.println(" KB/s");
+    
     Serial.print("Display size: ");
     Serial.print(display.width());
     Serial.print(" x ");
@@ -236,6 +438,18 @@ void loop() {
     drawBitmap();
     delay(3000);
     
+    Serial.println("Test 8: Telemetry widgets");
+    testTelemetry();
+    
+    Serial.println("Test 9: Frame budget");
+    testFrameBudget();
+    
+    Serial.println("Test 10: Menu highlight");
+    testMenuHighlight();
+    
+    Serial.println("Test 11: Time-sliced rendering");
+    testTimeSliced();
+    
     Serial.println("--- Tests complete, restarting ---\n");
     delay(1000);
 }
\ No newline at end of file
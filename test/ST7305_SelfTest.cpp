@@ -0,0 +1,998 @@
+/**
+ * ST7305_SelfTest.cpp
+ *
+ * Differential self-test implementation
+ *
+ * One operation is generated from the PRNG into an Op and then applied
+ * to both targets by the same template, so the display and the
+ * reference canvas always see identical calls. Coordinates reach past
+ * the panel edges to exercise clipping.
+ */
+
+#include "ST7305_SelfTest.h"
+
+/**
+ * One generated draw call
+ */
+struct ST7305_SelfTest::Op {
+    uint16_t kind;                  // ST7305_TEST_* flag
+    uint8_t variant;                // Call within the kind
+    uint8_t sx, sy;                 // Scale factors or text size
+    uint8_t count;                  // Points or characters
+    int16_t x, y, w, h;             // Position and size, or line end points
+    int16_t x2, y2, r;              // Third triangle corner, radius (inner radius, thickness)
+    uint16_t color, bg;
+    uint16_t src;                   // Offset into the pattern or point pool
+    char text[ST7305_SELFTEST_TEXT];
+};
+
+// Variants of ST7305_TEST_RECORD
+#define ST7305_SELFTEST_RECORD_BEGIN  0
+#define ST7305_SELFTEST_RECORD_END    1
+
+// ============================================================================
+// ST7305_ReferenceCanvas
+// ============================================================================
+
+/**
+ * Constructor - Full-panel clip, origin (0,0)
+ *
+ * @param frame Buffer to draw into
+ */
+ST7305_ReferenceCanvas::ST7305_ReferenceCanvas(uint8_t *frame)
+    : Adafruit_GFX(ST7305_WIDTH, ST7305_HEIGHT), _frame(frame) {
+    resetClip();
+}
+
+/**
+ * Draw Pixel - Origin, clip, then the packed bit
+ */
+void ST7305_ReferenceCanvas::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    int32_t ax = (int32_t)x + _originX;
+    int32_t ay = (int32_t)y + _originY;
+    if ((ax < _clipX0) || (ax > _clipX1) || (ay < _clipY0) || (ay > _clipY1)) {
+        return;
+    }
+    x = ax;
+    y = ay;
+    uint32_t index = (uint32_t)(y / 2) * ST7305_BYTES_PER_ROW + x / 4;
+    uint8_t bit = 7 - ((x % 4) * 2 + (y % 2));
+    if (color) {
+        _frame[index] |= (1 << bit);
+    } else {
+        _frame[index] &= ~(1 << bit);
+    }
+}
+
+/**
+ * Draw Fast HLine / VLine - One-pixel-high / wide fillRect()
+ */
+void ST7305_ReferenceCanvas::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    fillRect(x, y, w, 1, color);
+}
+
+void ST7305_ReferenceCanvas::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    fillRect(x, y, 1, h, color);
+}
+
+/**
+ * Fill Rect - Normalize, then one drawPixel() per pixel
+ */
+void ST7305_ReferenceCanvas::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (w < 0) { x += w + 1; w = -w; }
+    if (h < 0) { y += h + 1; h = -h; }
+    for (int32_t j = y; j < (int32_t)y + h; j++) {
+        for (int32_t i = x; i < (int32_t)x + w; i++) {
+            drawPixel(i, j, color);
+        }
+    }
+}
+
+/**
+ * Draw Pixels - One drawPixel() per point
+ */
+void ST7305_ReferenceCanvas::drawPixels(const st7305_point_t *points, size_t count, uint16_t color) {
+    for (size_t i = 0; i < count; i++) {
+        drawPixel(points[i].x, points[i].y, color);
+    }
+}
+
+void ST7305_ReferenceCanvas::drawPixels(const st7305_point_t *points, const uint16_t *colors,
+                                        size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        drawPixel(points[i].x, points[i].y, colors[i]);
+    }
+}
+
+/**
+ * Draw Bitmap - Adafruit_GFX bitmap walk, transparent
+ */
+void ST7305_ReferenceCanvas::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                                        int16_t w, int16_t h, uint16_t color) {
+    int16_t byteWidth = (w + 7) / 8;
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            if (pgm_read_byte(&bitmap[j * byteWidth + i / 8]) & (0x80 >> (i & 7))) {
+                drawPixel(x + i, y + j, color);
+            }
+        }
+    }
+}
+
+/**
+ * Draw Bitmap - Opaque: clear bits drawn in bg
+ */
+void ST7305_ReferenceCanvas::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                                        int16_t w, int16_t h, uint16_t color, uint16_t bg) {
+    int16_t byteWidth = (w + 7) / 8;
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            bool set = pgm_read_byte(&bitmap[j * byteWidth + i / 8]) & (0x80 >> (i & 7));
+            drawPixel(x + i, y + j, set ? color : bg);
+        }
+    }
+}
+
+/**
+ * Draw Packed - Read each source pixel with the frame buffer mapping
+ */
+void ST7305_ReferenceCanvas::drawPacked(int16_t x, int16_t y, const uint8_t *data,
+                                        int16_t w, int16_t h) {
+    int16_t stride = (w + 3) / 4;
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            uint8_t b = data[(j / 2) * stride + i / 4];
+            drawPixel(x + i, y + j, (b >> (7 - ((i % 4) * 2 + (j % 2)))) & 1);
+        }
+    }
+}
+
+/**
+ * Draw Bitmap Scaled - One block per set bit
+ */
+void ST7305_ReferenceCanvas::drawBitmapScaled(int16_t x, int16_t y, const uint8_t bitmap[],
+                                              int16_t w, int16_t h, uint8_t scaleX,
+                                              uint8_t scaleY, uint16_t color) {
+    if ((scaleX < 1) || (scaleY < 1) || (scaleX > ST7305_MAX_SCALE) || (scaleY > ST7305_MAX_SCALE)) {
+        return;
+    }
+    int16_t byteWidth = (w + 7) / 8;
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            if (pgm_read_byte(&bitmap[j * byteWidth + i / 8]) & (0x80 >> (i & 7))) {
+                fillBlock(x + i * scaleX, y + j * scaleY, scaleX, scaleY, color);
+            }
+        }
+    }
+}
+
+/**
+ * Draw Bitmap Scaled - Opaque: one block per bit
+ */
+void ST7305_ReferenceCanvas::drawBitmapScaled(int16_t x, int16_t y, const uint8_t bitmap[],
+                                              int16_t w, int16_t h, uint8_t scaleX,
+                                              uint8_t scaleY, uint16_t color, uint16_t bg) {
+    if ((scaleX < 1) || (scaleY < 1) || (scaleX > ST7305_MAX_SCALE) || (scaleY > ST7305_MAX_SCALE)) {
+        return;
+    }
+    int16_t byteWidth = (w + 7) / 8;
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            bool set = pgm_read_byte(&bitmap[j * byteWidth + i / 8]) & (0x80 >> (i & 7));
+            fillBlock(x + i * scaleX, y + j * scaleY, scaleX, scaleY, set ? color : bg);
+        }
+    }
+}
+
+/**
+ * Draw Packed Scaled - One block per source pixel (set = white)
+ */
+void ST7305_ReferenceCanvas::drawPackedScaled(int16_t x, int16_t y, const uint8_t *data,
+                                              int16_t w, int16_t h, uint8_t scaleX,
+                                              uint8_t scaleY) {
+    if ((scaleX < 1) || (scaleY < 1) || (scaleX > ST7305_MAX_SCALE) || (scaleY > ST7305_MAX_SCALE)) {
+        return;
+    }
+    int16_t stride = (w + 3) / 4;
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            uint8_t b = data[(j / 2) * stride + i / 4];
+            fillBlock(x + i * scaleX, y + j * scaleY, scaleX, scaleY,
+                      (b >> (7 - ((i % 4) * 2 + (j % 2)))) & 1);
+        }
+    }
+}
+
+/**
+ * Fill Block - w x h drawPixel() calls
+ */
+void ST7305_ReferenceCanvas::fillBlock(int16_t x, int16_t y, uint8_t w, uint8_t h, uint16_t color) {
+    for (uint8_t j = 0; j < h; j++) {
+        for (uint8_t i = 0; i < w; i++) {
+            drawPixel(x + i, y + j, color);
+        }
+    }
+}
+
+/**
+ * Floor / Ceiling Division - Rounded toward -inf / +inf (den > 0)
+ */
+static int64_t floorDiv(int64_t num, int64_t den) {
+    int64_t q = num / den;
+    return ((num % den) < 0) ? q - 1 : q;
+}
+
+static int64_t ceilDiv(int64_t num, int64_t den) {
+    return -floorDiv(-num, den);
+}
+
+/**
+ * Fill Polygon - Integer vertices as 24.8
+ */
+void ST7305_ReferenceCanvas::fillPolygon(const st7305_point_t *points, uint8_t count,
+                                         uint16_t color) {
+    if ((count < 3) || (count > ST7305_MAX_POLY_POINTS)) {
+        return;
+    }
+    int32_t xs[ST7305_MAX_POLY_POINTS];
+    int32_t ys[ST7305_MAX_POLY_POINTS];
+    for (uint8_t i = 0; i < count; i++) {
+        xs[i] = (int32_t)points[i].x * 256;
+        ys[i] = (int32_t)points[i].y * 256;
+    }
+    fillOutline(xs, ys, count, color);
+}
+
+/**
+ * Draw Thick Line - The quad thickness/2 either side of the center line,
+ * half a pixel past both ends, corners rounded to 1/256 pixel
+ */
+void ST7305_ReferenceCanvas::drawThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                           uint8_t thickness, uint16_t color) {
+    if (thickness <= 1) {
+        drawLine(x0, y0, x1, y1, color);
+        return;
+    }
+    float dx = (float)(x1 - x0);
+    float dy = (float)(y1 - y0);
+    float len = sqrtf(dx * dx + dy * dy);
+    if (len == 0.0f) {
+        fillRect(x0 - thickness / 2, y0 - thickness / 2, thickness, thickness, color);
+        return;
+    }
+    float ux = dx / len * 256.0f;
+    float uy = dy / len * 256.0f;
+    float hw = thickness * 0.5f;
+    int32_t ex = (int32_t)lroundf(ux * 0.5f), ey = (int32_t)lroundf(uy * 0.5f);
+    int32_t nx = (int32_t)lroundf(-uy * hw), ny = (int32_t)lroundf(ux * hw);
+    int32_t ax = (int32_t)x0 * 256 - ex, ay = (int32_t)y0 * 256 - ey;
+    int32_t bx = (int32_t)x1 * 256 + ex, by = (int32_t)y1 * 256 + ey;
+    int32_t xs[4] = { ax + nx, bx + nx, bx - nx, ax - nx };
+    int32_t ys[4] = { ay + ny, by + ny, by - ny, ay - ny };
+    fillOutline(xs, ys, 4, color);
+}
+
+/**
+ * Fill Arc - Chords with under half a pixel of error, vertices rounded
+ * to 1/256 pixel, ST7305_MAX_ARC_SEGMENTS chords per outline
+ */
+void ST7305_ReferenceCanvas::fillArc(int16_t cx, int16_t cy, int16_t innerRadius,
+                                     int16_t outerRadius, int16_t startAngle, int16_t endAngle,
+                                     uint16_t color) {
+    if ((outerRadius <= 0) || (innerRadius < 0) || (innerRadius >= outerRadius)) {
+        return;
+    }
+    int32_t sweep = (int32_t)endAngle - startAngle;
+    if (sweep == 0) {
+        return;
+    }
+    if (sweep >= 360) {
+        sweep = 360;
+    } else {
+        while (sweep < 0) sweep += 360;
+    }
+
+    const float degToRad = 0.017453292f;
+    float maxStep = 2.0f * acosf(1.0f - 0.5f / (float)outerRadius);
+    int32_t segments = (int32_t)ceilf(sweep * degToRad / maxStep);
+    if (segments < 1) segments = 1;
+
+    int32_t xs[ST7305_MAX_POLY_POINTS];
+    int32_t ys[ST7305_MAX_POLY_POINTS];
+    for (int32_t first = 0; first < segments; first += ST7305_MAX_ARC_SEGMENTS) {
+        int32_t last = first + ST7305_MAX_ARC_SEGMENTS;
+        if (last > segments) last = segments;
+        uint8_t n = 0;
+        for (int32_t i = first; i <= last; i++) {
+            float a = (startAngle + (float)sweep * i / segments) * degToRad;
+            xs[n] = (int32_t)cx * 256 + (int32_t)lroundf(cosf(a) * outerRadius * 256.0f);
+            ys[n] = (int32_t)cy * 256 + (int32_t)lroundf(sinf(a) * outerRadius * 256.0f);
+            n++;
+        }
+        if (innerRadius > 0) {
+            for (int32_t i = last; i >= first; i--) {
+                float a = (startAngle + (float)sweep * i / segments) * degToRad;
+                xs[n] = (int32_t)cx * 256 + (int32_t)lroundf(cosf(a) * innerRadius * 256.0f);
+                ys[n] = (int32_t)cy * 256 + (int32_t)lroundf(sinf(a) * innerRadius * 256.0f);
+                n++;
+            }
+        } else if ((sweep < 360) || (segments > ST7305_MAX_ARC_SEGMENTS)) {
+            xs[n] = (int32_t)cx * 256;
+            ys[n] = (int32_t)cy * 256;
+            n++;
+        }
+        fillOutline(xs, ys, n, color);
+    }
+}
+
+/**
+ * Fill Outline - Even-odd test of every pixel center in the clip
+ *
+ * @param xs, ys Vertices in viewport coordinates, 24.8
+ */
+void ST7305_ReferenceCanvas::fillOutline(const int32_t *xs, const int32_t *ys, uint8_t count,
+                                         uint16_t color) {
+    int64_t cross[ST7305_MAX_POLY_POINTS];
+    for (int32_t y = _clipY0; y <= _clipY1; y++) {
+        // Crossings of this row, as the first pixel at or right of each
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t j = (i + 1 < count) ? i + 1 : 0;
+            int64_t ax = xs[i] + (int64_t)_originX * 256, ay = ys[i] + (int64_t)_originY * 256;
+            int64_t bx = xs[j] + (int64_t)_originX * 256, by = ys[j] + (int64_t)_originY * 256;
+            if (ay > by) {
+                int64_t t;
+                t = ax; ax = bx; bx = t;
+                t = ay; ay = by; by = t;
+            }
+            if ((y < ceilDiv(ay, 256)) || (y >= ceilDiv(by, 256))) {
+                continue;
+            }
+            int64_t x16 = ax * 256 + floorDiv((y * 256 - ay) * (bx - ax) * 256, by - ay);
+            cross[n++] = ceilDiv(x16, 65536);
+        }
+        if (n == 0) {
+            continue;
+        }
+        for (int32_t x = _clipX0; x <= _clipX1; x++) {
+            uint8_t left = 0;
+            for (uint8_t k = 0; k < n; k++) {
+                left += (cross[k] <= x) ? 1 : 0;
+            }
+            if (left & 1) {
+                drawPixel(x - _originX, y - _originY, color);
+            }
+        }
+    }
+}
+
+/**
+ * Push Clip - Same intersection as ST7305_Mono::pushClip()
+ */
+bool ST7305_ReferenceCanvas::pushClip(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (_clipDepth >= ST7305_CLIP_STACK_DEPTH) {
+        return false;
+    }
+    st7305_clip_t &saved = _clipStack[_clipDepth++];
+    saved.x0 = _clipX0;
+    saved.y0 = _clipY0;
+    saved.x1 = _clipX1;
+    saved.y1 = _clipY1;
+    saved.originX = _originX;
+    saved.originY = _originY;
+
+    int32_t x0 = (int32_t)x + _originX;
+    int32_t y0 = (int32_t)y + _originY;
+    int32_t x1 = x0 + w - 1;
+    int32_t y1 = y0 + h - 1;
+    if (x0 > _clipX0) _clipX0 = x0;
+    if (y0 > _clipY0) _clipY0 = y0;
+    if (x1 < _clipX1) _clipX1 = x1;
+    if (y1 < _clipY1) _clipY1 = y1;
+    return true;
+}
+
+bool ST7305_ReferenceCanvas::pushViewport(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (!pushClip(x, y, w, h)) {
+        return false;
+    }
+    _originX += x;
+    _originY += y;
+    return true;
+}
+
+void ST7305_ReferenceCanvas::popClip() {
+    if (_clipDepth == 0) {
+        return;
+    }
+    const st7305_clip_t &saved = _clipStack[--_clipDepth];
+    _clipX0 = saved.x0;
+    _clipY0 = saved.y0;
+    _clipX1 = saved.x1;
+    _clipY1 = saved.y1;
+    _originX = saved.originX;
+    _originY = saved.originY;
+}
+
+void ST7305_ReferenceCanvas::resetClip() {
+    _clipX0 = 0;
+    _clipY0 = 0;
+    _clipX1 = ST7305_WIDTH - 1;
+    _clipY1 = ST7305_HEIGHT - 1;
+    _originX = 0;
+    _originY = 0;
+    _clipDepth = 0;
+}
+
+// ============================================================================
+// ST7305_SelfTest
+// ============================================================================
+
+/**
+ * Constructor - Nothing allocated until begin()
+ *
+ * @param display Display under test
+ */
+ST7305_SelfTest::ST7305_SelfTest(ST7305_Mono &display)
+    : _display(display), _optimized(nullptr), _reference(nullptr), _canvas(nullptr),
+      _rng(1), _recordLeft(0), _savedBuffer(nullptr), _savedCursorX(0), _savedCursorY(0),
+      _recorded(false) {
+    memset(&_savedDirty, 0, sizeof(_savedDirty));
+}
+
+/**
+ * Begin - Allocate the display-side and reference buffers
+ *
+ * @return false if out of memory
+ */
+bool ST7305_SelfTest::begin() {
+    if (_optimized) {
+        return true;
+    }
+    _optimized = (uint8_t*)malloc(ST7305_BUFFER_SIZE);
+    _reference = (uint8_t*)malloc(ST7305_BUFFER_SIZE);
+    if (!_optimized || !_reference) {
+        end();
+        return false;
+    }
+    _canvas.setBuffer(_reference);
+    return true;
+}
+
+/**
+ * End - Free the buffers
+ */
+void ST7305_SelfTest::end() {
+    free(_optimized);
+    free(_reference);
+    _optimized = nullptr;
+    _reference = nullptr;
+    _canvas.setBuffer(nullptr);
+}
+
+/**
+ * Run - Apply random operations to both paths and compare after each
+ *
+ * Per operation: clear the dirty rectangle, draw on the display, check
+ * that the changed bits (display vs. the untouched reference) are all
+ * inside the dirty rectangle, draw on the reference, compare.
+ */
+st7305_selftest_result_t ST7305_SelfTest::run(uint32_t seed, uint32_t ops, uint16_t kinds) {
+    st7305_selftest_result_t result;
+    memset(&result, 0, sizeof(result));
+    result.seed = seed;
+    result.firstFailOp = UINT32_MAX;
+    result.firstFailByte = -1;
+    if (!start(seed, kinds)) {
+        return result;
+    }
+
+    Op op;
+    for (uint32_t i = 0; i < ops; i++) {
+        bool framed = (_recordLeft > 0);
+        generate(op, kinds);
+        framed = framed || (op.kind == ST7305_TEST_RECORD);
+
+        _display.clearDirty();
+        apply(_display, op);
+        bool dirtyOk = framed || dirtyCovers(_display.getDirtyRect());
+        apply(_canvas, op);
+        result.ops++;
+        if (_recordLeft > 0) {
+            continue;  // Display side is rasterized at the end of the run
+        }
+
+        int32_t diff = -1;
+        for (uint32_t b = 0; b < ST7305_BUFFER_SIZE; b++) {
+            if (_optimized[b] != _reference[b]) {
+                diff = b;
+                break;
+            }
+        }
+        if (!dirtyOk) {
+            result.dirtyMisses++;
+        }
+        if ((diff >= 0) || !dirtyOk) {
+            if (diff >= 0) {
+                result.failures++;
+                memcpy(_optimized, _reference, ST7305_BUFFER_SIZE);
+            }
+            if (result.firstFailOp == UINT32_MAX) {
+                result.firstFailOp = i;
+                result.firstFailKind = op.kind;
+                result.firstFailByte = diff;
+            }
+        }
+    }
+
+    if (_recordLeft > 0) {  // Close an open recorded run
+        _display.endRecording(false);
+        _recordLeft = 0;
+    }
+    finish();
+    return result;
+}
+
+/**
+ * Benchmark - Time batches of identical operations on both targets
+ */
+st7305_selftest_timing_t ST7305_SelfTest::benchmark(uint16_t kinds, uint32_t ops, uint32_t seed) {
+    st7305_selftest_timing_t timing;
+    memset(&timing, 0, sizeof(timing));
+    if (!start(seed, kinds)) {
+        return timing;
+    }
+
+    Op batch[ST7305_SELFTEST_BATCH];
+    while (timing.ops < ops) {
+        uint32_t n = ops - timing.ops;
+        if (n > ST7305_SELFTEST_BATCH) {
+            n = ST7305_SELFTEST_BATCH;
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            generate(batch[i], kinds);
+        }
+
+        uint32_t t0 = micros();
+        for (uint32_t i = 0; i < n; i++) {
+            apply(_canvas, batch[i]);
+        }
+        uint32_t t1 = micros();
+        for (uint32_t i = 0; i < n; i++) {
+            apply(_display, batch[i]);
+        }
+        uint32_t t2 = micros();
+        timing.referenceMicros += t1 - t0;
+        timing.optimizedMicros += t2 - t1;
+        timing.ops += n;
+    }
+
+    if (_recordLeft > 0) {
+        _display.endRecording(false);
+        _recordLeft = 0;
+    }
+    timing.matched = (memcmp(_optimized, _reference, ST7305_BUFFER_SIZE) == 0);
+    finish();
+    return timing;
+}
+
+/**
+ * Kind Name - Printable name of a ST7305_TEST_* flag
+ */
+const char *ST7305_SelfTest::kindName(uint16_t kind) {
+    switch (kind) {
+        case ST7305_TEST_PIXEL:  return "pixel";
+        case ST7305_TEST_PIXELS: return "pixels";
+        case ST7305_TEST_SPAN:   return "span";
+        case ST7305_TEST_RECT:   return "rect";
+        case ST7305_TEST_LINE:   return "line";
+        case ST7305_TEST_SHAPE:  return "shape";
+        case ST7305_TEST_BITMAP: return "bitmap";
+        case ST7305_TEST_PACKED: return "packed";
+        case ST7305_TEST_SCALED: return "scaled";
+        case ST7305_TEST_TEXT:   return "text";
+        case ST7305_TEST_CLIP:   return "clip";
+        case ST7305_TEST_RECORD: return "record";
+        case ST7305_TEST_FILL:   return "fill";
+        default:                 return "?";
+    }
+}
+
+/**
+ * Start - Save the display state, point it at the test buffer and seed
+ * both buffers and the source pools from the PRNG
+ *
+ * @return false without buffers, while recording or with no kinds
+ */
+bool ST7305_SelfTest::start(uint32_t seed, uint16_t &kinds) {
+    kinds &= ST7305_TEST_ALL;
+    if (!_optimized || _display.isRecording() || !kinds) {
+        return false;
+    }
+    _rng = seed ? seed : 1;
+    _recordLeft = 0;
+
+    _savedBuffer = _display.getBuffer();
+    _savedDirty = _display.getDirtyRect();
+    _savedCursorX = _display.getCursorX();
+    _savedCursorY = _display.getCursorY();
+    _display.setBuffer(_optimized);
+
+    if (kinds & ST7305_TEST_RECORD) {
+        if (_display.beginRecording()) {  // Allocates the display list
+            _display.endRecording(false);
+            _recorded = true;
+        } else {
+            kinds &= ~ST7305_TEST_RECORD;
+            if (!kinds) {
+                finish();
+                return false;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < ST7305_BUFFER_SIZE; i++) {
+        _optimized[i] = random32() >> 24;
+    }
+    memcpy(_reference, _optimized, ST7305_BUFFER_SIZE);
+    for (uint16_t i = 0; i < ST7305_SELFTEST_PATTERN; i++) {
+        _pattern[i] = random32() >> 24;
+    }
+    for (uint16_t i = 0; i < ST7305_SELFTEST_POINTS; i++) {
+        _points[i].x = random(-8, ST7305_WIDTH + 7);
+        _points[i].y = random(-8, ST7305_HEIGHT + 7);
+        _colors[i] = random32() >> 31;
+    }
+
+    _display.resetClip();
+    _canvas.resetClip();
+    return true;
+}
+
+/**
+ * Finish - Give the display its buffer, dirty rectangle and cursor back
+ */
+void ST7305_SelfTest::finish() {
+    _display.setBuffer(_savedBuffer);
+    _display.resetClip();
+    _display.setTextSize(1);
+    _display.setTextColor(ST7305_WHITE);
+    _display.setTextWrap(true);
+    _display.setCursor(_savedCursorX, _savedCursorY);
+    _display.clearDirty();
+    if (_savedDirty.w > 0) {
+        _display.invalidateRect(_savedDirty.x, _savedDirty.y, _savedDirty.w, _savedDirty.h);
+    }
+    if (_recorded) {  // Tile hashes describe test frames
+        _display.invalidateRecording();
+        _recorded = false;
+    }
+}
+
+/**
+ * Generate - Pick an enabled kind and fill in its parameters
+ *
+ * Sizes favor small primitives, with occasional large ones; positions
+ * reach past every edge. A recorded run is 1 to 8 operations long and
+ * is always closed by an end operation.
+ */
+void ST7305_SelfTest::generate(Op &op, uint16_t kinds) {
+    memset(&op, 0, sizeof(op));
+    if (_recordLeft == 1) {
+        op.kind = ST7305_TEST_RECORD;
+        op.variant = ST7305_SELFTEST_RECORD_END;
+        _recordLeft = 0;
+        return;
+    }
+
+    bool recording = (_recordLeft > 0);
+    if (recording) {  // Inside a recorded run: any other kind
+        kinds &= ~ST7305_TEST_RECORD;
+        if (!kinds) {
+            kinds = ST7305_TEST_ALL & ~ST7305_TEST_RECORD;
+        }
+    }
+    do {
+        op.kind = 1 << random(0, 12);
+    } while (!(kinds & op.kind));
+    if (_recordLeft > 0) {
+        _recordLeft--;
+    }
+
+    op.color = random32() >> 31;
+    op.bg = random32() >> 31;
+    op.x = random(-40, ST7305_WIDTH + 39);
+    op.y = random(-40, ST7305_HEIGHT + 39);
+    bool large = (random(0, 7) == 0);
+    op.w = large ? random(1, ST7305_WIDTH + 40) : random(1, 40);
+    op.h = large ? random(1, ST7305_HEIGHT + 40) : random(1, 40);
+
+    switch (op.kind) {
+        case ST7305_TEST_PIXELS:
+            op.variant = random(0, 1);
+            op.count = random(1, 64);
+            op.src = random(0, ST7305_SELFTEST_POINTS - op.count);
+            break;
+
+        case ST7305_TEST_SPAN:
+        case ST7305_TEST_RECT:
+            if (op.kind == ST7305_TEST_SPAN) {
+                op.variant = random(0, 1);
+            } else {
+                op.variant = random(0, 15);   // 0: fillRect, 1: drawRect, 2: fillScreen, 3: fill
+                if (op.variant > 3) {
+                    op.variant &= 1;
+                }
+            }
+            if (random(0, 7) == 0) {          // Empty and mirrored sizes
+                op.w = random(-40, 0);
+                op.h = random(-40, 0);
+            }
+            break;
+
+        case ST7305_TEST_LINE:
+            op.variant = random(0, 3);    // Any slope, horizontal, vertical, 45 degrees
+            op.w = random(-40, ST7305_WIDTH + 39);
+            op.h = random(-40, ST7305_HEIGHT + 39);
+            if (op.variant == 1) {
+                op.h = op.y;
+            } else if (op.variant == 2) {
+                op.w = op.x;
+            } else if (op.variant == 3) {
+                op.h = op.y + ((random32() & 1) ? (op.w - op.x) : (op.x - op.w));
+            }
+            break;
+
+        case ST7305_TEST_SHAPE:
+            op.variant = random(0, 4);    // draw/fillCircle, draw/fillTriangle, fillRoundRect
+            op.r = random(0, large ? 120 : 30);
+            op.x2 = random(-40, ST7305_WIDTH + 39);
+            op.y2 = random(-40, ST7305_HEIGHT + 39);
+            op.w = random(-40, ST7305_WIDTH + 39);
+            op.h = random(-40, ST7305_HEIGHT + 39);
+            if (op.variant == 4) {
+                op.w = random(1, 160);
+                op.h = random(1, 160);
+            }
+            break;
+
+        case ST7305_TEST_BITMAP:
+        case ST7305_TEST_PACKED:
+        case ST7305_TEST_SCALED:
+            op.variant = random(0, op.kind == ST7305_TEST_SCALED ? 2 : 1);
+            op.w = random(1, op.kind == ST7305_TEST_SCALED ? 24 : 40);
+            op.h = random(1, op.kind == ST7305_TEST_SCALED ? 24 : 40);
+            op.src = random(0, ST7305_SELFTEST_PATTERN - 256);
+            if ((op.kind == ST7305_TEST_PACKED) && op.variant) {  // Byte-aligned destination
+                op.x &= ~3;
+                op.y &= ~1;
+            }
+            op.sx = large ? random(0, ST7305_MAX_SCALE + 1) : random(1, 4);
+            op.sy = (random32() & 1) ? op.sx : (large ? random(0, ST7305_MAX_SCALE + 1) : random(1, 4));
+            break;
+
+        case ST7305_TEST_TEXT:
+            op.variant = random(0, 1);    // Transparent, opaque
+            op.sx = large ? random(1, ST7305_MAX_SCALE + 1) : random(1, 4);
+            op.sy = (random32() & 1) ? op.sx : random(1, 4);
+            op.count = random(1, ST7305_SELFTEST_TEXT);
+            op.r = random(0, 1);          // Wrap
+            for (uint8_t i = 0; i < op.count; i++) {
+                op.text[i] = (random(0, 15) == 0) ? '\n' : random(1, 255);
+            }
+            break;
+
+        case ST7305_TEST_CLIP:
+            op.variant = random(0, 7);    // pushClip, pushViewport, popClip x4, resetClip
+            if (op.variant == 1) {
+                op.x = random(0, ST7305_WIDTH - 1);
+                op.y = random(0, ST7305_HEIGHT - 1);
+            }
+            op.w = random(1, ST7305_WIDTH);
+            op.h = random(1, ST7305_HEIGHT);
+            break;
+
+        case ST7305_TEST_RECORD:
+            op.variant = ST7305_SELFTEST_RECORD_BEGIN;
+            _recordLeft = random(2, 9);
+            break;
+
+        case ST7305_TEST_FILL:
+            op.variant = random(0, 2);    // fillPolygon, drawThickLine, fillArc
+            if (op.variant == 0) {        // Pool points: concave and self-crossing
+                op.count = random(3, 12);
+                op.src = random(0, ST7305_SELFTEST_POINTS - op.count);
+            } else if (op.variant == 1) {
+                op.w = random(-40, ST7305_WIDTH + 39);
+                op.h = random(-40, ST7305_HEIGHT + 39);
+                op.r = random(0, 16);
+            } else {                      // A recorded run stays inside the vertex pool
+                op.r = random(1, recording ? 16 : (large ? 250 : 60));
+                op.x2 = (random(0, 3) == 0) ? 0 : random(0, op.r);
+                op.w = random(-400, 400);
+                op.h = random(-400, 400);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * Apply - Issue one operation to either target
+ */
+template <typename T>
+void ST7305_SelfTest::apply(T &t, const Op &op) {
+    const uint8_t *src = _pattern + op.src;
+    switch (op.kind) {
+        case ST7305_TEST_PIXEL:
+            t.drawPixel(op.x, op.y, op.color);
+            break;
+
+        case ST7305_TEST_PIXELS:
+            if (op.variant) {
+                t.drawPixels(_points + op.src, _colors + op.src, op.count);
+            } else {
+                t.drawPixels(_points + op.src, op.count, op.color);
+            }
+            break;
+
+        case ST7305_TEST_SPAN:
+            if (op.variant) {
+                t.drawFastVLine(op.x, op.y, op.h, op.color);
+            } else {
+                t.drawFastHLine(op.x, op.y, op.w, op.color);
+            }
+            break;
+
+        case ST7305_TEST_RECT:
+            switch (op.variant) {
+                case 0: t.fillRect(op.x, op.y, op.w, op.h, op.color); break;
+                case 1: t.drawRect(op.x, op.y, op.w, op.h, op.color); break;
+                case 2: t.fillScreen(op.color); break;
+                default: t.fill(*src); break;
+            }
+            break;
+
+        case ST7305_TEST_LINE:
+            t.drawLine(op.x, op.y, op.w, op.h, op.color);
+            break;
+
+        case ST7305_TEST_SHAPE:
+            switch (op.variant) {
+                case 0: t.drawCircle(op.x, op.y, op.r, op.color); break;
+                case 1: t.fillCircle(op.x, op.y, op.r, op.color); break;
+                case 2: t.drawTriangle(op.x, op.y, op.w, op.h, op.x2, op.y2, op.color); break;
+                case 3: t.fillTriangle(op.x, op.y, op.w, op.h, op.x2, op.y2, op.color); break;
+                default: t.fillRoundRect(op.x, op.y, op.w, op.h, op.r, op.color); break;
+            }
+            break;
+
+        case ST7305_TEST_BITMAP:
+            if (op.variant) {
+                t.drawBitmap(op.x, op.y, src, op.w, op.h, op.color, op.bg);
+            } else {
+                t.drawBitmap(op.x, op.y, src, op.w, op.h, op.color);
+            }
+            break;
+
+        case ST7305_TEST_PACKED:
+            t.drawPacked(op.x, op.y, src, op.w, op.h);
+            break;
+
+        case ST7305_TEST_SCALED:
+            switch (op.variant) {
+                case 0: t.drawBitmapScaled(op.x, op.y, src, op.w, op.h, op.sx, op.sy, op.color); break;
+                case 1: t.drawBitmapScaled(op.x, op.y, src, op.w, op.h, op.sx, op.sy, op.color, op.bg); break;
+                default: t.drawPackedScaled(op.x, op.y, src, op.w, op.h, op.sx, op.sy); break;
+            }
+            break;
+
+        case ST7305_TEST_TEXT:
+            t.setCursor(op.x, op.y);
+            t.setTextSize(op.sx, op.sy);
+            t.setTextWrap(op.r != 0);
+            if (op.variant) {
+                t.setTextColor(op.color, op.bg);
+            } else {
+                t.setTextColor(op.color);
+            }
+            for (uint8_t i = 0; i < op.count; i++) {
+                t.write((uint8_t)op.text[i]);
+            }
+            break;
+
+        case ST7305_TEST_CLIP:
+            switch (op.variant) {
+                case 0: t.pushClip(op.x, op.y, op.w, op.h); break;
+                case 1: t.pushViewport(op.x, op.y, op.w, op.h); break;
+                case 7: t.resetClip(); break;
+                default: t.popClip(); break;
+            }
+            break;
+
+        case ST7305_TEST_RECORD:
+            frame(t, op.variant == ST7305_SELFTEST_RECORD_BEGIN);
+            break;
+
+        case ST7305_TEST_FILL:
+            switch (op.variant) {
+                case 0: t.fillPolygon(_points + op.src, op.count, op.color); break;
+                case 1: t.drawThickLine(op.x, op.y, op.w, op.h, op.r, op.color); break;
+                default: t.fillArc(op.x, op.y, op.x2, op.r, op.w, op.h, op.color); break;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * Frame - Begin or end a recorded run
+ *
+ * The display records and rasterizes every tile at the end; a recorded
+ * frame starts from a black screen, so the reference clears at the
+ * start and draws as usual.
+ */
+void ST7305_SelfTest::frame(ST7305_Mono &display, bool begin) {
+    if (begin) {
+        display.invalidateRecording();
+        display.beginRecording();
+    } else {
+        display.endRecording(false);
+    }
+}
+
+void ST7305_SelfTest::frame(ST7305_ReferenceCanvas &canvas, bool begin) {
+    if (begin) {
+        canvas.fill(0x00);
+    }
+}
+
+/**
+ * Dirty Covers - Every bit the display changed lies inside dirty
+ *
+ * Run after the display drew and before the reference did, so the
+ * reference still holds the previous content.
+ */
+bool ST7305_SelfTest::dirtyCovers(const st7305_rect_t &dirty) const {
+    for (uint32_t i = 0; i < ST7305_BUFFER_SIZE; i++) {
+        uint8_t changed = _optimized[i] ^ _reference[i];
+        if (!changed) {
+            continue;
+        }
+        int16_t x = (i % ST7305_BYTES_PER_ROW) * 4;
+        int16_t y = (i / ST7305_BYTES_PER_ROW) * 2;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            if (!(changed & (0x80 >> bit))) {
+                continue;
+            }
+            int16_t px = x + bit / 2;
+            int16_t py = y + (bit & 1);
+            if ((px < dirty.x) || (px >= dirty.x + dirty.w) ||
+                (py < dirty.y) || (py >= dirty.y + dirty.h)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Random - xorshift32
+ */
+uint32_t ST7305_SelfTest::random32() {
+    _rng ^= _rng << 13;
+    _rng ^= _rng >> 17;
+    _rng ^= _rng << 5;
+    return _rng;
+}
+
+/**
+ * Random - Uniform in lo .. hi (inclusive)
+ */
+int16_t ST7305_SelfTest::random(int16_t lo, int16_t hi) {
+    return lo + (int16_t)(random32() % (uint32_t)(hi - lo + 1));
+}
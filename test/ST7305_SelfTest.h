@@ -0,0 +1,271 @@
+/**
+ * ST7305_SelfTest.h
+ *
+ * Differential self-test for the ST7305 Monochrome Display Driver
+ *
+ * The packed-layout kernels (span fills, line walk, batched pixels,
+ * bitmap, packed and scaled blits, glyph blits, recorded tiles) must set
+ * exactly the bits that drawPixel()'s mapping 7 - ((x%4)*2 + y%2) would.
+ * ST7305_ReferenceCanvas is a plain Adafruit_GFX canvas in the same
+ * layout that draws everything one pixel at a time, with the same clip
+ * and viewport rules; ST7305_SelfTest drives random primitive sequences
+ * through both and compares the frame buffers byte for byte after every
+ * operation. It also checks that every changed pixel lies inside the
+ * dirty rectangle, and times both paths over the same sequence so a
+ * speedup is measured rather than assumed.
+ *
+ * Runs on the board or on the host (test/CMakeLists.txt builds the
+ * driver against the stubs in test/stubs); a run is reproducible from
+ * its seed.
+ *
+ * Usage:
+ *   ST7305_SelfTest test(display);
+ *   if (test.begin()) {                       // 30KB of buffers
+ *       st7305_selftest_result_t r = test.run(1234, 5000);
+ *       if (r.failures) {
+ *           Serial.printf("op %lu (%s) differs at byte %ld\n", r.firstFailOp,
+ *                         ST7305_SelfTest::kindName(r.firstFailKind), r.firstFailByte);
+ *       }
+ *       st7305_selftest_timing_t t = test.benchmark(ST7305_TEST_TEXT, 500);
+ *       Serial.printf("text: %lu us vs %lu us\n", t.referenceMicros, t.optimizedMicros);
+ *       test.end();
+ *   }
+ *
+ * Notes:
+ * - Draws into its own buffers (setBuffer()); the display's buffer and
+ *   dirty rectangle are restored, the clip stack is reset and the text
+ *   settings are left at size 1, white, wrap on, cursor restored.
+ * - Don't run it while recording.
+ * - fillPolygon(), drawThickLine() and fillArc() have no Adafruit_GFX
+ *   counterpart; the reference tests each pixel center against the
+ *   outline instead (see ST7305_ReferenceCanvas::fillPolygon()).
+ */
+
+#ifndef ST7305_SELFTEST_H
+#define ST7305_SELFTEST_H
+
+#include <Arduino.h>
+#include "ST7305_Mono.h"
+
+// Operation kinds (combine with |)
+#define ST7305_TEST_PIXEL     0x0001  // drawPixel()
+#define ST7305_TEST_PIXELS    0x0002  // drawPixels(), one color and per point
+#define ST7305_TEST_SPAN      0x0004  // drawFastHLine(), drawFastVLine()
+#define ST7305_TEST_RECT      0x0008  // fillRect(), drawRect(), fillScreen(), fill()
+#define ST7305_TEST_LINE      0x0010  // drawLine(): any slope, flat, 45 degrees
+#define ST7305_TEST_SHAPE     0x0020  // Circles, triangles, rounded rects
+#define ST7305_TEST_BITMAP    0x0040  // drawBitmap(), transparent and opaque
+#define ST7305_TEST_PACKED    0x0080  // drawPacked(), aligned and unaligned
+#define ST7305_TEST_SCALED    0x0100  // drawBitmapScaled(), drawPackedScaled()
+#define ST7305_TEST_TEXT      0x0200  // print() with the built-in font, sizes 1 .. 17
+#define ST7305_TEST_CLIP      0x0400  // pushClip(), pushViewport(), popClip(), resetClip()
+#define ST7305_TEST_RECORD    0x0800  // Runs of operations drawn in recording mode
+#define ST7305_TEST_FILL      0x1000  // fillPolygon(), drawThickLine(), fillArc()
+#define ST7305_TEST_ALL       0x1FFF
+
+// Random source data: bitmap / packed bytes and points with colors
+#define ST7305_SELFTEST_PATTERN   512
+#define ST7305_SELFTEST_POINTS    128
+
+// Operations timed per batch by benchmark() (about 40 bytes of stack each)
+#define ST7305_SELFTEST_BATCH     16
+
+// Longest string drawn by one text operation
+#define ST7305_SELFTEST_TEXT      8
+
+/**
+ * Result of run()
+ */
+typedef struct {
+    uint32_t seed;
+    uint32_t ops;            // Operations run
+    uint32_t failures;       // Operations after which the buffers differed
+    uint32_t dirtyMisses;    // Operations that changed pixels outside the dirty rectangle
+    uint32_t firstFailOp;    // Index of the first failure (UINT32_MAX if none)
+    uint16_t firstFailKind;  // Its ST7305_TEST_* kind
+    int32_t firstFailByte;   // First buffer byte that differed (-1: dirty miss only)
+} st7305_selftest_result_t;
+
+/**
+ * Result of benchmark()
+ */
+typedef struct {
+    uint32_t ops;
+    uint32_t referenceMicros;  // Per-pixel canvas
+    uint32_t optimizedMicros;  // ST7305_Mono
+    bool matched;              // Buffers equal at the end
+} st7305_selftest_timing_t;
+
+// ============================================================================
+// ST7305_ReferenceCanvas - Per-Pixel Reference
+// ============================================================================
+
+class ST7305_ReferenceCanvas : public Adafruit_GFX {
+public:
+    /**
+     * Constructor
+     * @param frame ST7305_BUFFER_SIZE bytes in the native layout (not copied, may be set later)
+     */
+    ST7305_ReferenceCanvas(uint8_t *frame);
+
+    /**
+     * drawPixel - The reference mapping; everything else ends up here
+     *
+     * Viewport origin and clip as in ST7305_Mono::drawPixel(), then
+     * bit 7 - ((x%4)*2 + y%2) of byte (y/2)*75 + x/4.
+     */
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+
+    /**
+     * Spans one pixel at a time, sizes as in ST7305_Mono
+     *
+     * Negative sizes are normalized and zero draws nothing (the
+     * Adafruit_GFX defaults draw two pixels for a zero-length line).
+     */
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+
+    /**
+     * Per-pixel versions of the ST7305_Mono additions
+     */
+    void drawPixels(const st7305_point_t *points, size_t count, uint16_t color);
+    void drawPixels(const st7305_point_t *points, const uint16_t *colors, size_t count);
+
+    using Adafruit_GFX::drawBitmap;
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h,
+                    uint16_t color);
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h,
+                    uint16_t color, uint16_t bg);
+    void drawPacked(int16_t x, int16_t y, const uint8_t *data, int16_t w, int16_t h);
+    void drawBitmapScaled(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h,
+                          uint8_t scaleX, uint8_t scaleY, uint16_t color);
+    void drawBitmapScaled(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h,
+                          uint8_t scaleX, uint8_t scaleY, uint16_t color, uint16_t bg);
+    void drawPackedScaled(int16_t x, int16_t y, const uint8_t *data, int16_t w, int16_t h,
+                          uint8_t scaleX, uint8_t scaleY);
+    void fill(uint8_t data) { memset(_frame, data, ST7305_BUFFER_SIZE); }
+
+    /**
+     * Filled outlines as a per-pixel predicate
+     *
+     * A pixel is set when its center is inside the outline by the
+     * even-odd rule. On row y an edge from (ax,ay) to (bx,by) (24.8,
+     * ay < by, rows ceil(ay) .. ceil(by)-1) crosses at X rounded down to
+     * 16.16, and counts for pixel x when that X rounded up is <= x: the
+     * scanline engine's exact rule, evaluated pixel by pixel with no
+     * spans, sorting or row-pairs. drawThickLine() and fillArc() build
+     * their documented outlines (a quad, chords of the arc) and test
+     * them the same way.
+     */
+    void fillPolygon(const st7305_point_t *points, uint8_t count, uint16_t color);
+    void drawThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t thickness,
+                       uint16_t color);
+    void fillArc(int16_t cx, int16_t cy, int16_t innerRadius, int16_t outerRadius,
+                 int16_t startAngle, int16_t endAngle, uint16_t color);
+
+    /**
+     * Clip stack with ST7305_Mono semantics
+     */
+    bool pushClip(int16_t x, int16_t y, int16_t w, int16_t h);
+    bool pushViewport(int16_t x, int16_t y, int16_t w, int16_t h);
+    void popClip();
+    void resetClip();
+
+    uint8_t *getBuffer() { return _frame; }
+    void setBuffer(uint8_t *frame) { _frame = frame; }
+
+private:
+    uint8_t *_frame;
+    int16_t _clipX0, _clipY0, _clipX1, _clipY1;    // Absolute, inclusive
+    int16_t _originX, _originY;
+    st7305_clip_t _clipStack[ST7305_CLIP_STACK_DEPTH];
+    uint8_t _clipDepth;
+
+    void fillBlock(int16_t x, int16_t y, uint8_t w, uint8_t h, uint16_t color);
+    void fillOutline(const int32_t *xs, const int32_t *ys, uint8_t count, uint16_t color);
+};
+
+// ============================================================================
+// ST7305_SelfTest - Differential Fuzzer and Benchmark
+// ============================================================================
+
+class ST7305_SelfTest {
+public:
+    /**
+     * Constructor
+     * @param display Display whose kernels are tested (begin() not required)
+     */
+    ST7305_SelfTest(ST7305_Mono &display);
+    ~ST7305_SelfTest() { end(); }
+
+    /**
+     * begin - Allocate the two test frame buffers
+     * @return false if out of memory
+     */
+    bool begin();
+
+    /**
+     * end - Free the buffers
+     */
+    void end();
+
+    /**
+     * run - Fuzz the chosen kinds against the reference
+     *
+     * Both buffers start from the same random content. After every
+     * operation the buffers are compared; on a difference the failure
+     * is counted and the reference is copied over so the run goes on
+     * from a common state. Operations inside a recorded run are
+     * compared once, after endRecording().
+     *
+     * @param seed  PRNG seed (0 is replaced by 1)
+     * @param ops   Number of operations
+     * @param kinds ST7305_TEST_* flags
+     */
+    st7305_selftest_result_t run(uint32_t seed, uint32_t ops, uint16_t kinds = ST7305_TEST_ALL);
+
+    /**
+     * benchmark - Time the same operations on both paths
+     *
+     * Operations are generated ST7305_SELFTEST_BATCH at a time and each
+     * batch is timed on the reference, then on the display, so the
+     * random generator is not in the measurement.
+     */
+    st7305_selftest_timing_t benchmark(uint16_t kinds, uint32_t ops, uint32_t seed = 1);
+
+    /**
+     * kindName - Name of one ST7305_TEST_* flag ("pixel", "text", ...)
+     */
+    static const char *kindName(uint16_t kind);
+
+private:
+    struct Op;
+
+    ST7305_Mono &_display;
+    uint8_t *_optimized;
+    uint8_t *_reference;
+    ST7305_ReferenceCanvas _canvas;
+    uint32_t _rng;
+    uint8_t _recordLeft;            // Operations left in the recorded run (0: immediate)
+    uint8_t _pattern[ST7305_SELFTEST_PATTERN];
+    st7305_point_t _points[ST7305_SELFTEST_POINTS];
+    uint16_t _colors[ST7305_SELFTEST_POINTS];
+    uint8_t *_savedBuffer;          // Display state kept across run() / benchmark()
+    st7305_rect_t _savedDirty;
+    int16_t _savedCursorX, _savedCursorY;
+    bool _recorded;                 // Tile hashes were changed
+
+    bool start(uint32_t seed, uint16_t &kinds);
+    void finish();
+    void generate(Op &op, uint16_t kinds);
+    template <typename T> void apply(T &target, const Op &op);
+    static void frame(ST7305_Mono &display, bool begin);           // Recorded run
+    static void frame(ST7305_ReferenceCanvas &canvas, bool begin);
+    bool dirtyCovers(const st7305_rect_t &dirty) const;
+
+    uint32_t random32();
+    int16_t random(int16_t lo, int16_t hi);   // Inclusive
+};
+
+#endif // ST7305_SELFTEST_H
@@ -0,0 +1,165 @@
+/**
+ * host_test.h - Shared helpers for the host tests
+ *
+ * HOST_CHECK() counts and prints failures; hostResult() turns the count
+ * into the exit code. hostRnd() is a seeded xorshift32, so every run of a
+ * test draws the same sequence; hostScribble() damages a display with it.
+ *
+ * HostPanel decodes the captured SPI log (see hostSpiCapture()) the way the
+ * controller would: CASET and RASET set the window, RAMWR streams data
+ * into it row-pair by row-pair. The RAM is kept in the frame buffer
+ * layout, so it can be compared with a buffer directly. Every RAMWR is
+ * also listed with its window and byte count for bounds checks.
+ */
+
+#ifndef ST7305_HOST_TEST_H
+#define ST7305_HOST_TEST_H
+
+#include <ST7305_Mono.h>
+#include <SPI.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+static uint32_t hostFailures = 0;
+
+#define HOST_CHECK(cond, ...)                                              \
+    do {                                                                   \
+        if (!(cond)) {                                                     \
+            hostFailures++;                                                \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__);                    \
+            printf(__VA_ARGS__);                                           \
+            printf("\n");                                                  \
+        }                                                                  \
+    } while (0)
+
+/**
+ * Host Result - Print the verdict and return the exit code
+ */
+static inline int hostResult() {
+    printf(hostFailures ? "FAIL (%lu)\n" : "OK\n", (unsigned long)hostFailures);
+    return hostFailures ? 1 : 0;
+}
+
+static uint32_t hostRng = 0x9E3779B9;
+
+/**
+ * Host Seed - Restart hostRnd() (each test picks its own seed)
+ */
+static inline void hostSeed(uint32_t seed) {
+    hostRng = seed ? seed : 1;
+}
+
+/**
+ * Host Rnd - Next pseudo-random number in lo..hi (inclusive)
+ */
+static inline int32_t hostRnd(int32_t lo, int32_t hi) {
+    hostRng ^= hostRng << 13;
+    hostRng ^= hostRng >> 17;
+    hostRng ^= hostRng << 5;
+    return lo + (int32_t)(hostRng % (uint32_t)(hi - lo + 1));
+}
+
+/**
+ * Host Scribble - 1 to 4 black or white rectangles up to maxSize pixels
+ * on a side, some partly off the panel
+ */
+static inline void hostScribble(ST7305_Mono &display, int16_t maxSize) {
+    for (int i = hostRnd(1, 4); i > 0; i--) {
+        int16_t x = hostRnd(-10, ST7305_WIDTH), y = hostRnd(-10, ST7305_HEIGHT);
+        int16_t w = hostRnd(1, maxSize), h = hostRnd(1, maxSize);
+        display.fillRect(x, y, w, h, hostRnd(0, 1));
+    }
+}
+
+/**
+ * Host On Grid - Rect snapped to the RAM window grid (st7305_snap_rect())
+ */
+static inline bool hostOnGrid(const st7305_rect_t &r) {
+    return (r.x % ST7305_PIXELS_PER_COL == 0) && (r.y % 2 == 0) && (r.h % 2 == 0) &&
+           ((r.w % ST7305_PIXELS_PER_COL == 0) || (r.x + r.w == ST7305_WIDTH));
+}
+
+/**
+ * Host Overlap - Rects share at least one pixel
+ */
+static inline bool hostOverlap(const st7305_rect_t &a, const st7305_rect_t &b) {
+    return (a.x < b.x + b.w) && (b.x < a.x + a.w) && (a.y < b.y + b.h) && (b.y < a.y + a.h);
+}
+
+/**
+ * One RAMWR as seen on the wire
+ */
+struct HostWindow {
+    int col0, col1;     // Columns (12 pixels each), 0-based
+    int pair0, pair1;   // Row-pairs
+    uint32_t bytes;     // Data bytes written
+};
+
+class HostPanel {
+public:
+    HostPanel() { memset(ram, 0, sizeof(ram)); }
+
+    /**
+     * Decode - Apply a captured log (with DC levels) to the RAM
+     */
+    void decode(const std::vector<HostSpiByte> &log) {
+        windows.clear();
+        for (const HostSpiByte &b : log) {
+            if (!b.dc) {
+                _cmd = b.data;
+                _param = 0;
+                if (_cmd == ST7305_RAMWR) {
+                    HostWindow w = { _col0, _col1, _pair0, _pair1, 0 };
+                    windows.push_back(w);
+                    _col = _col0;
+                    _pair = _pair0;
+                    _byte = 0;
+                }
+                continue;
+            }
+            if (_cmd == ST7305_CASET) {
+                int v = b.data - ST7305_COL_ADDR_START;
+                if (_param++ == 0) _col0 = v; else _col1 = v;
+            } else if (_cmd == ST7305_RASET) {
+                int v = b.data - ST7305_ROW_ADDR_START;
+                if (_param++ == 0) _pair0 = v; else _pair1 = v;
+            } else if ((_cmd == ST7305_RAMWR) && (_pair <= _pair1)) {
+                uint32_t idx = (uint32_t)_pair * ST7305_BYTES_PER_ROW + _col * ST7305_BYTES_PER_COL + _byte;
+                if (idx < ST7305_BUFFER_SIZE) {
+                    ram[idx] = b.data;
+                }
+                windows.back().bytes++;
+                if (++_byte == ST7305_BYTES_PER_COL) {
+                    _byte = 0;
+                    if (++_col > _col1) {
+                        _col = _col0;
+                        _pair++;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Capture - Decode everything fn() puts on the wire
+     */
+    template <typename F>
+    void capture(int dcPin, F fn) {
+        hostSpiCapture(true, dcPin);
+        fn();
+        hostSpiCapture(false);
+        decode(hostSpiLog());
+    }
+
+    uint8_t ram[ST7305_BUFFER_SIZE];
+    std::vector<HostWindow> windows;
+
+private:
+    uint8_t _cmd = 0;
+    uint8_t _param = 0;
+    int _col0 = 0, _col1 = 0, _pair0 = 0, _pair1 = 0;
+    int _col = 0, _pair = 0, _byte = 0;
+};
+
+#endif // ST7305_HOST_TEST_H
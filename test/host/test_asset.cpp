@@ -0,0 +1,283 @@
+/**
+ * test_asset.cpp - Assets from tools/st7305_asset.py on the device side
+ *
+ * Decodes one asset made by the converter and checks it against the
+ * image it was made from:
+ * - draw() at random positions, with and without a viewport, sets
+ *   exactly the visible image pixels (padding never reaches the buffer)
+ *   and keeps them inside getDirtyRect()
+ * - stream() writes the padded image into the grid-snapped window, also
+ *   partly or wholly off the panel, and leaves the rest of the RAM and
+ *   the frame buffer alone
+ * - a truncated payload makes both fail without reading past its end
+ *
+ * Usage: test_asset <image.pbm> <asset.sa> <pad 0|1>
+ * (test_asset.py makes the images and runs the converter)
+ */
+
+#include "host_test.h"
+#include <ST7305_Asset.h>
+#include <memory>
+
+#define DC_PIN 9
+#define CS_PIN 10
+
+static int16_t imageW, imageH;
+static std::vector<uint8_t> image;   // 1 = white, row-major
+
+static bool getBit(const uint8_t *frame, int x, int y) {
+    return frame[(y / 2) * ST7305_BYTES_PER_ROW + x / 4] & (0x80 >> ((x % 4) * 2 + (y % 2)));
+}
+
+static void setBit(uint8_t *frame, int x, int y, bool white) {
+    uint8_t bit = 0x80 >> ((x % 4) * 2 + (y % 2));
+    uint8_t &b = frame[(y / 2) * ST7305_BYTES_PER_ROW + x / 4];
+    b = white ? (b | bit) : (b & ~bit);
+}
+
+static int32_t floorDiv(int32_t value, int32_t divisor) {
+    return (value >= 0) ? (value / divisor) : -((divisor - 1 - value) / divisor);
+}
+
+static bool readFile(const char *path, std::vector<uint8_t> &data) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return false;
+    }
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        data.insert(data.end(), chunk, chunk + n);
+    }
+    fclose(f);
+    return true;
+}
+
+/**
+ * Load PBM - P4 with a plain "P4\n<w> <h>\n" header, 1 = black
+ */
+static bool loadPbm(const char *path) {
+    std::vector<uint8_t> data;
+    int w = 0, h = 0, used = 0;
+    if (!readFile(path, data) || (data.size() < 2) || (data[0] != 'P') || (data[1] != '4')) {
+        return false;
+    }
+    data.push_back(0);
+    if ((sscanf((const char*)data.data() + 2, " %d %d%n", &w, &h, &used) != 2) || (w < 1) || (h < 1)) {
+        return false;
+    }
+    size_t pos = 2 + used + 1;
+    size_t stride = (w + 7) / 8;
+    if (pos + stride * h > data.size() - 1) {
+        return false;
+    }
+    imageW = w;
+    imageH = h;
+    image.assign((size_t)w * h, 0);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            image[(size_t)y * w + x] = !((data[pos + y * stride + x / 8] >> (7 - x % 8)) & 1);
+        }
+    }
+    return true;
+}
+
+/**
+ * Pattern - Fill the buffer with a known picture to draw over
+ */
+static void pattern(ST7305_Mono &display) {
+    uint8_t *buf = display.getBuffer();
+    for (uint32_t i = 0; i < ST7305_BUFFER_SIZE; i++) {
+        buf[i] = (uint8_t)(i * 37 + (i >> 7));
+    }
+}
+
+/**
+ * Draw - One draw() at x, y, optionally inside a viewport, checked pixel
+ * by pixel against the image
+ */
+static void testDraw(ST7305_Mono &display, ST7305_AssetDecoder &decoder, const uint8_t *asset,
+                     int16_t x, int16_t y, const st7305_rect_t *viewport, int round) {
+    static uint8_t want[ST7305_BUFFER_SIZE], before[ST7305_BUFFER_SIZE];
+    pattern(display);
+    memcpy(before, display.getBuffer(), ST7305_BUFFER_SIZE);
+    memcpy(want, before, ST7305_BUFFER_SIZE);
+    int32_t ox = 0, oy = 0;
+    int32_t cx0 = 0, cy0 = 0, cx1 = ST7305_WIDTH - 1, cy1 = ST7305_HEIGHT - 1;
+    if (viewport) {
+        display.pushViewport(*viewport);
+        ox = viewport->x;
+        oy = viewport->y;
+        cx0 = (viewport->x > 0) ? viewport->x : 0;
+        cy0 = (viewport->y > 0) ? viewport->y : 0;
+        cx1 = (viewport->x + viewport->w - 1 < cx1) ? viewport->x + viewport->w - 1 : cx1;
+        cy1 = (viewport->y + viewport->h - 1 < cy1) ? viewport->y + viewport->h - 1 : cy1;
+    }
+    for (int j = 0; j < imageH; j++) {
+        for (int i = 0; i < imageW; i++) {
+            int32_t px = ox + x + i, py = oy + y + j;
+            if ((px >= cx0) && (px <= cx1) && (py >= cy0) && (py <= cy1)) {
+                setBit(want, px, py, image[(size_t)j * imageW + i]);
+            }
+        }
+    }
+
+    display.clearDirty();
+    bool ok = decoder.draw(asset, x, y);
+    if (viewport) {
+        display.popClip();
+    }
+    HOST_CHECK(ok, "draw %d at %d,%d failed", round, x, y);
+    HOST_CHECK((decoder.width() == imageW) && (decoder.height() == imageH), "asset is %ux%u, image %dx%d",
+               decoder.width(), decoder.height(), imageW, imageH);
+
+    const uint8_t *buf = display.getBuffer();
+    st7305_rect_t dirty = display.getDirtyRect();
+    uint32_t bad = 0, outside = 0;
+    for (int py = 0; py < ST7305_HEIGHT; py++) {
+        for (int px = 0; px < ST7305_WIDTH; px++) {
+            bool got = getBit(buf, px, py);
+            bad += (got != getBit(want, px, py));
+            if ((got != getBit(before, px, py)) &&
+                ((px < dirty.x) || (px >= dirty.x + dirty.w) || (py < dirty.y) || (py >= dirty.y + dirty.h))) {
+                outside++;
+            }
+        }
+    }
+    HOST_CHECK(bad == 0, "draw %d at %d,%d%s: %lu pixels differ from the image", round, x, y,
+               viewport ? " in a viewport" : "", (unsigned long)bad);
+    HOST_CHECK(outside == 0, "draw %d: %lu pixels outside the dirty rect", round, (unsigned long)outside);
+}
+
+/**
+ * Stream - One stream() at x, y, checked against the panel RAM model
+ */
+static void testStream(ST7305_Mono &display, ST7305_AssetDecoder &decoder, HostPanel &panel,
+                       const uint8_t *asset, int16_t x, int16_t y, bool pad, int round) {
+    static uint8_t want[ST7305_BUFFER_SIZE], before[ST7305_BUFFER_SIZE];
+    pattern(display);
+    panel.capture(DC_PIN, [&]() { display.display(); });
+    memcpy(before, display.getBuffer(), ST7305_BUFFER_SIZE);
+    memcpy(want, panel.ram, ST7305_BUFFER_SIZE);
+
+    int32_t wx = floorDiv(x, ST7305_PIXELS_PER_COL) * ST7305_PIXELS_PER_COL;
+    int32_t wy = floorDiv(y, 2) * 2;
+    int32_t padW = (imageW + ST7305_PIXELS_PER_COL - 1) / ST7305_PIXELS_PER_COL * ST7305_PIXELS_PER_COL;
+    int32_t padH = (imageH + 1) / 2 * 2;
+    bool visible = false;
+    for (int32_t j = 0; j < padH; j++) {
+        for (int32_t i = 0; i < padW; i++) {
+            int32_t px = wx + i, py = wy + j;
+            if ((px < 0) || (px >= ST7305_WIDTH) || (py < 0) || (py >= ST7305_HEIGHT)) {
+                continue;
+            }
+            visible = true;
+            bool white = ((i < imageW) && (j < imageH)) ? image[(size_t)j * imageW + i] : pad;
+            setBit(want, px, py, white);
+        }
+    }
+
+    bool ok = false;
+    panel.capture(DC_PIN, [&]() { ok = decoder.stream(asset, x, y); });
+    HOST_CHECK(ok, "stream %d at %d,%d failed", round, x, y);
+    HOST_CHECK(panel.windows.size() == (visible ? 1u : 0u), "stream %d at %d,%d: %zu RAMWRs", round, x, y,
+               panel.windows.size());
+    uint32_t bad = 0;
+    for (uint32_t i = 0; i < ST7305_BUFFER_SIZE; i++) {
+        bad += (panel.ram[i] != want[i]);
+    }
+    HOST_CHECK(bad == 0, "stream %d at %d,%d: %lu RAM bytes differ", round, x, y, (unsigned long)bad);
+    HOST_CHECK(memcmp(display.getBuffer(), before, ST7305_BUFFER_SIZE) == 0,
+               "stream %d touched the frame buffer", round);
+}
+
+/**
+ * Truncated - Cut the payload short (header length to match) in a
+ * buffer of exactly that size; both paths must fail. stream() only
+ * decodes row-pairs on the panel, so the last one is placed on it.
+ */
+static void testTruncated(ST7305_AssetDecoder &decoder, HostPanel &panel, const std::vector<uint8_t> &asset) {
+    uint32_t payload = (uint32_t)asset.size() - ST7305_ASSET_HEADER;
+    int16_t bottom = ST7305_HEIGHT - (imageH + 1) / 2 * 2;   // Last row-pair on the panel
+    const uint32_t cuts[] = { 0, 1, payload / 2, payload - 1 };
+    for (uint32_t keep : cuts) {
+        if (keep >= payload) {
+            continue;
+        }
+        size_t size = ST7305_ASSET_HEADER + keep;
+        std::unique_ptr<uint8_t[]> cut(new uint8_t[size]);
+        memcpy(cut.get(), asset.data(), size);
+        for (int i = 0; i < 4; i++) {
+            cut[8 + i] = (uint8_t)(keep >> (8 * i));
+        }
+        HOST_CHECK(!decoder.draw(cut.get(), 0, 0), "draw of a payload cut to %lu bytes succeeded",
+                   (unsigned long)keep);
+        bool ok = true;
+        panel.capture(DC_PIN, [&]() { ok = decoder.stream(cut.get(), 0, bottom); });
+        HOST_CHECK(!ok, "stream of a payload cut to %lu bytes succeeded", (unsigned long)keep);
+        HOST_CHECK(hostPinLevel(CS_PIN) == HIGH, "stream of a cut payload left CS low");
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc != 4) {
+        printf("usage: test_asset <image.pbm> <asset.sa> <pad 0|1>\n");
+        return 1;
+    }
+    hostSeed(0x7FEB352D);
+    std::vector<uint8_t> file;
+    HOST_CHECK(loadPbm(argv[1]), "reading %s", argv[1]);
+    HOST_CHECK(readFile(argv[2], file) && (file.size() > ST7305_ASSET_HEADER), "reading %s", argv[2]);
+    if (hostFailures) {
+        return hostResult();
+    }
+    bool pad = (argv[3][0] == '1');
+    std::unique_ptr<uint8_t[]> asset(new uint8_t[file.size()]);   // Exact size: overreads trip ASan
+    memcpy(asset.get(), file.data(), file.size());
+
+    ST7305_Mono display(DC_PIN, 8, CS_PIN);
+    if (!display.begin(1000000)) {
+        printf("FAIL: begin\n");
+        return 1;
+    }
+    ST7305_AssetDecoder decoder(display);
+    HostPanel panel;
+
+    // draw(): corners, byte-aligned, unaligned, off the panel
+    testDraw(display, decoder, asset.get(), 0, 0, nullptr, 0);
+    testDraw(display, decoder, asset.get(), ST7305_WIDTH - imageW, ST7305_HEIGHT - imageH, nullptr, 1);
+    for (int round = 2; round < 40; round++) {
+        int16_t x = hostRnd(-imageW, ST7305_WIDTH), y = hostRnd(-imageH, ST7305_HEIGHT);
+        if (round % 3 == 0) {
+            x &= ~3;
+            y &= ~1;
+        }
+        testDraw(display, decoder, asset.get(), x, y, nullptr, round);
+    }
+    for (int round = 0; round < 40; round++) {
+        st7305_rect_t viewport;
+        viewport.x = hostRnd(-50, ST7305_WIDTH - 1);
+        viewport.y = hostRnd(-50, ST7305_HEIGHT - 1);
+        viewport.w = hostRnd(1, ST7305_WIDTH);
+        viewport.h = hostRnd(1, ST7305_HEIGHT);
+        int16_t x = hostRnd(-imageW, viewport.w), y = hostRnd(-imageH, viewport.h);
+        testDraw(display, decoder, asset.get(), x, y, &viewport, round);
+    }
+
+    // stream(): snapped, partly off each edge, wholly off the panel
+    const int16_t spots[][2] = {
+        { 0, 0 }, { 5, 3 }, { ST7305_WIDTH - 30, -7 }, { -30, ST7305_HEIGHT - 9 },
+        { (int16_t)(1 - imageW), (int16_t)(1 - imageH) }, { ST7305_WIDTH, 0 }, { 0, (int16_t)(-imageH - 2) },
+    };
+    int round = 0;
+    for (const int16_t *spot : spots) {
+        testStream(display, decoder, panel, asset.get(), spot[0], spot[1], pad, round++);
+    }
+    for (; round < 30; round++) {
+        testStream(display, decoder, panel, asset.get(), hostRnd(-imageW, ST7305_WIDTH + 20),
+                   hostRnd(-imageH, ST7305_HEIGHT + 20), pad, round);
+    }
+
+    testTruncated(decoder, panel, file);
+    return hostResult();
+}
@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""
+test_asset.py - tools/st7305_asset.py against the device decoder
+
+Writes test images as PBM, converts each with the tool (run-length and
+--raw, black and white padding, P4 and P1 input) and runs test_asset on
+every pair. test_asset checks draw() and stream() against the image and
+that a truncated payload is rejected. Also checks that the tool refuses
+an image wider than the panel.
+
+Usage: test_asset.py <test_asset binary> <st7305_asset.py>
+"""
+
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+failures = 0
+
+
+def check(cond, message):
+    global failures
+    if not cond:
+        failures += 1
+        print('FAIL: %s' % message)
+
+
+def make_image(rng, width, height, style):
+    """Rows of 0/1 (1 = white): solid blocks compress, noise does not."""
+    if style == 'noise':
+        return [[rng.randint(0, 1) for _ in range(width)] for _ in range(height)]
+    rows = [[0] * width for _ in range(height)]
+    for _ in range(rng.randint(1, 8)):
+        x0, y0 = rng.randrange(width), rng.randrange(height)
+        x1, y1 = rng.randint(x0, width - 1), rng.randint(y0, height - 1)
+        color = rng.randint(0, 1)
+        for y in range(y0, y1 + 1):
+            for x in range(x0, x1 + 1):
+                rows[y][x] = color
+    for _ in range(width * height // 50):
+        rows[rng.randrange(height)][rng.randrange(width)] ^= 1
+    return rows
+
+
+def write_p4(path, width, height, rows):
+    stride = (width + 7) // 8
+    out = bytearray(b'P4\n%d %d\n' % (width, height))
+    for row in rows:
+        line = bytearray(stride)
+        for x, white in enumerate(row):
+            if not white:
+                line[x >> 3] |= 0x80 >> (x & 7)
+        out += line
+    with open(path, 'wb') as f:
+        f.write(out)
+
+
+def write_p1(path, width, height, rows):
+    lines = ['P1', '# test image', '%d %d' % (width, height)]
+    lines += [' '.join('0' if white else '1' for white in row) for row in rows]
+    with open(path, 'w') as f:
+        f.write('\n'.join(lines) + '\n')
+
+
+def tool(script, *args):
+    result = subprocess.run([sys.executable, script] + list(args), capture_output=True, text=True)
+    return result.returncode, result.stdout + result.stderr
+
+
+def main():
+    binary, script = sys.argv[1], sys.argv[2]
+    rng = random.Random(0x5A17)
+    cases = [
+        (1, 1, 'blocks'), (5, 3, 'noise'), (12, 2, 'blocks'), (13, 7, 'noise'), (77, 133, 'blocks'),
+        (120, 41, 'noise'), (300, 400, 'blocks'), (300, 450, 'blocks'), (299, 401, 'noise'),
+    ]
+    with tempfile.TemporaryDirectory() as tmp:
+        for n, (width, height, style) in enumerate(cases):
+            rows = make_image(rng, width, height, style)
+            image = os.path.join(tmp, 'image_%d.pbm' % n)
+            write_p4(image, width, height, rows)
+            source = image
+            if n % 2:
+                source = os.path.join(tmp, 'image_%d_p1.pbm' % n)
+                write_p1(source, width, height, rows)
+
+            for variant, extra, pad in (('rle', [], '0'), ('raw', ['--raw'], '0'),
+                                        ('white', ['--pad', 'white'], '1')):
+                asset = os.path.join(tmp, 'asset_%d_%s.sa' % (n, variant))
+                code, out = tool(script, source, '--format', 'bin', '-o', asset, *extra)
+                check(code == 0, '%dx%d %s: tool exit %d: %s' % (width, height, variant, code, out))
+                if code:
+                    continue
+                result = subprocess.run([binary, image, asset, pad], capture_output=True, text=True)
+                check(result.returncode == 0, '%dx%d %s %s:\n%s' % (width, height, style, variant,
+                                                                     result.stdout + result.stderr))
+
+        wide = os.path.join(tmp, 'wide.pbm')
+        write_p4(wide, 301, 2, [[1] * 301] * 2)
+        code, out = tool(script, wide, '--format', 'bin', '-o', os.path.join(tmp, 'wide.sa'))
+        check(code != 0 and 'panel maximum' in out, 'tool took a 301-pixel wide image: %s' % out)
+
+    print('FAIL (%d)' % failures if failures else 'OK')
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
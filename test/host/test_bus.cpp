@@ -0,0 +1,152 @@
+/**
+ * test_bus.cpp - Shared SPI bus with two panels
+ *
+ * Two displays with their own CS pins (shared DC) are flushed through
+ * one ST7305_SPIBus. Every byte must be sent with exactly one CS low,
+ * every service() call must send at most one chunk (one RAMWR within
+ * the chunk size) and leave both CS high, panels with work must take
+ * turns, and each panel's RAM must end up equal to its frame buffer.
+ */
+
+#include "host_test.h"
+#include <ST7305_Bus.h>
+
+#define DC_PIN   9
+#define CS_LEFT  10
+#define CS_RIGHT 11
+
+/**
+ * Split - Hand each captured byte to the panel whose CS was low
+ *
+ * @return Panel that got the bytes (0 or 1), -1 if nothing was sent,
+ *         2 if both got some, 3 if a byte went to both or neither
+ */
+static int split(const std::vector<HostSpiByte> &log, HostPanel *panels) {
+    std::vector<HostSpiByte> part[2];
+    int who = -1;
+    for (const HostSpiByte &b : log) {
+        int i = (b.selected == 1) ? 0 : (b.selected == 2) ? 1 : 2;
+        if (i == 2) {
+            return 3;
+        }
+        part[i].push_back(b);
+        who = (who < 0) ? i : (who == i) ? i : 2;
+    }
+    panels[0].decode(part[0]);
+    panels[1].decode(part[1]);
+    return who;
+}
+
+struct YieldCheck {
+    uint32_t calls;
+    uint32_t held;   // Calls with a CS still low
+};
+
+static void onYield(void *context) {
+    YieldCheck *check = (YieldCheck*)context;
+    check->calls++;
+    if ((hostPinLevel(CS_LEFT) == LOW) || (hostPinLevel(CS_RIGHT) == LOW)) {
+        check->held++;
+    }
+}
+
+int main() {
+    hostSeed(0x27D4EB2F);
+    ST7305_Mono left(DC_PIN, 8, CS_LEFT), right(DC_PIN, 7, CS_RIGHT);
+    if (!left.begin(1000000) || !right.begin(1000000)) {
+        printf("FAIL: begin\n");
+        return 1;
+    }
+    ST7305_Mono *displays[2] = { &left, &right };
+    HostPanel panels[2];
+    hostSpiWatchCs({ CS_LEFT, CS_RIGHT });
+
+    ST7305_SPIBus bus;
+    HOST_CHECK(bus.attach(left) && bus.attach(right), "attach");
+    HOST_CHECK(!bus.attach(left), "attached twice");
+
+    // Both panels in full, then random damage
+    for (int round = 0; round < 60; round++) {
+        uint16_t chunk = hostRnd(75, 3000);
+        bus.setChunkSize(chunk);
+        bool full = (round == 0);
+        hostScribble(left, 150);
+        hostScribble(right, 30);
+        bus.requestFlush(left, full);
+        bus.requestFlush(right, full);
+
+        std::vector<int> order;
+        bool more = true;
+        while (more) {
+            hostSpiCapture(true, DC_PIN);
+            more = bus.service();
+            hostSpiCapture(false);
+            int who = split(hostSpiLog(), panels);
+            HOST_CHECK(who != 3, "round %d: bytes with both or no CS low", round);
+            HOST_CHECK(who != 2, "round %d: both panels served in one service()", round);
+            HOST_CHECK((hostPinLevel(CS_LEFT) == HIGH) && (hostPinLevel(CS_RIGHT) == HIGH),
+                       "round %d: bus held after service()", round);
+            if ((who < 0) || (who > 1)) {
+                continue;
+            }
+            order.push_back(who);
+            const std::vector<HostWindow> &windows = panels[who].windows;
+            HOST_CHECK(windows.size() == 1, "round %d: %zu RAMWRs in one service()", round, windows.size());
+            for (const HostWindow &win : windows) {
+                HOST_CHECK((win.bytes <= chunk) || (win.pair0 == win.pair1),
+                           "round %d: chunk of %lu bytes, limit %u", round, (unsigned long)win.bytes, chunk);
+            }
+        }
+
+        // Round-robin: while both have chunks left they alternate
+        size_t lastOf[2] = { 0, 0 };
+        for (size_t i = 0; i < order.size(); i++) {
+            lastOf[order[i]] = i;
+        }
+        size_t both = (lastOf[0] < lastOf[1]) ? lastOf[0] : lastOf[1];
+        for (size_t i = 1; i <= both; i++) {
+            HOST_CHECK(order[i] != order[i - 1], "round %d: panel %d served twice in a row at chunk %zu",
+                       round, order[i], i);
+        }
+        for (int p = 0; p < 2; p++) {
+            HOST_CHECK(memcmp(panels[p].ram, displays[p]->getBuffer(), ST7305_BUFFER_SIZE) == 0,
+                       "round %d: panel %d differs from its buffer", round, p);
+        }
+    }
+
+    // flush(): yields between chunks with the bus released; counters add up
+    YieldCheck check = { 0, 0 };
+    bus.setYieldCallback(onYield, &check);
+    bus.setChunkSize(ST7305_BUS_CHUNK_BYTES);
+    bus.resetStats();
+    bus.requestFlush(left, true);
+    bus.requestFlush(right, true);
+    hostSpiCapture(true, DC_PIN);
+    bus.flush();
+    hostSpiCapture(false);
+    HOST_CHECK(split(hostSpiLog(), panels) == 2, "flush() served only one panel");
+    st7305_bus_stats_t stats = bus.getStats();
+    uint32_t ramwr = 0, pixels = 0;
+    for (int p = 0; p < 2; p++) {
+        for (const HostWindow &win : panels[p].windows) {
+            ramwr++;
+            pixels += win.bytes;
+        }
+    }
+    HOST_CHECK((stats.chunks == ramwr) && (stats.bytes == pixels) && (stats.flushes == 2),
+               "stats %lu chunks, %lu bytes, %lu flushes; wire %lu, %lu", (unsigned long)stats.chunks,
+               (unsigned long)stats.bytes, (unsigned long)stats.flushes, (unsigned long)ramwr,
+               (unsigned long)pixels);
+    HOST_CHECK(pixels == 2 * ST7305_BUFFER_SIZE, "full flushes sent %lu bytes", (unsigned long)pixels);
+    HOST_CHECK(check.calls + 1 >= stats.chunks, "%lu yields for %lu chunks", (unsigned long)check.calls,
+               (unsigned long)stats.chunks);
+    HOST_CHECK(check.held == 0, "%lu yields with the bus held", (unsigned long)check.held);
+    HOST_CHECK(!bus.busy(), "busy after flush()");
+
+    // detach() drops the pending flush
+    hostScribble(right, 50);
+    bus.requestFlush(right, true);
+    bus.detach(right);
+    HOST_CHECK(!bus.busy() && !bus.requestFlush(right), "detached panel still queued");
+    return hostResult();
+}
@@ -0,0 +1,247 @@
+/**
+ * test_fill.cpp - Scanline fill engine properties
+ *
+ * The self-test fuzzes fillPolygon(), drawThickLine() and fillArc()
+ * against the per-pixel reference; this test covers what a random mix
+ * rarely hits:
+ * - a jittered triangle mesh over the panel covers every pixel exactly
+ *   once (top-left rule: shared edges neither overlap nor leave gaps)
+ * - complementary arcs (start..s, s..start + 360) do not overlap
+ * - vertices far outside the panel, up to the int16 limits
+ * - degenerate input: zero-area, collinear, repeated vertices, too few
+ *   or too many points
+ * - a line of thickness 0 or 1 is drawLine()
+ * Every case is also compared with the reference, and every pixel set
+ * must lie inside getDirtyRect().
+ */
+
+#include "host_test.h"
+#include "ST7305_SelfTest.h"
+
+#define GRID_X 12
+#define GRID_Y 10
+
+static bool getBit(const uint8_t *frame, int x, int y) {
+    return frame[(y / 2) * ST7305_BYTES_PER_ROW + x / 4] & (0x80 >> ((x % 4) * 2 + (y % 2)));
+}
+
+static uint8_t refFrame[ST7305_BUFFER_SIZE];
+static ST7305_ReferenceCanvas reference(refFrame);
+
+/**
+ * Compare - Clear both, draw, then check against the reference and the
+ * dirty rectangle
+ *
+ * @return false on a difference
+ */
+template <typename F>
+static bool compare(ST7305_Mono &display, const char *what, int index, F draw) {
+    memset(display.getBuffer(), 0, ST7305_BUFFER_SIZE);
+    memset(refFrame, 0, ST7305_BUFFER_SIZE);
+    display.clearDirty();
+    draw(display, reference);
+
+    const uint8_t *buf = display.getBuffer();
+    uint32_t bad = 0;
+    for (uint32_t i = 0; i < ST7305_BUFFER_SIZE; i++) {
+        bad += (buf[i] != refFrame[i]);
+    }
+    HOST_CHECK(bad == 0, "%s %d: %lu bytes differ from the reference", what, index, (unsigned long)bad);
+
+    st7305_rect_t dirty = display.getDirtyRect();
+    uint32_t outside = 0;
+    for (int y = 0; y < ST7305_HEIGHT; y++) {
+        for (int x = 0; x < ST7305_WIDTH; x++) {
+            if (getBit(buf, x, y) &&
+                ((x < dirty.x) || (x >= dirty.x + dirty.w) || (y < dirty.y) || (y >= dirty.y + dirty.h))) {
+                outside++;
+            }
+        }
+    }
+    HOST_CHECK(outside == 0, "%s %d: %lu pixels outside the dirty rect", what, index, (unsigned long)outside);
+    return (bad == 0) && (outside == 0);
+}
+
+static bool isEmpty(ST7305_Mono &display) {
+    for (uint32_t i = 0; i < ST7305_BUFFER_SIZE; i++) {
+        if (display.getBuffer()[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Accumulate - Add the set pixels of the buffer to per-pixel counts
+ */
+static void accumulate(const uint8_t *buf, uint8_t *counts) {
+    for (int y = 0; y < ST7305_HEIGHT; y++) {
+        for (int x = 0; x < ST7305_WIDTH; x++) {
+            counts[y * ST7305_WIDTH + x] += getBit(buf, x, y);
+        }
+    }
+}
+
+/**
+ * Mesh - Jittered grid over (and past) the panel, two triangles per cell
+ */
+static void testMesh(ST7305_Mono &display) {
+    static uint8_t counts[ST7305_WIDTH * ST7305_HEIGHT];
+    for (int round = 0; round < 3; round++) {
+        st7305_point_t grid[GRID_Y + 1][GRID_X + 1];
+        for (int j = 0; j <= GRID_Y; j++) {
+            for (int i = 0; i <= GRID_X; i++) {
+                int16_t x = -20 + i * (ST7305_WIDTH + 40) / GRID_X;
+                int16_t y = -20 + j * (ST7305_HEIGHT + 40) / GRID_Y;
+                bool edge = (i == 0) || (j == 0) || (i == GRID_X) || (j == GRID_Y);
+                grid[j][i].x = edge ? x : x + hostRnd(-8, 8);
+                grid[j][i].y = edge ? y : y + hostRnd(-8, 8);
+            }
+        }
+        memset(counts, 0, sizeof(counts));
+        int index = 0;
+        for (int j = 0; j < GRID_Y; j++) {
+            for (int i = 0; i < GRID_X; i++) {
+                st7305_point_t a[3] = { grid[j][i], grid[j][i + 1], grid[j + 1][i + 1] };
+                st7305_point_t b[3] = { grid[j][i], grid[j + 1][i + 1], grid[j + 1][i] };
+                for (const st7305_point_t *tri : { a, b }) {
+                    compare(display, "mesh", index++, [&](ST7305_Mono &d, ST7305_ReferenceCanvas &r) {
+                        d.fillPolygon(tri, 3, ST7305_WHITE);
+                        r.fillPolygon(tri, 3, ST7305_WHITE);
+                    });
+                    accumulate(display.getBuffer(), counts);
+                }
+            }
+        }
+        uint32_t gaps = 0, overlaps = 0;
+        for (uint32_t i = 0; i < sizeof(counts); i++) {
+            gaps += (counts[i] == 0);
+            overlaps += (counts[i] > 1);
+        }
+        HOST_CHECK((gaps == 0) && (overlaps == 0), "mesh %d: %lu gaps, %lu overlaps", round,
+                   (unsigned long)gaps, (unsigned long)overlaps);
+    }
+}
+
+/**
+ * Arcs - start..s and s..start + 360 share two edges but no pixel
+ */
+static void testArcs(ST7305_Mono &display) {
+    static uint8_t counts[ST7305_WIDTH * ST7305_HEIGHT];
+    for (int round = 0; round < 40; round++) {
+        int16_t cx = hostRnd(-50, ST7305_WIDTH + 50), cy = hostRnd(-50, ST7305_HEIGHT + 50);
+        int16_t outer = hostRnd(1, 250), inner = hostRnd(0, 1) ? 0 : hostRnd(0, outer);
+        int16_t start = hostRnd(-720, 720), split = start + hostRnd(1, 359);
+        memset(counts, 0, sizeof(counts));
+        compare(display, "arc", round, [&](ST7305_Mono &d, ST7305_ReferenceCanvas &r) {
+            d.fillArc(cx, cy, inner, outer, start, split, ST7305_WHITE);
+            r.fillArc(cx, cy, inner, outer, start, split, ST7305_WHITE);
+        });
+        accumulate(display.getBuffer(), counts);
+        compare(display, "arc rest", round, [&](ST7305_Mono &d, ST7305_ReferenceCanvas &r) {
+            d.fillArc(cx, cy, inner, outer, split, start + 360, ST7305_WHITE);
+            r.fillArc(cx, cy, inner, outer, split, start + 360, ST7305_WHITE);
+        });
+        accumulate(display.getBuffer(), counts);
+        uint32_t overlaps = 0;
+        for (uint32_t i = 0; i < sizeof(counts); i++) {
+            overlaps += (counts[i] > 1);
+        }
+        HOST_CHECK(overlaps == 0, "arc %d: %lu pixels in both halves", round, (unsigned long)overlaps);
+    }
+}
+
+/**
+ * Far vertices - Coordinates up to the int16 limits
+ */
+static void testFar(ST7305_Mono &display) {
+    static const int16_t far[] = { INT16_MIN, INT16_MIN + 1, -30000, -1000, 1000, 30000, INT16_MAX };
+    const int nFar = sizeof(far) / sizeof(far[0]);
+    for (int round = 0; round < 200; round++) {
+        st7305_point_t pts[6];
+        uint8_t count = hostRnd(3, 6);
+        for (uint8_t i = 0; i < count; i++) {
+            pts[i].x = hostRnd(0, 2) ? far[hostRnd(0, nFar - 1)] : hostRnd(0, ST7305_WIDTH - 1);
+            pts[i].y = hostRnd(0, 2) ? far[hostRnd(0, nFar - 1)] : hostRnd(0, ST7305_HEIGHT - 1);
+        }
+        compare(display, "far polygon", round, [&](ST7305_Mono &d, ST7305_ReferenceCanvas &r) {
+            d.fillPolygon(pts, count, ST7305_WHITE);
+            r.fillPolygon(pts, count, ST7305_WHITE);
+        });
+        uint8_t thickness = hostRnd(2, 60);
+        compare(display, "far thick line", round, [&](ST7305_Mono &d, ST7305_ReferenceCanvas &r) {
+            d.drawThickLine(pts[0].x, pts[0].y, pts[1].x, pts[1].y, thickness, ST7305_WHITE);
+            r.drawThickLine(pts[0].x, pts[0].y, pts[1].x, pts[1].y, thickness, ST7305_WHITE);
+        });
+        int16_t outer = hostRnd(1, INT16_MAX), inner = hostRnd(0, outer);
+        int16_t start = hostRnd(-1000, 1000), end = start + hostRnd(0, 400);
+        compare(display, "far arc", round, [&](ST7305_Mono &d, ST7305_ReferenceCanvas &r) {
+            d.fillArc(pts[2].x, pts[2].y, inner, outer, start, end, ST7305_WHITE);
+            r.fillArc(pts[2].x, pts[2].y, inner, outer, start, end, ST7305_WHITE);
+        });
+    }
+}
+
+/**
+ * Degenerate input - Nothing drawn where there is no area
+ */
+static void testDegenerate(ST7305_Mono &display) {
+    static const st7305_point_t cases[][4] = {
+        { { 10, 10 }, { 100, 100 }, { 200, 200 }, { 50, 50 } },    // Collinear
+        { { 40, 40 }, { 40, 40 }, { 40, 40 }, { 40, 40 } },        // One point
+        { { 10, 50 }, { 290, 50 }, { 150, 50 }, { 10, 50 } },      // Horizontal
+        { { 70, 10 }, { 70, 390 }, { 70, 200 }, { 70, 10 } },      // Vertical
+    };
+    for (int i = 0; i < (int)(sizeof(cases) / sizeof(cases[0])); i++) {
+        compare(display, "degenerate", i, [&](ST7305_Mono &d, ST7305_ReferenceCanvas &r) {
+            d.fillPolygon(cases[i], 4, ST7305_WHITE);
+            r.fillPolygon(cases[i], 4, ST7305_WHITE);
+        });
+        HOST_CHECK(isEmpty(display), "degenerate %d: pixels set", i);
+    }
+
+    // Fewer than 3 points, or more than the engine takes: ignored
+    st7305_point_t many[ST7305_MAX_POLY_POINTS + 1];
+    for (int i = 0; i <= ST7305_MAX_POLY_POINTS; i++) {
+        many[i].x = hostRnd(0, ST7305_WIDTH - 1);
+        many[i].y = hostRnd(0, ST7305_HEIGHT - 1);
+    }
+    compare(display, "short", 0, [&](ST7305_Mono &d, ST7305_ReferenceCanvas &r) {
+        d.fillPolygon(many, 2, ST7305_WHITE);
+        d.fillPolygon(many, 0, ST7305_WHITE);
+    });
+    HOST_CHECK(isEmpty(display), "short polygon drawn");
+    compare(display, "long", 0, [&](ST7305_Mono &d, ST7305_ReferenceCanvas &r) {
+        d.fillPolygon(many, ST7305_MAX_POLY_POINTS + 1, ST7305_WHITE);
+    });
+    HOST_CHECK(isEmpty(display), "polygon over ST7305_MAX_POLY_POINTS drawn");
+}
+
+/**
+ * Thin lines - thickness 0 and 1 are drawLine()
+ */
+static void testThin(ST7305_Mono &display) {
+    for (int round = 0; round < 100; round++) {
+        int16_t x0 = hostRnd(-50, 350), y0 = hostRnd(-50, 450), x1 = hostRnd(-50, 350), y1 = hostRnd(-50, 450);
+        uint8_t thickness = hostRnd(0, 1);
+        compare(display, "thin line", round, [&](ST7305_Mono &d, ST7305_ReferenceCanvas &r) {
+            d.drawThickLine(x0, y0, x1, y1, thickness, ST7305_WHITE);
+            r.drawLine(x0, y0, x1, y1, ST7305_WHITE);
+        });
+    }
+}
+
+int main() {
+    hostSeed(0x165667B1);
+    ST7305_Mono display(9, 8, 10);
+    if (!display.begin(1000000)) {
+        printf("FAIL: begin\n");
+        return 1;
+    }
+    testMesh(display);
+    testArcs(display);
+    testFar(display);
+    testDegenerate(display);
+    testThin(display);
+    return hostResult();
+}
@@ -0,0 +1,70 @@
+/**
+ * test_gray.cpp - Grayscale plane pushes, checked on the wire
+ *
+ * After every showNextPlane() the panel must hold the plane now shown,
+ * the windows sent must not overlap (the dirty box is merged into the
+ * cached delta, not appended to it) and lastPushBytes() must match the
+ * bytes on the wire.
+ */
+
+#include "host_test.h"
+#include <ST7305_Gray.h>
+
+#define DC_PIN 9
+
+static bool overlap(const HostWindow &a, const HostWindow &b) {
+    return (a.col0 <= b.col1) && (b.col0 <= a.col1) && (a.pair0 <= b.pair1) && (b.pair0 <= a.pair1);
+}
+
+static void push(ST7305_Grayscale &gray, HostPanel &panel, const char *what, int round) {
+    panel.capture(DC_PIN, [&]() { gray.showNextPlane(); });
+    uint32_t wire = 0;
+    for (size_t i = 0; i < panel.windows.size(); i++) {
+        wire += panel.windows[i].bytes;
+        for (size_t j = i + 1; j < panel.windows.size(); j++) {
+            HOST_CHECK(!overlap(panel.windows[i], panel.windows[j]),
+                       "%s %d: windows %zu and %zu overlap", what, round, i, j);
+        }
+    }
+    HOST_CHECK(wire == gray.lastPushBytes(), "%s %d: %lu bytes on the wire, lastPushBytes() %lu",
+               what, round, (unsigned long)wire, (unsigned long)gray.lastPushBytes());
+    HOST_CHECK(memcmp(panel.ram, gray.getPlane(gray.currentPlane()), ST7305_BUFFER_SIZE) == 0,
+               "%s %d: panel differs from plane %u", what, round, gray.currentPlane());
+}
+
+int main() {
+    hostSeed(0x1B873593);
+    ST7305_Mono display(DC_PIN, 8, 10);
+    if (!display.begin(1000000)) {
+        printf("FAIL: begin\n");
+        return 1;
+    }
+
+    for (uint8_t planes = 1; planes <= ST7305_GRAY_MAX_PLANES; planes++) {
+        ST7305_Grayscale gray(display);
+        if (!gray.begin(planes)) {
+            printf("FAIL: gray begin(%u)\n", planes);
+            return 1;
+        }
+        HostPanel panel;
+        panel.capture(DC_PIN, [&]() { gray.refresh(); });
+
+        for (int round = 0; round < 60; round++) {
+            // Pixels and rectangles, some overlapping the cached deltas
+            for (int i = hostRnd(0, 3); i > 0; i--) {
+                gray.fillRect(hostRnd(-10, ST7305_WIDTH), hostRnd(-10, ST7305_HEIGHT), hostRnd(1, 80), hostRnd(1, 80),
+                              hostRnd(0, planes));
+            }
+            for (int i = hostRnd(0, 50); i > 0; i--) {
+                gray.drawPixel(hostRnd(0, ST7305_WIDTH - 1), hostRnd(0, ST7305_HEIGHT - 1), hostRnd(0, planes));
+            }
+            push(gray, panel, "draw", round);
+
+            // Nothing drawn: only the cached delta
+            for (int i = 0; i < planes; i++) {
+                push(gray, panel, "cycle", round);
+            }
+        }
+    }
+    return hostResult();
+}
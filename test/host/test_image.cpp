@@ -0,0 +1,352 @@
+/**
+ * test_image.cpp - Streaming PBM / BMP / RLE decoder
+ *
+ * Encodes random pictures in every supported layout and decodes them
+ * from a memory Stream, checking each pixel against the source:
+ * - PBM P1 (ASCII, free whitespace) and P4 (binary, padded rows), with
+ *   header comments
+ * - BMP 1-bit (either palette order) and 8-bit gray (ordered dither),
+ *   bottom-up and top-down, with row padding, a larger info header and
+ *   a gap before the pixel data
+ * - "SR" runs that cross rows
+ * Images are placed partly off the panel, inside viewports, and wider
+ * than the panel, so only the visible columns (_colStart/_colCount) are
+ * kept. Cut-short sources and unsupported variants must fail.
+ */
+
+#include "host_test.h"
+#include <ST7305_Image.h>
+
+#define DC_PIN 9
+
+// 4x4 Bayer thresholds, as in ST7305_Image.cpp
+static const uint8_t bayer[4][4] = {
+    {   8, 136,  40, 168 },
+    { 200,  72, 232, 104 },
+    {  56, 184,  24, 152 },
+    { 248, 120, 216,  88 }
+};
+
+/**
+ * Memory Stream - Stream over a byte vector
+ */
+class MemoryStream : public Stream {
+public:
+    MemoryStream(const std::vector<uint8_t> &data, size_t size) : _data(data), _size(size), _pos(0) {}
+    size_t write(uint8_t) override { return 0; }
+    int available() override { return (int)(_size - _pos); }
+    int read() override { return (_pos < _size) ? _data[_pos++] : -1; }
+    int peek() override { return (_pos < _size) ? _data[_pos] : -1; }
+
+private:
+    const std::vector<uint8_t> &_data;
+    size_t _size, _pos;
+};
+
+/**
+ * Picture - Source pixels; gray is used by 8-bit BMP, white by the rest
+ */
+struct Picture {
+    int w, h;
+    std::vector<uint8_t> gray;   // 0-255
+    bool white(int x, int y) const { return gray[(size_t)y * w + x] >= 128; }
+};
+
+static Picture makePicture(int w, int h) {
+    Picture p = { w, h, std::vector<uint8_t>((size_t)w * h) };
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            // Blocks and noise, so both long runs and short ones occur
+            bool block = ((x / 9 + y / 5) % 3) == 0;
+            p.gray[(size_t)y * w + x] = block ? ((y & 8) ? 255 : 0) : (uint8_t)hostRnd(0, 255);
+        }
+    }
+    return p;
+}
+
+static void put16(std::vector<uint8_t> &out, uint32_t v) {
+    out.push_back(v & 0xFF);
+    out.push_back((v >> 8) & 0xFF);
+}
+
+static void put32(std::vector<uint8_t> &out, uint32_t v) {
+    put16(out, v & 0xFFFF);
+    put16(out, v >> 16);
+}
+
+static void putText(std::vector<uint8_t> &out, const char *text) {
+    out.insert(out.end(), text, text + strlen(text));
+}
+
+static std::vector<uint8_t> encodePbm(const Picture &p, bool ascii) {
+    std::vector<uint8_t> out;
+    char head[64];
+    snprintf(head, sizeof(head), "P%c\n# made by test_image\n%d  %d\n", ascii ? '1' : '4', p.w, p.h);
+    putText(out, head);
+    for (int y = 0; y < p.h; y++) {
+        if (ascii) {
+            for (int x = 0; x < p.w; x++) {
+                out.push_back(p.white(x, y) ? '0' : '1');
+                if (hostRnd(0, 3) == 0) {
+                    out.push_back(hostRnd(0, 1) ? ' ' : '\n');
+                }
+            }
+            out.push_back('\n');
+            continue;
+        }
+        for (int x = 0; x < p.w; x += 8) {
+            uint8_t b = 0;
+            for (int bit = 0; (bit < 8) && (x + bit < p.w); bit++) {
+                b |= p.white(x + bit, y) ? 0 : (0x80 >> bit);
+            }
+            out.push_back(b);
+        }
+    }
+    return out;
+}
+
+/**
+ * Encode BMP - 1-bit (palette order swapped if invert) or 8-bit gray
+ */
+static std::vector<uint8_t> encodeBmp(const Picture &p, int bpp, bool topDown, bool invert, uint32_t dibSize,
+                                      uint32_t gap) {
+    uint32_t entries = (bpp == 1) ? 2 : 256;
+    uint32_t stride = ((uint32_t)p.w * bpp + 31) / 32 * 4;
+    uint32_t offset = 14 + dibSize + entries * 4 + gap;
+    std::vector<uint8_t> out;
+    putText(out, "BM");
+    put32(out, offset + stride * p.h);
+    put32(out, 0);
+    put32(out, offset);
+    put32(out, dibSize);
+    put32(out, p.w);
+    put32(out, topDown ? (uint32_t)-p.h : (uint32_t)p.h);
+    put16(out, 1);
+    put16(out, bpp);
+    put32(out, 0);                 // BI_RGB
+    put32(out, stride * p.h);
+    put32(out, 2835);
+    put32(out, 2835);
+    put32(out, (bpp == 1) ? 2 : 0);
+    put32(out, 0);
+    for (uint32_t i = 40; i < dibSize; i++) {
+        out.push_back(0xA5);
+    }
+    for (uint32_t i = 0; i < entries; i++) {
+        uint8_t g = (bpp == 1) ? (((i == 1) != invert) ? 0xFF : 0x00) : (uint8_t)i;
+        out.push_back(g);
+        out.push_back(g);
+        out.push_back(g);
+        out.push_back(0);
+    }
+    for (uint32_t i = 0; i < gap; i++) {
+        out.push_back(0x5A);
+    }
+    for (int r = 0; r < p.h; r++) {
+        int y = topDown ? r : p.h - 1 - r;
+        size_t start = out.size();
+        if (bpp == 1) {
+            for (int x = 0; x < p.w; x += 8) {
+                uint8_t b = 0;
+                for (int bit = 0; (bit < 8) && (x + bit < p.w); bit++) {
+                    b |= (p.white(x + bit, y) != invert) ? (0x80 >> bit) : 0;
+                }
+                out.push_back(b);
+            }
+        } else {
+            for (int x = 0; x < p.w; x++) {
+                out.push_back(p.gray[(size_t)y * p.w + x]);
+            }
+        }
+        while (out.size() - start < stride) {
+            out.push_back(0xEE);   // Padding must be skipped, not drawn
+        }
+    }
+    return out;
+}
+
+static std::vector<uint8_t> encodeRle(const Picture &p) {
+    std::vector<uint8_t> out;
+    putText(out, "SR");
+    put16(out, p.w);
+    put16(out, p.h);
+    size_t total = (size_t)p.w * p.h;
+    for (size_t i = 0; i < total;) {
+        bool white = p.white(i % p.w, i / p.w);
+        size_t run = 1;
+        while ((i + run < total) && (run < 128) && (p.white((i + run) % p.w, (i + run) / p.w) == white)) {
+            run++;
+        }
+        out.push_back((white ? 0x80 : 0x00) | (uint8_t)(run - 1));
+        i += run;
+    }
+    return out;
+}
+
+static bool getBit(const uint8_t *frame, int x, int y) {
+    return frame[(y / 2) * ST7305_BYTES_PER_ROW + x / 4] & (0x80 >> ((x % 4) * 2 + (y % 2)));
+}
+
+static void setBit(uint8_t *frame, int x, int y, bool white) {
+    uint8_t bit = 0x80 >> ((x % 4) * 2 + (y % 2));
+    uint8_t &b = frame[(y / 2) * ST7305_BYTES_PER_ROW + x / 4];
+    b = white ? (b | bit) : (b & ~bit);
+}
+
+/**
+ * Decode - Draw the encoded image at x, y (in a viewport if given) over
+ * a known pattern and compare with the picture
+ */
+static void decode(ST7305_Mono &display, const std::vector<uint8_t> &file, const Picture &p, bool dither,
+                   st7305_image_format_t format, int16_t x, int16_t y, const st7305_rect_t *viewport,
+                   const char *what) {
+    static uint8_t want[ST7305_BUFFER_SIZE];
+    uint8_t *buf = display.getBuffer();
+    for (uint32_t i = 0; i < ST7305_BUFFER_SIZE; i++) {
+        buf[i] = (uint8_t)(i * 29 + (i >> 6));
+    }
+    memcpy(want, buf, ST7305_BUFFER_SIZE);
+    int32_t ox = 0, oy = 0;
+    int32_t cx0 = 0, cy0 = 0, cx1 = ST7305_WIDTH - 1, cy1 = ST7305_HEIGHT - 1;
+    if (viewport) {
+        display.pushViewport(*viewport);
+        ox = viewport->x;
+        oy = viewport->y;
+        cx0 = (ox > 0) ? ox : 0;
+        cy0 = (oy > 0) ? oy : 0;
+        cx1 = (ox + viewport->w - 1 < cx1) ? ox + viewport->w - 1 : cx1;
+        cy1 = (oy + viewport->h - 1 < cy1) ? oy + viewport->h - 1 : cy1;
+    }
+    for (int j = 0; j < p.h; j++) {
+        for (int i = 0; i < p.w; i++) {
+            int32_t px = ox + x + i, py = oy + y + j;
+            if ((px < cx0) || (px > cx1) || (py < cy0) || (py > cy1)) {
+                continue;
+            }
+            uint8_t g = p.gray[(size_t)j * p.w + i];
+            setBit(want, px, py, dither ? (g > bayer[(y + j) & 3][(x + i) & 3]) : p.white(i, j));
+        }
+    }
+
+    ST7305_ImageDecoder decoder(display);
+    MemoryStream src(file, file.size());
+    bool ok = decoder.draw(src, x, y);
+    if (viewport) {
+        display.popClip();
+    }
+    HOST_CHECK(ok, "%s %dx%d at %d,%d: draw failed", what, p.w, p.h, x, y);
+    HOST_CHECK((decoder.format() == format) && (decoder.width() == p.w) && (decoder.height() == p.h),
+               "%s: format %d, %ux%u", what, decoder.format(), decoder.width(), decoder.height());
+    uint32_t bad = 0;
+    for (int py = 0; py < ST7305_HEIGHT; py++) {
+        for (int px = 0; px < ST7305_WIDTH; px++) {
+            bad += (getBit(buf, px, py) != getBit(want, px, py));
+        }
+    }
+    HOST_CHECK(bad == 0, "%s %dx%d at %d,%d%s: %lu pixels differ", what, p.w, p.h, x, y,
+               viewport ? " in a viewport" : "", (unsigned long)bad);
+}
+
+/**
+ * Short - Every cut of the source before its last needed byte must fail
+ * (a P1 file may end in whitespace the decoder never reads)
+ */
+static void testShort(ST7305_Mono &display, const std::vector<uint8_t> &file, bool ascii, const char *what) {
+    size_t end = file.size();
+    while (ascii && (end > 0) && ((file[end - 1] == ' ') || (file[end - 1] == '\n'))) {
+        end--;
+    }
+    ST7305_ImageDecoder decoder(display);
+    const size_t cuts[] = { 0, 1, 2, 5, 13, 30, 54, end / 2, end - 1 };
+    for (size_t cut : cuts) {
+        if (cut >= end) {
+            continue;
+        }
+        MemoryStream src(file, cut);
+        HOST_CHECK(!decoder.draw(src, 0, 0), "%s cut to %zu of %zu bytes: draw succeeded", what, cut,
+                   file.size());
+    }
+}
+
+static void rejects(ST7305_Mono &display, const std::vector<uint8_t> &file, const char *what) {
+    ST7305_ImageDecoder decoder(display);
+    MemoryStream src(file, file.size());
+    HOST_CHECK(!decoder.draw(src, 0, 0), "%s: draw succeeded", what);
+}
+
+int main() {
+    hostSeed(0x68E31DA4);
+    ST7305_Mono display(DC_PIN, 8, 10);
+    if (!display.begin(1000000)) {
+        printf("FAIL: begin\n");
+        return 1;
+    }
+
+    const int sizes[][2] = {
+        { 1, 1 }, { 7, 3 }, { 33, 17 }, { 64, 64 }, { 300, 400 }, { 301, 5 }, { 700, 40 },
+    };
+    for (const int *size : sizes) {
+        Picture p = makePicture(size[0], size[1]);
+        struct {
+            std::vector<uint8_t> file;
+            bool dither;
+            st7305_image_format_t format;
+            const char *what;
+        } files[] = {
+            { encodePbm(p, true), false, ST7305_IMAGE_PBM_ASCII, "P1" },
+            { encodePbm(p, false), false, ST7305_IMAGE_PBM_BINARY, "P4" },
+            { encodeBmp(p, 1, false, false, 40, 0), false, ST7305_IMAGE_BMP, "BMP 1-bit bottom-up" },
+            { encodeBmp(p, 1, true, true, 124, 6), false, ST7305_IMAGE_BMP, "BMP 1-bit top-down, inverted" },
+            { encodeBmp(p, 8, false, false, 40, 3), true, ST7305_IMAGE_BMP, "BMP 8-bit bottom-up" },
+            { encodeBmp(p, 8, true, false, 108, 0), true, ST7305_IMAGE_BMP, "BMP 8-bit top-down" },
+            { encodeRle(p), false, ST7305_IMAGE_RLE, "SR" },
+        };
+        for (auto &f : files) {
+            decode(display, f.file, p, f.dither, f.format, 0, 0, nullptr, f.what);
+            decode(display, f.file, p, f.dither, f.format, ST7305_WIDTH - p.w / 2, ST7305_HEIGHT - p.h / 2,
+                   nullptr, f.what);
+            decode(display, f.file, p, f.dither, f.format, -p.w / 2 - 1, -p.h / 3, nullptr, f.what);
+            for (int round = 0; round < 3; round++) {
+                st7305_rect_t viewport;
+                viewport.x = hostRnd(-40, ST7305_WIDTH - 1);
+                viewport.y = hostRnd(-40, ST7305_HEIGHT - 1);
+                viewport.w = hostRnd(1, ST7305_WIDTH);
+                viewport.h = hostRnd(1, ST7305_HEIGHT);
+                decode(display, f.file, p, f.dither, f.format, hostRnd(-p.w, viewport.w),
+                       hostRnd(-p.h, viewport.h), &viewport, f.what);
+            }
+            if (p.w * p.h < 5000) {
+                testShort(display, f.file, f.format == ST7305_IMAGE_PBM_ASCII, f.what);
+            }
+        }
+    }
+
+    // Unsupported or inconsistent headers
+    Picture p = makePicture(16, 4);
+    std::vector<uint8_t> bmp = encodeBmp(p, 8, false, false, 40, 0);
+    std::vector<uint8_t> bad = bmp;
+    bad[28] = 24;                        // 24 bits per pixel
+    rejects(display, bad, "BMP 24-bit");
+    bad = bmp;
+    bad[30] = 1;                         // BI_RLE8
+    rejects(display, bad, "BMP RLE8");
+    bad = bmp;
+    bad[46] = 0x2C;                      // 300 palette entries
+    bad[47] = 0x01;
+    rejects(display, bad, "BMP palette");
+    bad = bmp;
+    bad[10] = 20;                        // Pixel data inside the headers
+    bad[11] = 0;
+    bad[12] = 0;
+    rejects(display, bad, "BMP data offset");
+    bad.clear();
+    putText(bad, "P4\n0 5\n\xFF");
+    rejects(display, bad, "PBM zero width");
+    bad.clear();
+    putText(bad, "P4\n70000 1\n");
+    rejects(display, bad, "PBM too wide");
+    bad = encodeRle(p);
+    bad[0] = 'G';
+    rejects(display, bad, "unknown magic");
+    return hostResult();
+}
@@ -0,0 +1,150 @@
+/**
+ * test_jobs.cpp - Time-sliced render and flush jobs
+ *
+ * Steps jobs with random unit caps and checks on the wire that every
+ * step stays within its cap and does work, that a flush job sends each
+ * row-pair of its window exactly once and in order (resuming where the
+ * last step stopped), that progress only moves forward and matches the
+ * bytes sent, and that the panel ends up equal to the frame buffer -
+ * also when drawing happens between steps or the job is cancelled.
+ */
+
+#include "host_test.h"
+
+#define DC_PIN 9
+
+/**
+ * Step - One stepJob() call, checked against the previous progress
+ *
+ * @return Wire bytes sent by the step
+ */
+static uint32_t step(ST7305_Mono &display, HostPanel &panel, uint16_t maxUnits, bool &more,
+                     const char *what, int round) {
+    st7305_job_progress_t before = display.getJobProgress();
+    panel.capture(DC_PIN, [&]() { more = display.stepJob(hostRnd(0, 1) ? 1 : 1000000, maxUnits); });
+    st7305_job_progress_t after = display.getJobProgress();
+
+    uint32_t pairs = 0, bytes = 0;
+    for (const HostWindow &win : panel.windows) {
+        pairs += win.pair1 - win.pair0 + 1;
+        bytes += win.bytes;
+    }
+    uint32_t tiles = after.tilesDone - before.tilesDone;
+    HOST_CHECK(tiles + pairs >= 1, "%s %d: step did nothing", what, round);
+    HOST_CHECK(!maxUnits || (tiles + pairs <= maxUnits), "%s %d: %lu tiles + %lu pairs, cap %u",
+               what, round, (unsigned long)tiles, (unsigned long)pairs, maxUnits);
+    HOST_CHECK(after.bytesDone - before.bytesDone == bytes, "%s %d: progress says %lu bytes, wire %lu",
+               what, round, (unsigned long)(after.bytesDone - before.bytesDone), (unsigned long)bytes);
+    HOST_CHECK((after.tilesDone >= before.tilesDone) && (after.percent >= before.percent) &&
+               (after.steps == before.steps + 1), "%s %d: progress went back", what, round);
+    HOST_CHECK(more == display.isJobBusy(), "%s %d: stepJob() and isJobBusy() disagree", what, round);
+    if (!more) {
+        HOST_CHECK((after.percent == 100) && (after.bytesDone == after.bytesTotal),
+                   "%s %d: done at %u%%, %lu of %lu bytes", what, round, after.percent,
+                   (unsigned long)after.bytesDone, (unsigned long)after.bytesTotal);
+    }
+    return bytes;
+}
+
+/**
+ * Region flush - Each row-pair once and in order, across and within steps
+ */
+static void testRegion(ST7305_Mono &display, HostPanel &panel) {
+    for (int round = 0; round < 50; round++) {
+        hostScribble(display, 80);
+        int16_t x = hostRnd(0, ST7305_WIDTH - 1), y = hostRnd(0, ST7305_HEIGHT - 1);
+        int16_t w = hostRnd(1, ST7305_WIDTH), h = hostRnd(1, ST7305_HEIGHT);
+        int pair0 = y / 2;
+        int pair1 = ((y + h - 1 < ST7305_HEIGHT) ? y + h - 1 : ST7305_HEIGHT - 1) / 2;
+        HOST_CHECK(display.startFlushJob(x, y, w, h), "round %d: start", round);
+        HOST_CHECK(!display.startFlushJob(x, y, w, h), "round %d: second job started", round);
+
+        int next = pair0;
+        uint16_t maxUnits = hostRnd(0, 12);
+        bool more = true;
+        while (more) {
+            step(display, panel, maxUnits, more, "region", round);
+            for (const HostWindow &win : panel.windows) {
+                HOST_CHECK(win.pair0 == next, "round %d: step sent pairs %d..%d, expected %d next",
+                           round, win.pair0, win.pair1, next);
+                next = win.pair1 + 1;
+            }
+        }
+        HOST_CHECK(next == pair1 + 1, "round %d: job stopped at pair %d of %d..%d", round, next, pair0, pair1);
+    }
+    panel.capture(DC_PIN, [&]() { display.display(); });
+}
+
+/**
+ * Dirty flush with drawing between steps
+ */
+static void testDirty(ST7305_Mono &display, HostPanel &panel) {
+    for (int round = 0; round < 50; round++) {
+        hostScribble(display, 80);
+        if (!display.startFlushJob()) {
+            continue;
+        }
+        uint16_t maxUnits = hostRnd(1, 10);
+        bool more = true;
+        while (more) {
+            step(display, panel, maxUnits, more, "dirty", round);
+            if (hostRnd(0, 3) == 0) {
+                hostScribble(display, 80);
+            }
+        }
+        panel.capture(DC_PIN, [&]() { display.displayDirty(); });
+        HOST_CHECK(memcmp(panel.ram, display.getBuffer(), ST7305_BUFFER_SIZE) == 0,
+                   "round %d: panel differs after the job and displayDirty()", round);
+    }
+}
+
+/**
+ * Render jobs, some cancelled halfway
+ */
+static void testRender(ST7305_Mono &display, HostPanel &panel) {
+    for (int round = 0; round < 30; round++) {
+        display.beginRecording();
+        display.fillScreen(ST7305_BLACK);
+        for (int i = hostRnd(1, 6); i > 0; i--) {
+            display.fillCircle(hostRnd(0, ST7305_WIDTH), hostRnd(0, ST7305_HEIGHT), hostRnd(5, 60), ST7305_WHITE);
+        }
+        display.setCursor(hostRnd(0, 200), hostRnd(0, 380));
+        display.setTextColor(ST7305_WHITE);
+        display.print(round);
+        HOST_CHECK(display.startRenderJob(), "round %d: start", round);
+
+        bool cancel = (round % 3 == 2);
+        uint16_t maxUnits = hostRnd(1, 16);
+        int steps = 0;
+        bool more = true;
+        while (more) {
+            step(display, panel, maxUnits, more, "render", round);
+            if (cancel && more && (++steps == 20)) {
+                display.cancelJob();
+                HOST_CHECK(!display.isJobBusy(), "round %d: busy after cancel", round);
+                break;
+            }
+        }
+        if (cancel) {
+            panel.capture(DC_PIN, [&]() { display.displayDirty(); });
+        }
+        HOST_CHECK(memcmp(panel.ram, display.getBuffer(), ST7305_BUFFER_SIZE) == 0,
+                   "round %d: panel differs after the render job%s", round, cancel ? " (cancelled)" : "");
+    }
+}
+
+int main() {
+    hostSeed(0xC2B2AE35);
+    ST7305_Mono display(DC_PIN, 8, 10);
+    if (!display.begin(1000000)) {
+        printf("FAIL: begin\n");
+        return 1;
+    }
+    HostPanel panel;
+    panel.capture(DC_PIN, [&]() { display.display(); });
+
+    testRegion(display, panel);
+    testDirty(display, panel);
+    testRender(display, panel);
+    return hostResult();
+}
@@ -0,0 +1,197 @@
+/**
+ * test_pipeline.cpp - Frame pipeline with real threads
+ *
+ * A producer thread draws random rectangles into acquired buffers while
+ * a consumer thread takes frames and copies only their damage into its
+ * own panel image. The consumer's image must equal every frame it takes,
+ * so damage of dropped frames has to be carried, and every buffer the
+ * producer acquires must already hold the last submitted frame, so the
+ * stale-region copies have to be complete.
+ *
+ * A single-threaded part first checks drops and carried damage exactly.
+ */
+
+#include "host_test.h"
+#include <ST7305_Pipeline.h>
+#include <thread>
+
+#define FRAMES 3000
+
+static bool contains(const st7305_frame_t *frame, int x, int y) {
+    for (uint8_t i = 0; i < frame->rectCount; i++) {
+        const st7305_rect_t &r = frame->rects[i];
+        if ((x >= r.x) && (x < r.x + r.w) && (y >= r.y) && (y < r.y + r.h)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Fill - Set a clipped rectangle to one color in a packed buffer
+ */
+static void fill(uint8_t *buf, const st7305_rect_t &r, bool white) {
+    for (int y = (r.y < 0) ? 0 : r.y; (y < r.y + r.h) && (y < ST7305_HEIGHT); y++) {
+        for (int x = (r.x < 0) ? 0 : r.x; (x < r.x + r.w) && (x < ST7305_WIDTH); x++) {
+            uint8_t bit = 0x80 >> ((x % 4) * 2 + (y % 2));
+            uint8_t &b = buf[(y / 2) * ST7305_BYTES_PER_ROW + x / 4];
+            b = white ? (b | bit) : (b & ~bit);
+        }
+    }
+}
+
+/**
+ * Copy Damage - Bring an image up to date with a frame's rectangles
+ */
+static void copyDamage(uint8_t *panel, const st7305_frame_t *frame) {
+    for (uint8_t i = 0; i < frame->rectCount; i++) {
+        const st7305_rect_t &r = frame->rects[i];
+        for (int pair = r.y / 2; pair < (r.y + r.h) / 2; pair++) {
+            uint32_t offset = pair * ST7305_BYTES_PER_ROW + r.x / 4;
+            memcpy(panel + offset, frame->buffer + offset, (r.w + 3) / 4);
+        }
+    }
+}
+
+static void checkFrame(const st7305_frame_t *frame, const char *what) {
+    HOST_CHECK((frame->rectCount >= 1) && (frame->rectCount <= ST7305_PIPELINE_MAX_RECTS),
+               "%s: %u rects", what, frame->rectCount);
+    for (uint8_t i = 0; i < frame->rectCount; i++) {
+        HOST_CHECK(hostOnGrid(frame->rects[i]), "%s: rect %u off grid", what, i);
+        for (uint8_t j = i + 1; j < frame->rectCount; j++) {
+            HOST_CHECK(!hostOverlap(frame->rects[i], frame->rects[j]), "%s: rects %u and %u overlap",
+                       what, i, j);
+        }
+    }
+}
+
+/**
+ * Single thread - A frame replaced in the mailbox is dropped, and the
+ * frame taken after it lists the damage of both
+ */
+static void testDrop() {
+    ST7305_FramePipeline pipeline;
+    HOST_CHECK(pipeline.begin(), "begin");
+    HOST_CHECK(!pipeline.take(), "take before submit");
+
+    st7305_rect_t a = { 5, 7, 10, 3 };      // Column 0, pairs 3..4
+    st7305_rect_t b = { 200, 301, 30, 1 };  // Columns 16..19, pair 150
+    fill(pipeline.acquire(), a, false);
+    HOST_CHECK(pipeline.submit(a), "submit a");
+    fill(pipeline.acquire(), b, false);
+    HOST_CHECK(pipeline.submit(b), "submit b");
+    HOST_CHECK(pipeline.pending(), "b pending");
+
+    const st7305_frame_t *frame = pipeline.take();
+    HOST_CHECK(frame != nullptr, "take");
+    if (!frame) {
+        return;
+    }
+    checkFrame(frame, "drop");
+    HOST_CHECK(frame->sequence == 2, "sequence %lu", (unsigned long)frame->sequence);
+    HOST_CHECK(contains(frame, 0, 6) && contains(frame, 11, 9) && contains(frame, 192, 300) &&
+               contains(frame, 239, 301), "carried damage missing");
+    HOST_CHECK(!contains(frame, 24, 6) && !contains(frame, 0, 10) && !contains(frame, 191, 300) &&
+               !contains(frame, 240, 301), "damage grew past the grid");
+
+    st7305_pipeline_stats_t stats = pipeline.getStats();
+    HOST_CHECK((stats.submitted == 2) && (stats.dropped == 1) && (stats.taken == 1),
+               "stats %lu/%lu/%lu", (unsigned long)stats.submitted, (unsigned long)stats.dropped,
+               (unsigned long)stats.taken);
+
+    // Both rectangles are in the buffer the producer gets next
+    uint8_t *buf = pipeline.acquire();
+    bool black = !(buf[3 * ST7305_BYTES_PER_ROW + 1] & 0x10) && !(buf[150 * ST7305_BYTES_PER_ROW + 50] & 0x40);
+    HOST_CHECK(black, "acquired buffer is missing submitted frames");
+}
+
+/**
+ * Threads - Producer and consumer running freely
+ */
+static void testThreads() {
+    static uint8_t model[ST7305_BUFFER_SIZE];   // Producer: last submitted frame
+    static uint8_t panel[ST7305_BUFFER_SIZE];   // Consumer: what it has sent
+    memset(model, 0xFF, sizeof(model));
+    memset(panel, 0xFF, sizeof(panel));
+
+    ST7305_FramePipeline pipeline;
+    HOST_CHECK(pipeline.begin(model), "begin");
+
+    std::atomic<uint32_t> lastSequence(0);
+    std::atomic<uint32_t> staleAcquires(0), badFrames(0), changedUnderConsumer(0);
+
+    hostSeed(0x85EBCA6B);   // Only the producer draws numbers
+    std::thread producer([&]() {
+        for (uint32_t n = 1; n <= FRAMES; n++) {
+            uint8_t *buf = pipeline.acquire();
+            if (memcmp(buf, model, ST7305_BUFFER_SIZE) != 0) {
+                staleAcquires++;
+            }
+            st7305_rect_t rects[3];
+            uint8_t count = hostRnd(1, 3);
+            for (uint8_t i = 0; i < count; i++) {
+                rects[i].x = hostRnd(-20, ST7305_WIDTH - 1);
+                rects[i].y = hostRnd(-20, ST7305_HEIGHT - 1);
+                rects[i].w = hostRnd(21, 60);
+                rects[i].h = hostRnd(21, 60);
+                bool white = hostRnd(0, 1);
+                fill(buf, rects[i], white);
+                fill(model, rects[i], white);
+            }
+            pipeline.submit(rects, count);
+            if (hostRnd(0, 15) == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));   // Let the consumer catch up
+            }
+        }
+        lastSequence = FRAMES;
+    });
+
+    std::thread consumer([&]() {
+        uint32_t previous = 0;
+        for (;;) {
+            const st7305_frame_t *frame = pipeline.take();
+            if (!frame) {
+                if ((lastSequence == FRAMES) && (previous == FRAMES)) {
+                    break;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            if ((frame->sequence <= previous) || (frame->rectCount == 0)) {
+                badFrames++;
+            }
+            previous = frame->sequence;
+            copyDamage(panel, frame);
+            if (memcmp(panel, frame->buffer, ST7305_BUFFER_SIZE) != 0) {
+                badFrames++;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(50));   // "SPI transfer"
+            if (memcmp(panel, frame->buffer, ST7305_BUFFER_SIZE) != 0) {
+                changedUnderConsumer++;
+            }
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    HOST_CHECK(staleAcquires == 0, "%lu acquired buffers were behind the last frame",
+               (unsigned long)staleAcquires.load());
+    HOST_CHECK(badFrames == 0, "%lu frames out of order or missing damage", (unsigned long)badFrames.load());
+    HOST_CHECK(changedUnderConsumer == 0, "%lu frames written while the consumer held them",
+               (unsigned long)changedUnderConsumer.load());
+    HOST_CHECK(memcmp(panel, model, ST7305_BUFFER_SIZE) == 0, "final picture differs");
+
+    st7305_pipeline_stats_t stats = pipeline.getStats();
+    HOST_CHECK(stats.submitted == FRAMES, "%lu submitted", (unsigned long)stats.submitted);
+    HOST_CHECK(stats.taken + stats.dropped == stats.submitted, "%lu taken + %lu dropped != %lu submitted",
+               (unsigned long)stats.taken, (unsigned long)stats.dropped, (unsigned long)stats.submitted);
+    printf("threads: %lu frames, %lu taken, %lu dropped\n", (unsigned long)stats.submitted,
+           (unsigned long)stats.taken, (unsigned long)stats.dropped);
+}
+
+int main() {
+    testDrop();
+    testThreads();
+    return hostResult();
+}
@@ -0,0 +1,59 @@
+/**
+ * test_selftest.cpp - Differential self-test on the host
+ *
+ * Fuzzes every operation kind on its own and all of them mixed against
+ * the per-pixel reference, then prints the benchmark per kind. Fails on
+ * any buffer difference or dirty-rectangle miss.
+ */
+
+#include <ST7305_Mono.h>
+#include "ST7305_SelfTest.h"
+
+static const uint16_t kinds[] = {
+    ST7305_TEST_PIXEL, ST7305_TEST_PIXELS, ST7305_TEST_SPAN, ST7305_TEST_RECT,
+    ST7305_TEST_LINE, ST7305_TEST_SHAPE, ST7305_TEST_BITMAP, ST7305_TEST_PACKED,
+    ST7305_TEST_SCALED, ST7305_TEST_TEXT, ST7305_TEST_CLIP, ST7305_TEST_RECORD,
+    ST7305_TEST_FILL
+};
+
+int main() {
+    ST7305_Mono display(9, 8, 10);
+    ST7305_SelfTest test(display);
+    if (!test.begin()) {
+        printf("FAIL: no memory\n");
+        return 1;
+    }
+
+    uint32_t failed = 0;
+    for (uint8_t i = 0; i <= sizeof(kinds) / sizeof(kinds[0]); i++) {
+        bool all = (i == sizeof(kinds) / sizeof(kinds[0]));
+        uint16_t kind = all ? ST7305_TEST_ALL : kinds[i];
+        uint32_t ops = all ? 20000 : 3000;
+        st7305_selftest_result_t r = test.run(1234 + i, ops, kind);
+        printf("%-8s %6lu ops  %lu failures  %lu dirty misses\n", all ? "all" : ST7305_SelfTest::kindName(kind),
+               (unsigned long)r.ops, (unsigned long)r.failures, (unsigned long)r.dirtyMisses);
+        if (r.failures || r.dirtyMisses || (r.ops != ops)) {
+            printf("  first: op %lu (%s), byte %ld\n", (unsigned long)r.firstFailOp,
+                   ST7305_SelfTest::kindName(r.firstFailKind), (long)r.firstFailByte);
+            failed++;
+        }
+    }
+
+    for (uint8_t i = 0; i < sizeof(kinds) / sizeof(kinds[0]); i++) {
+        // Cheap kinds get more operations so the timing clears micros() noise
+        uint32_t ops = (kinds[i] & (ST7305_TEST_PIXEL | ST7305_TEST_PIXELS)) ? 20000 : 1000;
+        st7305_selftest_timing_t t = test.benchmark(kinds[i], ops);
+        printf("bench %-8s reference %7lu us  optimized %7lu us  x%.1f%s\n",
+               ST7305_SelfTest::kindName(kinds[i]), (unsigned long)t.referenceMicros,
+               (unsigned long)t.optimizedMicros,
+               t.optimizedMicros ? (double)t.referenceMicros / t.optimizedMicros : 0.0,
+               t.matched ? "" : "  MISMATCH");
+        if (!t.matched) {
+            failed++;
+        }
+    }
+
+    test.end();
+    printf(failed ? "FAIL\n" : "OK\n");
+    return failed ? 1 : 0;
+}
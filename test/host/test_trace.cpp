@@ -0,0 +1,261 @@
+/**
+ * test_trace.cpp - Wire trace round trip
+ *
+ * Records a workload with ST7305_WireTrace while the SPI stub captures
+ * the same traffic. Decoding the log must give back exactly the captured
+ * bytes and DC levels; the counters must match; replaying each frame
+ * into the panel model must give that frame's buffer.
+ *
+ * With a directory argument the traces and the expected frames (PBM) are
+ * also written there for test_trace.py, which checks tools/st7305_trace.py
+ * against them:
+ *   full.s7tr    display() every frame
+ *   dirty.s7tr   displayDirty() every frame, same pictures, fewer bytes in total
+ *   changed.s7tr as dirty.s7tr, one pixel different in the last frame
+ *   full_NNN.pbm expected picture of frame NNN
+ */
+
+#include "host_test.h"
+#include <ST7305_Trace.h>
+
+#define DC_PIN  9
+#define FRAMES  6
+
+/**
+ * Memory Sink - Print that keeps everything written to it
+ */
+class MemorySink : public Print {
+public:
+    size_t write(uint8_t c) override {
+        bytes.push_back(c);
+        return 1;
+    }
+    std::vector<uint8_t> bytes;
+};
+
+/**
+ * Decode - Turn a log back into bus bytes; frame markers are returned as
+ * positions in the byte stream
+ *
+ * @return false on a malformed log
+ */
+static bool decodeLog(const std::vector<uint8_t> &log, std::vector<HostSpiByte> &bus,
+                      std::vector<size_t> &frames, uint32_t &counted) {
+    static const uint8_t magic[4] = { 'S', '7', 'T', 'R' };
+    if ((log.size() < 8) || (memcmp(log.data(), magic, 4) != 0) || (log[4] != ST7305_TRACE_VERSION)) {
+        return false;
+    }
+    counted = 0;
+    size_t pos = 8;
+    while (pos < log.size()) {
+        uint8_t type = log[pos++];
+        if ((type == ST7305_TRACE_CMD) || (type == ST7305_TRACE_FRAME)) {
+            if (pos >= log.size()) {
+                return false;
+            }
+            uint8_t value = log[pos++];
+            if (type == ST7305_TRACE_CMD) {
+                bus.push_back({ value, 0 });
+            } else {
+                frames.push_back(bus.size());
+            }
+            continue;
+        }
+        if ((type != ST7305_TRACE_DATA) && (type != ST7305_TRACE_COUNT)) {
+            return false;
+        }
+        uint32_t length = 0;
+        for (uint8_t shift = 0;; shift += 7) {
+            if ((pos >= log.size()) || (shift > 28)) {
+                return false;
+            }
+            uint8_t b = log[pos++];
+            length |= (uint32_t)(b & 0x7F) << shift;
+            if (!(b & 0x80)) {
+                break;
+            }
+        }
+        if (type == ST7305_TRACE_COUNT) {
+            counted += length;
+            continue;
+        }
+        if ((length == 0) || (length > ST7305_TRACE_BURST) || (pos + length > log.size())) {
+            return false;
+        }
+        for (uint32_t i = 0; i < length; i++) {
+            bus.push_back({ log[pos++], 1 });
+        }
+    }
+    return true;
+}
+
+/**
+ * Workload - The same pictures each run; full selects display() over
+ * displayDirty(), changed flips one pixel in the last frame
+ */
+static void workload(ST7305_Mono &display, ST7305_WireTrace &trace, uint8_t *frames, bool full,
+                     bool changed) {
+    for (int n = 0; n < FRAMES; n++) {
+        switch (n) {
+        case 0:
+            display.fillScreen(ST7305_WHITE);
+            display.fillRect(20, 30, 100, 50, ST7305_BLACK);
+            break;
+        case 1:
+            display.setCursor(30, 150);
+            display.setTextColor(ST7305_BLACK, ST7305_WHITE);
+            display.setTextSize(2);
+            display.print("12:34");
+            break;
+        case 2:
+            display.fillCircle(200, 250, 40, ST7305_BLACK);
+            break;
+        case 3:
+            display.drawLine(0, 399, 299, 0, ST7305_BLACK);
+            break;
+        case 4:
+            break;   // Nothing drawn
+        default:
+            display.fillRect(130, 300, 37, 61, ST7305_BLACK);
+            if (changed) {
+                display.drawPixel(5, 5, ST7305_BLACK);
+            }
+            break;
+        }
+        if (full || (n == 0)) {
+            display.display();
+        } else {
+            display.displayDirty();
+        }
+        trace.frame(n);
+        memcpy(frames + n * ST7305_BUFFER_SIZE, display.getBuffer(), ST7305_BUFFER_SIZE);
+    }
+}
+
+/**
+ * Record - Run the workload with tracing and capture, check the log
+ */
+static std::vector<uint8_t> record(ST7305_Mono &display, bool full, bool changed, bool payload,
+                                   const char *what) {
+    static uint8_t frames[FRAMES * ST7305_BUFFER_SIZE];
+    MemorySink sink;
+    ST7305_WireTrace trace(sink, payload);
+    trace.begin();
+    display.setTrace(&trace);
+    hostSpiCapture(true, DC_PIN);
+    workload(display, trace, frames, full, changed);
+    hostSpiCapture(false);
+    display.setTrace(nullptr);
+    trace.end();
+
+    const std::vector<HostSpiByte> &wire = hostSpiLog();
+    std::vector<HostSpiByte> bus;
+    std::vector<size_t> marks;
+    uint32_t counted = 0;
+    HOST_CHECK(decodeLog(sink.bytes, bus, marks, counted), "%s: malformed log", what);
+    HOST_CHECK(marks.size() == FRAMES, "%s: %zu frame markers", what, marks.size());
+
+    st7305_trace_stats_t stats = trace.getStats();
+    uint32_t commands = 0, data = 0;
+    for (const HostSpiByte &b : wire) {
+        (b.dc ? data : commands)++;
+    }
+    HOST_CHECK((stats.commands == commands) && (stats.dataBytes == data) && (stats.frames == FRAMES),
+               "%s: stats %lu/%lu/%lu, wire %lu/%lu", what, (unsigned long)stats.commands,
+               (unsigned long)stats.dataBytes, (unsigned long)stats.frames, (unsigned long)commands,
+               (unsigned long)data);
+    HOST_CHECK((stats.logBytes == sink.bytes.size()) && (stats.dropped == 0), "%s: log size", what);
+
+    if (!payload) {
+        uint32_t kept = 0;
+        for (const HostSpiByte &b : bus) {
+            kept += b.dc;
+        }
+        HOST_CHECK((kept == 0) && (counted == data), "%s: %lu data bytes counted, %lu sent", what,
+                   (unsigned long)counted, (unsigned long)data);
+        return sink.bytes;
+    }
+
+    bool same = (bus.size() == wire.size());
+    for (size_t i = 0; same && (i < bus.size()); i++) {
+        same = (bus[i].data == wire[i].data) && (bus[i].dc == wire[i].dc);
+    }
+    HOST_CHECK(same, "%s: log gives %zu bus bytes, wire had %zu (or they differ)", what,
+               bus.size(), wire.size());
+
+    // Replay frame by frame
+    HostPanel panel;
+    size_t from = 0;
+    for (size_t n = 0; n < marks.size(); n++) {
+        std::vector<HostSpiByte> part(bus.begin() + from, bus.begin() + marks[n]);
+        panel.decode(part);
+        from = marks[n];
+        HOST_CHECK(memcmp(panel.ram, frames + n * ST7305_BUFFER_SIZE, ST7305_BUFFER_SIZE) == 0,
+                   "%s: replayed frame %zu differs", what, n);
+    }
+    return sink.bytes;
+}
+
+static bool writeFile(const char *dir, const char *name, const uint8_t *data, size_t len) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+    bool ok = fwrite(data, 1, len, f) == len;
+    return (fclose(f) == 0) && ok;
+}
+
+/**
+ * Write PBM - P4, 1 = black, as tools/st7305_trace.py replay writes it
+ */
+static bool writePbm(const char *dir, const char *name, const uint8_t *frame) {
+    std::vector<uint8_t> out;
+    char head[32];
+    int n = snprintf(head, sizeof(head), "P4\n%d %d\n", ST7305_WIDTH, ST7305_HEIGHT);
+    out.insert(out.end(), head, head + n);
+    const int stride = (ST7305_WIDTH + 7) / 8;
+    for (int y = 0; y < ST7305_HEIGHT; y++) {
+        std::vector<uint8_t> line(stride, 0);
+        for (int x = 0; x < ST7305_WIDTH; x++) {
+            if (!(frame[(y / 2) * ST7305_BYTES_PER_ROW + x / 4] & (0x80 >> ((x % 4) * 2 + (y % 2))))) {
+                line[x / 8] |= 0x80 >> (x % 8);
+            }
+        }
+        out.insert(out.end(), line.begin(), line.end());
+    }
+    return writeFile(dir, name, out.data(), out.size());
+}
+
+int main(int argc, char **argv) {
+    ST7305_Mono display(DC_PIN, 8, 10);
+    if (!display.begin(1000000)) {
+        printf("FAIL: begin\n");
+        return 1;
+    }
+
+    std::vector<uint8_t> full = record(display, true, false, true, "full");
+    std::vector<uint8_t> dirty = record(display, false, false, true, "dirty");
+    std::vector<uint8_t> changed = record(display, false, true, true, "changed");
+    std::vector<uint8_t> counts = record(display, true, false, false, "no payload");
+    HOST_CHECK(dirty.size() < full.size(), "dirty log %zu bytes, full %zu", dirty.size(), full.size());
+    HOST_CHECK(counts.size() * 50 < full.size(), "log without payload is %zu bytes", counts.size());
+
+    if (argc > 1) {
+        static uint8_t frames[FRAMES * ST7305_BUFFER_SIZE];
+        MemorySink sink;
+        ST7305_WireTrace trace(sink);
+        workload(display, trace, frames, true, false);   // Pictures only, not traced
+        bool ok = writeFile(argv[1], "full.s7tr", full.data(), full.size()) &&
+                  writeFile(argv[1], "dirty.s7tr", dirty.data(), dirty.size()) &&
+                  writeFile(argv[1], "changed.s7tr", changed.data(), changed.size());
+        for (int n = 0; ok && (n < FRAMES); n++) {
+            char name[32];
+            snprintf(name, sizeof(name), "full_%03d.pbm", n);
+            ok = writePbm(argv[1], name, frames + n * ST7305_BUFFER_SIZE);
+        }
+        HOST_CHECK(ok, "writing files to %s", argv[1]);
+    }
+    return hostResult();
+}
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""
+test_trace.py - tools/st7305_trace.py against traces from the driver
+
+Runs test_trace with a scratch directory, then checks that:
+- replay rebuilds every frame exactly (PBMs match the frame buffers)
+- diff finds identical pictures at no higher cost (display() vs displayDirty())
+- diff reports the one changed pixel and fails
+- summary enforces a byte budget
+
+Usage: test_trace.py <test_trace binary> <st7305_trace.py>
+"""
+
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+FRAMES = 6
+failures = 0
+
+
+def check(cond, message):
+    global failures
+    if not cond:
+        failures += 1
+        print('FAIL: %s' % message)
+
+
+def tool(script, *args):
+    result = subprocess.run([sys.executable, script] + list(args), capture_output=True, text=True)
+    return result.returncode, result.stdout + result.stderr
+
+
+def main():
+    binary, script = sys.argv[1], sys.argv[2]
+    with tempfile.TemporaryDirectory() as tmp:
+        check(subprocess.run([binary, tmp]).returncode == 0, 'test_trace %s' % tmp)
+        full = os.path.join(tmp, 'full.s7tr')
+        dirty = os.path.join(tmp, 'dirty.s7tr')
+        changed = os.path.join(tmp, 'changed.s7tr')
+
+        # Replay
+        code, out = tool(script, 'replay', full, '-o', os.path.join(tmp, 'replay'))
+        check(code == 0, 'replay exit %d: %s' % (code, out))
+        for n in range(FRAMES):
+            with open(os.path.join(tmp, 'full_%03d.pbm' % n), 'rb') as f:
+                want = f.read()
+            path = os.path.join(tmp, 'replay_%03d.pbm' % n)
+            got = open(path, 'rb').read() if os.path.exists(path) else b''
+            check(got == want, 'replayed frame %d differs from the frame buffer' % n)
+        check(not os.path.exists(os.path.join(tmp, 'replay_%03d.pbm' % FRAMES)), 'extra frame replayed')
+
+        # Same pictures, no frame costs more
+        code, out = tool(script, 'diff', full, dirty)
+        check(code == 0, 'diff full dirty exit %d: %s' % (code, out))
+        lines = [l for l in out.splitlines() if 'identical' in l]
+        check(len(lines) == FRAMES, 'diff full dirty: %s' % out)
+        deltas = [int(m) for m in re.findall(r'bytes \d+ -> \d+ \(([+-]\d+)\)', out)]
+        check(len(deltas) == FRAMES and deltas[0] == 0 and all(d <= 0 for d in deltas) and sum(deltas) < 0,
+              'diff full dirty byte deltas %s' % deltas)
+
+        # One pixel changed in the last frame
+        code, out = tool(script, 'diff', dirty, changed)
+        check(code == 1, 'diff dirty changed exit %d' % code)
+        check('1 pixels differ in (5,5)-(5,5)' in out, 'diff dirty changed: %s' % out)
+        check(out.count('identical') == FRAMES - 1, 'diff dirty changed: %s' % out)
+
+        # Budgets
+        code, out = tool(script, 'summary', dirty, '--budget-bytes', '16000')
+        check(code == 0, 'summary within budget exit %d: %s' % (code, out))
+        code, out = tool(script, 'summary', full, '--budget-bytes', '1000')
+        check(code == 1, 'summary over budget exit %d' % code)
+        check(out.count('over budget by') == FRAMES, 'summary over budget: %s' % out)
+
+    print('FAIL (%d)' % failures if failures else 'OK')
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
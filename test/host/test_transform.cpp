@@ -0,0 +1,181 @@
+/**
+ * test_transform.cpp - Flush-time transforms, checked on the wire
+ *
+ * Decodes what the driver sends into a panel RAM model and compares it
+ * with the transforms applied pixel by pixel to the frame buffer:
+ * full frames, windows over part of a mirror, damage flushes through
+ * displayDirty(), the bus manager, flush jobs and recorded frames.
+ * Bands and job slices must keep their size under a mirror.
+ */
+
+#include "host_test.h"
+#include <ST7305_Bus.h>
+
+#define DC_PIN 9
+
+static bool getBit(const uint8_t *frame, int x, int y) {
+    return frame[(y / 2) * ST7305_BYTES_PER_ROW + x / 4] & (0x80 >> ((x % 4) * 2 + (y % 2)));
+}
+
+/**
+ * Expected - What the panel should show: mirrors (the last one over a
+ * pixel wins, reading the plain frame), then patterns in slot order
+ */
+static void expected(const ST7305_Mono &display, const uint8_t *frame, uint8_t *out) {
+    memset(out, 0, ST7305_BUFFER_SIZE);
+    for (int y = 0; y < ST7305_HEIGHT; y++) {
+        for (int x = 0; x < ST7305_WIDTH; x++) {
+            bool v = getBit(frame, x, y);
+            for (int8_t i = 0; i < ST7305_MAX_TRANSFORMS; i++) {
+                const st7305_transform_t *t = display.getTransform(i);
+                if (!t || !t->enabled || (x < t->x0) || (x > t->x1) || (y < t->y0) || (y > t->y1)) {
+                    continue;
+                }
+                if (t->op == ST7305_TRANSFORM_MIRROR_X) {
+                    v = getBit(frame, t->x0 + t->x1 - x, y);
+                } else if (t->op == ST7305_TRANSFORM_MIRROR_Y) {
+                    v = getBit(frame, x, t->y0 + t->y1 - y);
+                }
+            }
+            uint8_t bit = 0x80 >> ((x % 4) * 2 + (y % 2));
+            for (int8_t i = 0; i < ST7305_MAX_TRANSFORMS; i++) {
+                const st7305_transform_t *t = display.getTransform(i);
+                if (!t || !t->enabled || !(t->pattern & bit) ||
+                    (x < t->x0) || (x > t->x1) || (y < t->y0) || (y > t->y1)) {
+                    continue;
+                }
+                if (t->op == ST7305_TRANSFORM_INVERT) v = !v;
+                if (t->op == ST7305_TRANSFORM_SET) v = true;
+                if (t->op == ST7305_TRANSFORM_CLEAR) v = false;
+            }
+            if (v) {
+                out[(y / 2) * ST7305_BYTES_PER_ROW + x / 4] |= bit;
+            }
+        }
+    }
+}
+
+/**
+ * Differences - Count panel bytes that differ from the expected image
+ */
+static uint32_t differences(ST7305_Mono &display, const HostPanel &panel) {
+    static uint8_t want[ST7305_BUFFER_SIZE];
+    expected(display, display.getBuffer(), want);
+    uint32_t bad = 0;
+    for (uint32_t i = 0; i < ST7305_BUFFER_SIZE; i++) {
+        bad += (panel.ram[i] != want[i]);
+    }
+    return bad;
+}
+
+static void setupTransforms(ST7305_Mono &display) {
+    display.clearTransforms(false);
+    display.addTransform(hostRnd(0, 100), hostRnd(0, 150), hostRnd(20, 150), hostRnd(10, 200),
+                         ST7305_TRANSFORM_MIRROR_X, ST7305_PATTERN_SOLID, false);
+    display.addTransform(hostRnd(50, 250), hostRnd(100, 300), hostRnd(10, 100), hostRnd(20, 100),
+                         ST7305_TRANSFORM_MIRROR_Y, ST7305_PATTERN_SOLID, false);
+    display.addTransform(hostRnd(0, 200), hostRnd(0, 300), hostRnd(10, 100), hostRnd(5, 60),
+                         ST7305_TRANSFORM_INVERT, ST7305_PATTERN_CHECKER, false);
+    display.addTransform(hostRnd(0, 200), hostRnd(0, 300), hostRnd(10, 100), hostRnd(5, 60),
+                         ST7305_TRANSFORM_SET, ST7305_PATTERN_ROWS, false);
+    display.addTransform(hostRnd(0, 200), hostRnd(0, 300), hostRnd(10, 100), hostRnd(5, 60),
+                         ST7305_TRANSFORM_CLEAR, ST7305_PATTERN_COLUMNS, false);
+}
+
+int main() {
+    hostSeed(0x2545F491);
+    ST7305_Mono display(DC_PIN, 8, 10);
+    if (!display.begin(1000000)) {
+        printf("FAIL: begin\n");
+        return 1;
+    }
+    HostPanel panel;
+    uint8_t *buf = display.getBuffer();
+
+    for (int round = 0; round < 40; round++) {
+        for (uint32_t i = 0; i < ST7305_BUFFER_SIZE; i++) {
+            buf[i] = (uint8_t)hostRnd(0, 255);
+        }
+        setupTransforms(display);
+
+        // Full frame
+        panel.capture(DC_PIN, [&]() { display.display(); });
+        HOST_CHECK(differences(display, panel) == 0, "round %d: full frame", round);
+
+        // Windows over part of a mirror: exactly the window, mirrored content
+        for (int i = 0; i < 10; i++) {
+            int16_t x = hostRnd(0, ST7305_WIDTH - 1), y = hostRnd(0, ST7305_HEIGHT - 1);
+            int16_t w = hostRnd(1, 120), h = hostRnd(1, 120);
+            panel.capture(DC_PIN, [&]() { display.displayRegion(x, y, w, h); });
+            int16_t x1 = (x + w - 1 < ST7305_WIDTH) ? x + w - 1 : ST7305_WIDTH - 1;
+            int16_t y1 = (y + h - 1 < ST7305_HEIGHT) ? y + h - 1 : ST7305_HEIGHT - 1;
+            HOST_CHECK(panel.windows.size() == 1, "round %d: %zu windows for one region",
+                       round, panel.windows.size());
+            if (panel.windows.size() == 1) {
+                const HostWindow &win = panel.windows[0];
+                HOST_CHECK((win.col0 == x / ST7305_PIXELS_PER_COL) && (win.col1 == x1 / ST7305_PIXELS_PER_COL) &&
+                           (win.pair0 == y / 2) && (win.pair1 == y1 / 2),
+                           "round %d: window %d..%d x %d..%d grew from region %d,%d %dx%d",
+                           round, win.col0, win.col1, win.pair0, win.pair1, x, y, w, h);
+            }
+            HOST_CHECK(differences(display, panel) == 0, "round %d: region", round);
+        }
+
+        // Damage inside a mirror reaches its reflection
+        for (int i = 0; i < 10; i++) {
+            hostScribble(display, 40);
+            panel.capture(DC_PIN, [&]() { display.displayDirty(); });
+            HOST_CHECK(differences(display, panel) == 0, "round %d: displayDirty()", round);
+        }
+
+        // Bus bands stay within the chunk size
+        uint16_t chunk = hostRnd(75, 1500);
+        ST7305_SPIBus bus(chunk);
+        bus.attach(display);
+        for (int i = 0; i < 5; i++) {
+            hostScribble(display, 40);
+            panel.capture(DC_PIN, [&]() {
+                bus.requestFlush(display);
+                bus.flush();
+            });
+            for (const HostWindow &win : panel.windows) {
+                uint32_t rowBytes = (win.col1 - win.col0 + 1) * ST7305_BYTES_PER_COL;
+                HOST_CHECK((win.bytes <= chunk) || (win.pair0 == win.pair1),
+                           "round %d: bus band of %lu bytes", round, (unsigned long)win.bytes);
+                HOST_CHECK(win.bytes == rowBytes * (win.pair1 - win.pair0 + 1), "round %d: band size", round);
+            }
+            HOST_CHECK(differences(display, panel) == 0, "round %d: bus flush", round);
+        }
+        bus.detach(display);
+
+        // Flush job slices stay within maxUnits row-pairs
+        for (int i = 0; i < 5; i++) {
+            hostScribble(display, 40);
+            uint16_t units = hostRnd(1, 8);
+            panel.capture(DC_PIN, [&]() {
+                if (display.startFlushJob()) {
+                    while (display.stepJob(1000000, units)) {
+                    }
+                }
+            });
+            for (const HostWindow &win : panel.windows) {
+                HOST_CHECK(win.pair1 - win.pair0 + 1 <= units, "round %d: slice of %d pairs, cap %u",
+                           round, win.pair1 - win.pair0 + 1, units);
+            }
+            HOST_CHECK(differences(display, panel) == 0, "round %d: flush job", round);
+        }
+
+        // Recorded frames: changed tiles and their reflections
+        for (int i = 0; i < 3; i++) {
+            panel.capture(DC_PIN, [&]() {
+                display.beginRecording();
+                display.fillScreen(ST7305_BLACK);
+                hostScribble(display, 40);
+                display.fillCircle(hostRnd(0, ST7305_WIDTH), hostRnd(0, ST7305_HEIGHT), hostRnd(5, 60), ST7305_WHITE);
+                display.endRecording();
+            });
+            HOST_CHECK(differences(display, panel) == 0, "round %d: recorded frame", round);
+        }
+    }
+    return hostResult();
+}
@@ -0,0 +1,156 @@
+/**
+ * test_widgets.cpp - Widget damage rectangles
+ *
+ * The shared rect list (st7305_add_rect) must stay disjoint, within its
+ * capacity and cover everything added. The widget screen must send
+ * exactly its grid-aligned rectangles, keep the panel equal to the frame
+ * buffer, and damage only what changed (one character cell for a one
+ * digit edit, nothing for an unchanged value).
+ */
+
+#include "host_test.h"
+#include <ST7305_Widgets.h>
+
+#define DC_PIN 9
+
+/**
+ * Rect list: random snapped rectangles into a small list
+ */
+static void testRectList() {
+    static bool want[ST7305_HEIGHT][ST7305_WIDTH];
+    for (int round = 0; round < 200; round++) {
+        const uint8_t capacity = hostRnd(1, 8);
+        st7305_rect_t list[8];
+        uint8_t count = 0;
+        memset(want, 0, sizeof(want));
+        for (int i = hostRnd(1, 20); i > 0; i--) {
+            st7305_rect_t r = { (int16_t)hostRnd(-20, ST7305_WIDTH), (int16_t)hostRnd(-20, ST7305_HEIGHT),
+                                (int16_t)hostRnd(-5, 80), (int16_t)hostRnd(-5, 80) };
+            st7305_rect_t s;
+            if (!st7305_snap_rect(r, s)) {
+                HOST_CHECK((r.w <= 0) || (r.h <= 0) || (r.x + r.w <= 0) || (r.y + r.h <= 0) ||
+                           (r.x >= ST7305_WIDTH) || (r.y >= ST7305_HEIGHT),
+                           "round %d: snap dropped %d,%d %dx%d", round, r.x, r.y, r.w, r.h);
+                continue;
+            }
+            HOST_CHECK(hostOnGrid(s), "round %d: snapped %d,%d %dx%d off grid", round, s.x, s.y, s.w, s.h);
+            for (int y = s.y; y < s.y + s.h; y++) {
+                for (int x = s.x; x < s.x + s.w; x++) {
+                    want[y][x] = true;
+                }
+            }
+            st7305_add_rect(list, count, capacity, s);
+        }
+        HOST_CHECK(count <= capacity, "round %d: %u rects, capacity %u", round, count, capacity);
+        for (uint8_t i = 0; i < count; i++) {
+            HOST_CHECK(hostOnGrid(list[i]), "round %d: merged rect off grid", round);
+            for (uint8_t j = i + 1; j < count; j++) {
+                HOST_CHECK(!hostOverlap(list[i], list[j]), "round %d: rects %u and %u overlap", round, i, j);
+            }
+        }
+        uint32_t missed = 0;
+        for (int y = 0; y < ST7305_HEIGHT; y++) {
+            for (int x = 0; x < ST7305_WIDTH; x++) {
+                bool covered = false;
+                for (uint8_t i = 0; (i < count) && !covered; i++) {
+                    covered = (x >= list[i].x) && (x < list[i].x + list[i].w) &&
+                              (y >= list[i].y) && (y < list[i].y + list[i].h);
+                }
+                missed += want[y][x] && !covered;
+            }
+        }
+        HOST_CHECK(missed == 0, "round %d: %lu damaged pixels not covered", round, (unsigned long)missed);
+    }
+}
+
+/**
+ * Update - Send the screen's rectangles and check them on the wire
+ */
+static void checkUpdate(ST7305_Mono &display, ST7305_WidgetScreen &screen, HostPanel &panel,
+                        const char *what) {
+    uint8_t sent = 0;
+    panel.capture(DC_PIN, [&]() { sent = screen.update(); });
+    HOST_CHECK(sent == screen.getRectCount(), "%s: %u windows for %u rects", what, sent, screen.getRectCount());
+    HOST_CHECK(panel.windows.size() == screen.getRectCount(), "%s: %zu RAMWR for %u rects",
+               what, panel.windows.size(), screen.getRectCount());
+
+    uint32_t bytes = 0;
+    const st7305_rect_t *rects = screen.getRects();
+    for (uint8_t i = 0; i < screen.getRectCount(); i++) {
+        HOST_CHECK(hostOnGrid(rects[i]), "%s: rect %d,%d %dx%d off grid", what,
+                   rects[i].x, rects[i].y, rects[i].w, rects[i].h);
+        for (uint8_t j = i + 1; j < screen.getRectCount(); j++) {
+            HOST_CHECK(!hostOverlap(rects[i], rects[j]), "%s: rects %u and %u overlap", what, i, j);
+        }
+        bytes += (uint32_t)(rects[i].w + 3) / 4 * (rects[i].h / 2);
+    }
+    HOST_CHECK(bytes == screen.lastUpdateBytes(), "%s: %lu bytes counted, %lu in rects", what,
+               (unsigned long)screen.lastUpdateBytes(), (unsigned long)bytes);
+
+    uint32_t wire = 0;
+    for (const HostWindow &win : panel.windows) {
+        wire += win.bytes;
+    }
+    HOST_CHECK(wire == bytes, "%s: %lu bytes on the wire, %lu in rects", what,
+               (unsigned long)wire, (unsigned long)bytes);
+    HOST_CHECK(memcmp(panel.ram, display.getBuffer(), ST7305_BUFFER_SIZE) == 0,
+               "%s: panel differs from the frame buffer", what);
+}
+
+static void testScreen(ST7305_Mono &display) {
+    HostPanel panel;
+    display.fillScreen(ST7305_BLACK);
+    panel.capture(DC_PIN, [&]() { display.display(); });
+
+    ST7305_WidgetScreen screen(display);
+    ST7305_Label clock(24, 10, 60, 8, "12:34");
+    ST7305_Readout volts(100, 40, 96, 16, 2, " V", 2);
+    ST7305_Bar level(10, 100, 200, 20, 0, 1000);
+    ST7305_Bar tank(250, 150, 30, 200, 0, 100, true);
+    screen.add(clock);
+    screen.add(volts);
+    screen.add(level);
+    screen.add(tank);
+
+    checkUpdate(display, screen, panel, "first update");
+    HOST_CHECK(screen.getRectCount() > 0, "first update sent nothing");
+
+    // Nothing changed: nothing sent
+    level.setValue(0);
+    checkUpdate(display, screen, panel, "idle update");
+    HOST_CHECK(screen.getRectCount() == 0, "idle update sent %u rects", screen.getRectCount());
+
+    // One digit: one character cell, one column wide, 4 row-pairs high
+    clock.setText("12:35");
+    checkUpdate(display, screen, panel, "one digit");
+    HOST_CHECK(screen.getRectCount() == 1, "one digit: %u rects", screen.getRectCount());
+    if (screen.getRectCount() == 1) {
+        const st7305_rect_t &r = screen.getRects()[0];
+        HOST_CHECK((r.x == 48) && (r.w == ST7305_PIXELS_PER_COL) && (r.y == 10) && (r.h == 8),
+                   "one digit: rect %d,%d %dx%d", r.x, r.y, r.w, r.h);
+    }
+
+    // Random edits
+    for (int i = 0; i < 200; i++) {
+        char text[8];
+        snprintf(text, sizeof(text), "%02d:%02d", (int)hostRnd(0, 23), (int)hostRnd(0, 59));
+        if (hostRnd(0, 1)) clock.setText(text);
+        if (hostRnd(0, 1)) volts.setValue((int32_t)hostRnd(-999, 9999));
+        if (hostRnd(0, 1)) level.setValue(hostRnd(-100, 1100));
+        if (hostRnd(0, 1)) tank.setValue(hostRnd(0, 100));
+        if (hostRnd(0, 9) == 0) tank.invalidate();
+        checkUpdate(display, screen, panel, "random edit");
+    }
+}
+
+int main() {
+    hostSeed(0x9E3779B9);
+    ST7305_Mono display(DC_PIN, 8, 10);
+    if (!display.begin(1000000)) {
+        printf("FAIL: begin\n");
+        return 1;
+    }
+    testRectList();
+    testScreen(display);
+    return hostResult();
+}
@@ -0,0 +1,90 @@
+/**
+ * Arduino.cpp - Host stub implementation for the ST7305 host tests
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <chrono>
+
+HostSerial Serial;
+SPIClass SPI;
+
+static int pinLevels[256];
+static uint64_t advancedMicros = 0;
+static const auto clockStart = std::chrono::steady_clock::now();
+
+static bool spiCapturing = false;
+static int spiDcPin = -1;
+static std::vector<HostSpiByte> spiLog;
+static std::vector<int> spiCsPins;
+
+void pinMode(int, int) {}
+
+void digitalWrite(int pin, int value) {
+    if ((pin >= 0) && (pin < 256)) {
+        pinLevels[pin] = value;
+    }
+}
+
+int digitalRead(int pin) {
+    return ((pin >= 0) && (pin < 256)) ? pinLevels[pin] : LOW;
+}
+
+int hostPinLevel(int pin) {
+    return digitalRead(pin);
+}
+
+void delay(unsigned long) {}
+void delayMicroseconds(unsigned int) {}
+void yield() {}
+
+unsigned long micros() {
+    auto elapsed = std::chrono::steady_clock::now() - clockStart;
+    return (unsigned long)(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() +
+                           advancedMicros);
+}
+
+unsigned long millis() {
+    return micros() / 1000;
+}
+
+void hostAdvanceMicros(uint32_t us) {
+    advancedMicros += us;
+}
+
+uint8_t SPIClass::transfer(uint8_t data) {
+    if (spiCapturing) {
+        uint8_t selected = 0;
+        for (size_t i = 0; i < spiCsPins.size(); i++) {
+            if (digitalRead(spiCsPins[i]) == LOW) {
+                selected |= 1 << i;
+            }
+        }
+        spiLog.push_back({ data, (uint8_t)digitalRead(spiDcPin), selected });
+    }
+    return 0x00;
+}
+
+void SPIClass::transfer(void *buffer, size_t count) {
+    uint8_t *bytes = (uint8_t*)buffer;
+    for (size_t i = 0; i < count; i++) {
+        transfer(bytes[i]);
+        bytes[i] = 0x00;
+    }
+}
+
+void hostSpiCapture(bool on, int dcPin) {
+    if (on) {
+        spiLog.clear();
+        spiDcPin = dcPin;
+    }
+    spiCapturing = on;
+}
+
+void hostSpiWatchCs(const std::vector<int> &csPins) {
+    spiCsPins.assign(csPins.begin(), csPins.begin() + (csPins.size() < 8 ? csPins.size() : 8));
+}
+
+const std::vector<HostSpiByte> &hostSpiLog() {
+    return spiLog;
+}
@@ -0,0 +1,101 @@
+/**
+ * Arduino.h - Host stub for the ST7305 host tests
+ *
+ * Just enough of the Arduino core for the driver to compile and run on a
+ * PC: PROGMEM reads, pins, time, Print/Stream and Serial (stdout). Time
+ * comes from the host clock plus hostAdvanceMicros(), so tests can model
+ * slow transfers without sleeping.
+ */
+
+#ifndef ST7305_HOST_ARDUINO_H
+#define ST7305_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define PROGMEM
+#define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_ptr(addr)   (*(void* const*)(addr))
+
+#define HIGH   1
+#define LOW    0
+#define INPUT  0
+#define OUTPUT 1
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+int digitalRead(int pin);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+unsigned long micros();
+unsigned long millis();
+void yield();
+
+// Host-only: move the clock forward (modelled bus time), read a pin level
+void hostAdvanceMicros(uint32_t us);
+int hostPinLevel(int pin);
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size) {
+        size_t n = 0;
+        while (size--) {
+            n += write(*buffer++);
+        }
+        return n;
+    }
+    size_t write(const char *s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t print(const char *s) { return write(s); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(long v) { char b[24]; snprintf(b, sizeof(b), "%ld", v); return write(b); }
+    size_t print(unsigned long v) { char b[24]; snprintf(b, sizeof(b), "%lu", v); return write(b); }
+    size_t print(int v) { return print((long)v); }
+    size_t print(unsigned int v) { return print((unsigned long)v); }
+    size_t print(double v, int digits = 2) { char b[32]; snprintf(b, sizeof(b), "%.*f", digits, v); return write(b); }
+    size_t println() { return write("\n"); }
+    template <typename T> size_t println(T v) { size_t n = print(v); return n + println(); }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    size_t readBytes(uint8_t *buffer, size_t length) {
+        size_t n = 0;
+        while (n < length) {
+            int c = read();
+            if (c < 0) {
+                break;
+            }
+            buffer[n++] = (uint8_t)c;
+        }
+        return n;
+    }
+    size_t readBytes(char *buffer, size_t length) { return readBytes((uint8_t*)buffer, length); }
+};
+
+class HostSerial : public Stream {
+public:
+    void begin(unsigned long) {}
+    using Print::write;
+    size_t write(uint8_t c) override { return fwrite(&c, 1, 1, stdout); }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+};
+
+extern HostSerial Serial;
+
+#endif // ST7305_HOST_ARDUINO_H
@@ -0,0 +1,53 @@
+/**
+ * SPI.h - Host stub for the ST7305 host tests
+ *
+ * Transfers are optionally captured (bytes, the DC pin level of each and
+ * which watched CS pins were low) so tests can decode what the driver put
+ * on the wire, per panel on a shared bus. Duplex transfers read back 0x00.
+ */
+
+#ifndef ST7305_HOST_SPI_H
+#define ST7305_HOST_SPI_H
+
+#include <Arduino.h>
+#include <vector>
+
+#define MSBFIRST  1
+#define SPI_MODE0 0
+
+class SPISettings {
+public:
+    SPISettings() : clock(4000000) {}
+    SPISettings(uint32_t clockHz, uint8_t, uint8_t) : clock(clockHz) {}
+    uint32_t clock;
+};
+
+class SPIClass {
+public:
+    void begin() {}
+    void beginTransaction(SPISettings settings) { _clock = settings.clock; }
+    void endTransaction() {}
+    uint8_t transfer(uint8_t data);
+    void transfer(void *buffer, size_t count);
+    uint32_t clock() const { return _clock; }
+
+private:
+    uint32_t _clock = 4000000;
+};
+
+extern SPIClass SPI;
+
+/**
+ * Wire capture: one entry per byte, with the DC level it was sent with
+ */
+struct HostSpiByte {
+    uint8_t data;
+    uint8_t dc;
+    uint8_t selected;   // Bit i: watched CS pin i was low (see hostSpiWatchCs())
+};
+
+void hostSpiCapture(bool on, int dcPin = -1);   // Start (clearing the log) or stop
+void hostSpiWatchCs(const std::vector<int> &csPins);   // Up to 8 pins, in bit order
+const std::vector<HostSpiByte> &hostSpiLog();
+
+#endif // ST7305_HOST_SPI_H
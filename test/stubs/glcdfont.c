@@ -0,0 +1,104 @@
+/**
+ * glcdfont.c - Host stand-in for Adafruit_GFX's classic 5x7 font table
+ *
+ * Not the real glyphs: 256 x 5 column bytes of fixed pseudo-random data.
+ * The driver's glyph blits and the stub's Adafruit_GFX::drawChar() read
+ * the same table, so text is compared like for like (and every bit
+ * pattern is exercised, not just the shapes of letters).
+ */
+
+#ifndef FONT5X7_H
+#define FONT5X7_H
+
+#include <Arduino.h>
+
+static const unsigned char font[] PROGMEM = {
+    0x3A, 0xAB, 0xAC, 0x26, 0xAF, 0x23, 0x1A, 0x71, 0x6C, 0x91, 0x5D, 0x31, 0x18, 0x3E, 0xBC,
+    0xD2, 0xEF, 0x51, 0x22, 0x9D, 0x72, 0x4F, 0xDB, 0xD9, 0x6F, 0x39, 0x6E, 0xAE, 0x2B, 0xC8,
+    0x22, 0x2F, 0x0C, 0xE3, 0xED, 0x8C, 0x68, 0x7B, 0xA2, 0x89, 0x99, 0xD6, 0x39, 0xA7, 0x9F,
+    0xF2, 0x55, 0xFE, 0x91, 0x15, 0xB8, 0x20, 0xAA, 0x7A, 0x94, 0x8A, 0xA0, 0x4D, 0xC0, 0x9D,
+    0xFE, 0x49, 0x4C, 0xDC, 0x8E, 0xE0, 0xB9, 0x06, 0xB2, 0x30, 0x29, 0x4A, 0x60, 0x1C, 0xDF,
+    0x3C, 0xB7, 0x62, 0xCF, 0x42, 0x05, 0x19, 0x0C, 0x4B, 0xB3, 0xDF, 0xE1, 0x7C, 0x45, 0xFB,
+    0x50, 0x51, 0x67, 0x70, 0x78, 0xC9, 0x04, 0xF8, 0x43, 0x0C, 0xB4, 0x48, 0x73, 0xCB, 0xC6,
+    0x05, 0xD8, 0x9F, 0x58, 0xF0, 0x6D, 0xD7, 0xE5, 0x38, 0xAC, 0xEE, 0xEF, 0xED, 0xFC, 0xEF,
+    0x97, 0xFE, 0x16, 0x37, 0xBC, 0x03, 0xE7, 0xAA, 0xB0, 0x65, 0x38, 0x43, 0x49, 0xD7, 0x59,
+    0x3B, 0xE0, 0x7F, 0x7F, 0xE2, 0xA3, 0xC9, 0xD6, 0xAE, 0x2A, 0x67, 0x66, 0xED, 0xAB, 0xB5,
+    0x4D, 0x73, 0xFF, 0x96, 0x8A, 0x23, 0x32, 0x0B, 0x97, 0xEF, 0x1C, 0x7D, 0xBA, 0x41, 0x96,
+    0x78, 0xF9, 0xD2, 0x69, 0x3C, 0xB3, 0x6F, 0xCB, 0xDB, 0x42, 0x74, 0xE1, 0x81, 0x5F, 0x22,
+    0xD7, 0x1B, 0x25, 0xA7, 0xCE, 0xF6, 0xCB, 0x80, 0xA1, 0x1E, 0xAA, 0xAD, 0xDF, 0x1D, 0xB0,
+    0xE8, 0x22, 0xD1, 0x5E, 0x04, 0x2A, 0x20, 0x70, 0x63, 0x1F, 0x88, 0xBA, 0xAD, 0x83, 0x6A,
+    0x92, 0x5B, 0xDB, 0xDB, 0xC7, 0xEF, 0x87, 0xFB, 0x15, 0xEC, 0xA5, 0xB8, 0x96, 0x9F, 0x15,
+    0x49, 0x63, 0x80, 0x9C, 0xC9, 0x86, 0x33, 0xCD, 0x05, 0x2C, 0x3D, 0x42, 0x6B, 0xB3, 0xFC,
+    0x49, 0x2A, 0xC5, 0x02, 0x21, 0xEC, 0x42, 0x96, 0xD0, 0x72, 0x13, 0x3F, 0x59, 0x28, 0x48,
+    0xC6, 0xF9, 0xAB, 0xEB, 0xE1, 0x86, 0x01, 0xED, 0x68, 0xAF, 0x6F, 0x05, 0x51, 0xB3, 0x7A,
+    0xEB, 0x7E, 0xD1, 0xF0, 0x9B, 0xC4, 0x54, 0xBC, 0xA6, 0x8C, 0x44, 0xEE, 0xC6, 0xF5, 0x29,
+    0xE9, 0x6F, 0xD3, 0xA9, 0x78, 0x32, 0xD0, 0x9A, 0x6D, 0xDD, 0x69, 0x83, 0xDE, 0x33, 0x08,
+    0x23, 0x9B, 0x13, 0xA9, 0x48, 0x08, 0x68, 0x89, 0x1D, 0xB6, 0xA4, 0x39, 0xBA, 0x75, 0xE8,
+    0xB0, 0x2C, 0x5D, 0x2C, 0x09, 0x52, 0x2D, 0x46, 0xC1, 0x37, 0x58, 0x52, 0x13, 0x59, 0x99,
+    0xD9, 0x86, 0xA2, 0x36, 0xB7, 0x1B, 0x79, 0x38, 0xF2, 0xCC, 0xF6, 0x84, 0x62, 0x01, 0xA8,
+    0x0C, 0x05, 0xAB, 0xB6, 0xF5, 0xF8, 0x00, 0x41, 0xAB, 0x05, 0x89, 0xA5, 0x91, 0x92, 0x06,
+    0x54, 0xCC, 0xD8, 0xBB, 0x9D, 0x92, 0x65, 0xF9, 0xFC, 0x57, 0x32, 0x2C, 0x17, 0x2F, 0x1D,
+    0xD0, 0xCF, 0x52, 0x7D, 0xDE, 0xE4, 0xCD, 0x18, 0x90, 0xF2, 0x4B, 0x98, 0x87, 0x8E, 0x59,
+    0x20, 0x80, 0x73, 0x8A, 0xEA, 0x87, 0xDF, 0x30, 0xBD, 0xE4, 0xB8, 0x70, 0x6A, 0x4D, 0xB8,
+    0x53, 0xAA, 0xDD, 0x34, 0x96, 0xC0, 0x75, 0xE9, 0xC9, 0xF2, 0x60, 0xBD, 0x1B, 0x75, 0x60,
+    0xF5, 0x83, 0x3A, 0x0F, 0xCA, 0x8A, 0x7A, 0x16, 0xAE, 0x0A, 0x2B, 0xFE, 0x6E, 0xE9, 0xAE,
+    0xD5, 0x52, 0x4E, 0x76, 0x92, 0xAA, 0xA5, 0x3A, 0x74, 0x2B, 0xD7, 0xAE, 0xA6, 0x56, 0xEF,
+    0x03, 0x51, 0x5B, 0xE8, 0xA5, 0x39, 0xFB, 0xFE, 0x4E, 0x90, 0x66, 0x44, 0x5A, 0xD3, 0xBB,
+    0xF5, 0xB7, 0x63, 0x9C, 0x49, 0xAA, 0xE3, 0x75, 0x64, 0x03, 0x60, 0x9D, 0xA5, 0xA7, 0xAD,
+    0x70, 0x5B, 0xD9, 0x62, 0x94, 0x86, 0x54, 0xCA, 0x22, 0xF0, 0xD5, 0xDC, 0x7F, 0x88, 0x20,
+    0xE9, 0x8D, 0x35, 0x67, 0xB6, 0x4B, 0xE1, 0x99, 0x40, 0x19, 0x26, 0x21, 0x39, 0x32, 0x26,
+    0x8E, 0x83, 0x53, 0xC2, 0x5A, 0xD5, 0x1F, 0x40, 0x0F, 0xA2, 0xC4, 0xA5, 0xF1, 0xEF, 0x5B,
+    0x6A, 0xA2, 0xB8, 0x2D, 0x5B, 0xF1, 0x0C, 0x4F, 0xA1, 0xAA, 0x5E, 0x72, 0x14, 0x02, 0xB6,
+    0x30, 0xD5, 0x31, 0x0B, 0xAB, 0xBD, 0x11, 0xE9, 0x4A, 0xDE, 0x8E, 0x0C, 0x8C, 0xA0, 0xDF,
+    0x99, 0x46, 0x77, 0xB3, 0x2B, 0x78, 0x45, 0xDC, 0x1E, 0x10, 0xF4, 0x63, 0x5C, 0xAB, 0x4A,
+    0x5C, 0xEF, 0x6B, 0x14, 0x92, 0x72, 0x7E, 0x78, 0xFC, 0xE6, 0x0A, 0x78, 0x09, 0xAD, 0xC3,
+    0xFE, 0x28, 0x3B, 0x2F, 0x94, 0xEE, 0xE4, 0xA1, 0x28, 0xAE, 0xAE, 0xA3, 0xD4, 0x8B, 0x46,
+    0xB3, 0xEC, 0x73, 0x5B, 0xEB, 0xC2, 0xE3, 0x99, 0xDC, 0x44, 0x99, 0xB8, 0xF0, 0x41, 0x84,
+    0x5B, 0x25, 0xA3, 0x70, 0xA0, 0x5D, 0x7A, 0x02, 0xEB, 0x68, 0x4C, 0x08, 0x3F, 0x2B, 0x0D,
+    0x45, 0x96, 0x9F, 0x67, 0xFF, 0x9A, 0x54, 0xC6, 0x97, 0xBD, 0x4F, 0xB8, 0xF2, 0x68, 0xEB,
+    0x23, 0x1F, 0xC8, 0x28, 0x29, 0xFD, 0xA8, 0x26, 0xE1, 0xFD, 0xAE, 0x8A, 0x9A, 0x8D, 0x71,
+    0x7D, 0xA8, 0xF8, 0x51, 0xDC, 0xA7, 0xE5, 0x03, 0x72, 0xF1, 0x31, 0x3B, 0x99, 0x78, 0x6F,
+    0xD0, 0x71, 0x4D, 0x8E, 0x1C, 0x24, 0xD3, 0xF7, 0x1D, 0xFF, 0x9D, 0x37, 0x35, 0x24, 0x81,
+    0xCD, 0x39, 0xFE, 0xA9, 0x8C, 0x18, 0x5C, 0x74, 0x26, 0x6A, 0x80, 0x27, 0x5A, 0x57, 0xE4,
+    0xAD, 0x09, 0x2F, 0xFA, 0x3A, 0x6F, 0x64, 0x99, 0xDE, 0x02, 0x7E, 0xB4, 0x8F, 0x4E, 0x28,
+    0x9A, 0x85, 0x56, 0x3B, 0xAF, 0x02, 0xC4, 0x01, 0x39, 0xDE, 0x89, 0x26, 0x39, 0x82, 0xA5,
+    0xE8, 0x76, 0x7D, 0xA2, 0xC7, 0x3A, 0x35, 0x17, 0xC6, 0x5D, 0x29, 0x94, 0x83, 0x8B, 0x8B,
+    0xDD, 0x60, 0xDA, 0xEE, 0x5B, 0x80, 0x51, 0x4D, 0xBF, 0x3F, 0x0E, 0xC5, 0x72, 0xBB, 0xBB,
+    0x88, 0xD6, 0x68, 0xDC, 0xED, 0x54, 0x42, 0xF8, 0x83, 0xDD, 0xDC, 0xD1, 0x0F, 0x33, 0xDA,
+    0x53, 0x6F, 0xCF, 0xA2, 0x9E, 0xA7, 0xE7, 0xEC, 0xE1, 0x76, 0xFC, 0x51, 0xEE, 0xEE, 0xB9,
+    0x5D, 0xBE, 0x2D, 0x5E, 0x49, 0x58, 0x5E, 0xB0, 0x8A, 0x74, 0x8F, 0x0E, 0xFD, 0x8D, 0xDC,
+    0x98, 0x17, 0x1A, 0x3D, 0x99, 0x01, 0x04, 0x91, 0xD0, 0xD7, 0x62, 0xB1, 0xD3, 0x61, 0x69,
+    0x56, 0x92, 0x88, 0x3E, 0x79, 0x63, 0x1F, 0x57, 0x39, 0x09, 0x05, 0xEA, 0xAB, 0x82, 0xBD,
+    0x3C, 0x3B, 0xC7, 0x4C, 0x0A, 0x94, 0xA0, 0x4B, 0x89, 0xE5, 0x24, 0xCD, 0x16, 0x4A, 0x82,
+    0xE0, 0x22, 0x74, 0xFE, 0x5B, 0x04, 0x1B, 0x64, 0x2F, 0x55, 0xB6, 0xE6, 0xE9, 0x2E, 0x56,
+    0x8C, 0x9F, 0xD5, 0x48, 0xDA, 0x34, 0x72, 0xCA, 0x8A, 0x9E, 0xF5, 0x7A, 0x3C, 0x53, 0x24,
+    0xE6, 0x3D, 0x75, 0xFD, 0x2B, 0x47, 0x08, 0x0B, 0x9F, 0x13, 0x28, 0x52, 0x08, 0x51, 0xE2,
+    0x29, 0x46, 0x4E, 0xE9, 0x9D, 0xAA, 0x0D, 0xFB, 0x19, 0x97, 0x8E, 0xC9, 0x0C, 0xA0, 0xB9,
+    0x7F, 0x99, 0xAB, 0x59, 0x68, 0x93, 0xD0, 0xF2, 0x4B, 0x96, 0x83, 0xFE, 0x19, 0xA5, 0x84,
+    0xE7, 0xD8, 0xAC, 0x55, 0x3E, 0xEC, 0xFE, 0x73, 0x84, 0xB7, 0xF7, 0x4D, 0x6D, 0x3E, 0x20,
+    0x7E, 0xB3, 0x8F, 0xDD, 0xB1, 0x7D, 0x6C, 0xC1, 0xD8, 0x5C, 0x5D, 0x57, 0x9B, 0x58, 0x2D,
+    0x95, 0xDF, 0x02, 0x2D, 0xE0, 0x89, 0xEF, 0x02, 0xE9, 0xC6, 0xD6, 0xBC, 0x50, 0x88, 0x58,
+    0x08, 0x69, 0x5F, 0xCC, 0xB0, 0x7E, 0x6D, 0x29, 0x11, 0xDF, 0xF6, 0xFF, 0x93, 0x58, 0x1F,
+    0x20, 0xA9, 0xDC, 0x2C, 0xFA, 0xDC, 0xBE, 0x4D, 0xF0, 0xBA, 0x0B, 0xC7, 0x7B, 0x86, 0xFB,
+    0x59, 0x0F, 0xED, 0xC6, 0xE1, 0x15, 0x7A, 0x73, 0x41, 0xA0, 0xA5, 0x01, 0x44, 0xF5, 0x3B,
+    0x8E, 0x9E, 0x23, 0x82, 0xB5, 0x3B, 0x1D, 0x22, 0xF2, 0x78, 0xFA, 0xC1, 0x7A, 0x66, 0x08,
+    0xA1, 0xD0, 0x04, 0xFA, 0x53, 0x0D, 0xC9, 0x32, 0x5D, 0x78, 0xA6, 0x52, 0x69, 0x39, 0xE7,
+    0xA2, 0xEC, 0x2B, 0x68, 0x3C, 0xAD, 0xF8, 0x4F, 0xBA, 0xB3, 0xD2, 0x41, 0x5E, 0x87, 0x98,
+    0x66, 0xB8, 0x7F, 0x44, 0x50, 0xBB, 0xF4, 0xFC, 0x93, 0xA9, 0xB6, 0xDD, 0x88, 0xF9, 0x9B,
+    0x26, 0x87, 0x33, 0x08, 0x67, 0x37, 0xF9, 0x32, 0x56, 0xCB, 0xB3, 0xBA, 0x6E, 0x1E, 0xBA,
+    0xA7, 0x3E, 0x14, 0xC0, 0x48, 0x3F, 0x95, 0x0B, 0x6E, 0xFB, 0x9C, 0xCD, 0x7D, 0xF9, 0x5A,
+    0xD9, 0xC3, 0x3F, 0xB6, 0x72, 0x4D, 0xD5, 0x8F, 0x23, 0xA2, 0x12, 0xF3, 0x66, 0x46, 0x42,
+    0x38, 0x3D, 0x29, 0x60, 0x0D, 0x59, 0x20, 0x78, 0xAF, 0x08, 0x24, 0xBC, 0xFA, 0x76, 0x85,
+    0x65, 0x10, 0xE9, 0x37, 0x58, 0x9D, 0x90, 0xEF, 0x37, 0xB0, 0x0E, 0x8D, 0x72, 0x74, 0x4E,
+    0x4C, 0x4C, 0x7B, 0x99, 0x4E, 0x29, 0xC6, 0x4E, 0xC4, 0x54, 0xD0, 0x54, 0x9A, 0x0A, 0x0E,
+    0x6B, 0xDC, 0x04, 0x87, 0x4F, 0x26, 0x3D, 0x63, 0xCF, 0x1F, 0x92, 0x54, 0xA1, 0xEC, 0xD9,
+    0x9F, 0x91, 0x6C, 0xD5, 0xCB, 0x7C, 0x40, 0x6F, 0x9B, 0x52, 0x30, 0x37, 0x54, 0xE7, 0xBB,
+    0x17, 0x4D, 0x41, 0x6E, 0x61, 0x1A, 0xF9, 0xBD, 0xA5, 0xD7, 0x81, 0xB4, 0xF8, 0x04, 0x99,
+    0xEF, 0x7B, 0x8C, 0xC5, 0x56, 0xD0, 0xA4, 0x71, 0x5F, 0x9F, 0x29, 0x67, 0xBB, 0xDC, 0xCB,
+    0x4C, 0x2D, 0x24, 0x73, 0xAB, 0xCD, 0x4B, 0x4E, 0xAF, 0xA1, 0x7C, 0xBA, 0xD7, 0xF4, 0xB8,
+    0xD9, 0x1D, 0x29, 0x52, 0x71, 0x70, 0x0C, 0x9C, 0xCA, 0xC1, 0x0C, 0x56, 0x2D, 0xE9, 0xE9,
+    0xD4, 0x82, 0xB1, 0x18, 0x5E, 0x95, 0x97, 0x03, 0x45, 0x68, 0x1F, 0x8E, 0xA6, 0x5E, 0xE4,
+    0x7C, 0xE2, 0xDC, 0x9C, 0x9C
+};
+
+#endif // FONT5X7_H
@@ -0,0 +1,247 @@
+#!/usr/bin/env python3
+"""
+st7305_asset.py
+
+Host-side converter for ST7305 native-format assets ("SA" format, see
+lib/ST7305_Display/ST7305_Asset.h).
+
+The image is thresholded (or dithered) to 1 bit, padded to the controller's
+RAM window grid (12 pixels wide, 2 rows high), packed in the 4x2 frame
+buffer layout and run-length compressed. The output is a C header with a
+PROGMEM array, or the raw asset bytes.
+
+PBM (P1/P4) is read without dependencies; other formats (PNG, BMP, ...)
+need Pillow.
+
+Usage:
+  python3 tools/st7305_asset.py splash.png -o src/splash_asset.h
+  python3 tools/st7305_asset.py icon.pbm --name icon_wifi --pad white
+  python3 tools/st7305_asset.py photo.jpg --dither --format bin -o photo.sa
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+PIXELS_PER_COL = 12
+BYTES_PER_COL = 3
+MAX_WIDTH = 300
+MAX_HEIGHT = 65535  # uint16 header field
+
+ENC_RAW = 0
+ENC_RLE = 1
+
+
+# ============================================================================
+# Image Loading (returns rows of 0/1, 1 = white)
+# ============================================================================
+
+def load_pbm(data):
+    """Parse P1 / P4 PBM data. PBM uses 1 = black."""
+    magic = data[:2]
+    pos = 2
+    values = []
+    while len(values) < 2:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b'#':
+            while data[pos:pos + 1] not in (b'\n', b''):
+                pos += 1
+            continue
+        start = pos
+        while data[pos:pos + 1].isdigit():
+            pos += 1
+        values.append(int(data[start:pos]))
+    width, height = values
+
+    if magic == b'P4':
+        pos += 1  # Single whitespace byte after the header
+        stride = (width + 7) // 8
+        rows = []
+        for y in range(height):
+            line = data[pos + y * stride:pos + (y + 1) * stride]
+            rows.append([0 if (line[x >> 3] >> (7 - (x & 7))) & 1 else 1 for x in range(width)])
+        return width, height, rows
+
+    bits = re.findall(rb'[01]', re.sub(rb'#[^\n]*', b'', data[pos:]))
+    rows = []
+    for y in range(height):
+        rows.append([0 if bits[y * width + x] == b'1' else 1 for x in range(width)])
+    return width, height, rows
+
+
+def load_image(path, threshold, dither, invert):
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    if data[:2] in (b'P1', b'P4'):
+        width, height, rows = load_pbm(data)
+    else:
+        try:
+            from PIL import Image
+        except ImportError:
+            sys.exit('error: Pillow is required for non-PBM input (pip install pillow)')
+        img = Image.open(path).convert('L')
+        if dither:
+            img = img.convert('1')
+        else:
+            img = img.point(lambda v: 255 if v >= threshold else 0).convert('1', dither=Image.NONE)
+        width, height = img.size
+        px = img.load()
+        rows = [[1 if px[x, y] else 0 for x in range(width)] for y in range(height)]
+
+    if invert:
+        rows = [[1 - v for v in row] for row in rows]
+    if width > MAX_WIDTH:
+        sys.exit('error: image is %d pixels wide, panel maximum is %d' % (width, MAX_WIDTH))
+    if height > MAX_HEIGHT:
+        sys.exit('error: image is %d pixels tall, asset maximum is %d' % (height, MAX_HEIGHT))
+    return width, height, rows
+
+
+# ============================================================================
+# Packing & Compression
+# ============================================================================
+
+def pack(width, height, rows, pad):
+    """Pack into row-pairs of ceil(width / 12) * 3 bytes, frame buffer order."""
+    cols = (width + PIXELS_PER_COL - 1) // PIXELS_PER_COL
+    pairs = (height + 1) // 2
+    padded_w = cols * PIXELS_PER_COL
+    out = bytearray()
+    for pair in range(pairs):
+        for bx in range(padded_w // 4):
+            value = 0
+            for dx in range(4):
+                for dy in range(2):
+                    x = bx * 4 + dx
+                    y = pair * 2 + dy
+                    on = rows[y][x] if (x < width and y < height) else pad
+                    if on:
+                        value |= 0x80 >> (dx * 2 + dy)
+            out.append(value)
+    return bytes(out)
+
+
+def rle_encode(data):
+    """PackBits-style: 0x00-0x7F literal n+1, 0x80-0xFF repeat n-0x7E (2..129)."""
+    out = bytearray()
+    literal = bytearray()
+    i = 0
+    n = len(data)
+
+    def flush():
+        while literal:
+            chunk = literal[:128]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+            del literal[:128]
+
+    while i < n:
+        run = 1
+        while i + run < n and run < 129 and data[i + run] == data[i]:
+            run += 1
+        # Two-byte runs only pay off when they don't split a literal
+        if run >= 3 or (run == 2 and not literal):
+            flush()
+            out.append(0x7E + run)
+            out.append(data[i])
+            i += run
+        else:
+            literal.append(data[i])
+            i += 1
+            if len(literal) == 128:
+                flush()
+    flush()
+    return bytes(out)
+
+
+def rle_decode(data, size):
+    out = bytearray()
+    i = 0
+    while len(out) < size:
+        control = data[i]
+        i += 1
+        if control < 0x80:
+            out.extend(data[i:i + control + 1])
+            i += control + 1
+        else:
+            out.extend(bytes([data[i]]) * (control - 0x7E))
+            i += 1
+    return bytes(out[:size])
+
+
+def build_asset(width, height, packed, force_raw):
+    encoded = rle_encode(packed)
+    assert rle_decode(encoded, len(packed)) == packed
+    if force_raw or len(encoded) >= len(packed):
+        encoding, payload = ENC_RAW, packed
+    else:
+        encoding, payload = ENC_RLE, encoded
+    header = b'SA' + struct.pack('<BBHHI', encoding, 0, width, height, len(payload))
+    return header + payload, encoding
+
+
+# ============================================================================
+# Output
+# ============================================================================
+
+def c_header(name, asset, width, height, encoding, source):
+    guard = re.sub(r'\W', '_', name).upper() + '_H'
+    lines = [
+        '// Generated by tools/st7305_asset.py from %s' % os.path.basename(source),
+        '// %dx%d, %s, %d bytes' % (width, height, 'run-length' if encoding else 'raw', len(asset)),
+        '#ifndef %s' % guard,
+        '#define %s' % guard,
+        '',
+        '#include <Arduino.h>',
+        '',
+        'const uint8_t %s[] PROGMEM = {' % name,
+    ]
+    for i in range(0, len(asset), 16):
+        lines.append('    ' + ', '.join('0x%02X' % b for b in asset[i:i + 16]) + ',')
+    lines += ['};', '', '#endif // %s' % guard, '']
+    return '\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert an image to an ST7305 native asset')
+    parser.add_argument('input', help='Image file (PBM natively, other formats via Pillow)')
+    parser.add_argument('-o', '--output', help='Output file (default: stdout for headers)')
+    parser.add_argument('--name', help='C array name (default: derived from input file name)')
+    parser.add_argument('--format', choices=('header', 'bin'), default='header')
+    parser.add_argument('--threshold', type=int, default=128, help='Luma threshold for white (0-255)')
+    parser.add_argument('--dither', action='store_true', help='Floyd-Steinberg dither (Pillow)')
+    parser.add_argument('--invert', action='store_true', help='Swap black and white')
+    parser.add_argument('--pad', choices=('black', 'white'), default='black',
+                        help='Color of the grid padding (visible when streamed)')
+    parser.add_argument('--raw', action='store_true', help='Store uncompressed')
+    args = parser.parse_args()
+
+    width, height, rows = load_image(args.input, args.threshold, args.dither, args.invert)
+    packed = pack(width, height, rows, 1 if args.pad == 'white' else 0)
+    asset, encoding = build_asset(width, height, packed, args.raw)
+
+    name = args.name or re.sub(r'\W', '_', os.path.splitext(os.path.basename(args.input))[0])
+    if args.format == 'bin':
+        if not args.output:
+            sys.exit('error: --format bin needs --output')
+        with open(args.output, 'wb') as f:
+            f.write(asset)
+    else:
+        text = c_header(name, asset, width, height, encoding, args.input)
+        if args.output:
+            with open(args.output, 'w') as f:
+                f.write(text)
+        else:
+            sys.stdout.write(text)
+
+    sys.stderr.write('%s: %dx%d, packed %d bytes -> %d bytes (%s, %.1fx)\n' % (
+        name, width, height, len(packed), len(asset),
+        'run-length' if encoding else 'raw', float(len(packed)) / len(asset)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,353 @@
+#!/usr/bin/env python3
+"""
+st7305_trace.py
+
+Host-side reader for ST7305 SPI wire traces ("S7TR" format, see
+lib/ST7305_Display/ST7305_Trace.h).
+
+  summary  Bytes and commands per frame, with optional budgets that fail
+           the run (exit 1) when a frame goes over them.
+  replay   Run the trace through a model of the controller RAM (CASET,
+           RASET, RAMWR, Write Memory Continue) and save the panel content
+           at every frame marker as a PBM.
+  diff     Replay two traces and compare them frame by frame: pixels that
+           differ and the change in bus traffic. Exit 1 if any frame
+           differs.
+
+A frame is the traffic between two ST7305_WireTrace::frame() markers;
+traffic after the last marker forms a final unmarked frame. replay and
+diff need a trace recorded with payload.
+
+Usage:
+  python3 tools/st7305_trace.py summary run.s7tr
+  python3 tools/st7305_trace.py summary run.s7tr --budget-bytes 16000 --budget-commands 40
+  python3 tools/st7305_trace.py replay run.s7tr -o frames/run
+  python3 tools/st7305_trace.py diff baseline.s7tr run.s7tr
+"""
+
+import argparse
+import os
+import sys
+
+WIDTH = 300
+HEIGHT = 400
+BYTES_PER_ROW_PAIR = 75
+BYTES_PER_COL = 3
+COL_ADDR_START = 0x12
+RAM_SIZE = BYTES_PER_ROW_PAIR * HEIGHT // 2
+
+CMD_INVOFF = 0x20
+CMD_INVON = 0x21
+CMD_CASET = 0x2A
+CMD_RASET = 0x2B
+CMD_RAMWR = 0x2C
+CMD_WRMEMC = 0x3C
+
+REC_CMD = 0x01
+REC_DATA = 0x02
+REC_COUNT = 0x03
+REC_FRAME = 0x04
+
+MAGIC = b'S7TR'
+VERSION = 1
+
+
+# ============================================================================
+# Log Parsing
+# ============================================================================
+
+def read_varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise ValueError('truncated length at offset %d' % pos)
+        b = data[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        shift += 7
+        if not b & 0x80:
+            return value, pos
+
+
+def parse(path):
+    """Return the records as (type, value) tuples.
+
+    CMD: command byte, DATA: bytes, COUNT: length, FRAME: tag.
+    """
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:4] != MAGIC:
+        raise ValueError('%s: not an S7TR trace' % path)
+    if data[4] != VERSION:
+        raise ValueError('%s: unsupported trace version %d' % (path, data[4]))
+
+    records = []
+    pos = 8
+    while pos < len(data):
+        kind = data[pos]
+        pos += 1
+        if kind in (REC_CMD, REC_FRAME):
+            if pos >= len(data):
+                raise ValueError('truncated record at offset %d' % (pos - 1))
+            records.append((kind, data[pos]))
+            pos += 1
+        elif kind == REC_DATA:
+            length, pos = read_varint(data, pos)
+            if pos + length > len(data):
+                raise ValueError('truncated data burst at offset %d' % pos)
+            records.append((kind, data[pos:pos + length]))
+            pos += length
+        elif kind == REC_COUNT:
+            length, pos = read_varint(data, pos)
+            records.append((kind, length))
+        else:
+            raise ValueError('unknown record 0x%02X at offset %d' % (kind, pos - 1))
+    return records
+
+
+# ============================================================================
+# Controller Model
+# ============================================================================
+
+class Panel:
+    """Controller RAM and the address window state that writes it.
+
+    The init sequences turn Display Inversion on, which makes a RAM bit of
+    1 show white (ST7305_WHITE); that is the state assumed until the trace
+    says otherwise.
+    """
+
+    def __init__(self):
+        self.ram = bytearray(RAM_SIZE)
+        self.inversion = True
+        self.cmd = None
+        self.params = []
+        self.cols = (COL_ADDR_START, COL_ADDR_START + WIDTH // 12 - 1)
+        self.rows = (0, HEIGHT // 2 - 1)
+        self.col = self.cols[0]
+        self.row = self.rows[0]
+        self.byte = 0
+        self.writing = False
+
+    def command(self, cmd):
+        self.cmd = cmd
+        self.params = []
+        self.writing = cmd in (CMD_RAMWR, CMD_WRMEMC)
+        if cmd == CMD_RAMWR:
+            self.col, self.row, self.byte = self.cols[0], self.rows[0], 0
+        elif cmd == CMD_INVON:
+            self.inversion = True
+        elif cmd == CMD_INVOFF:
+            self.inversion = False
+
+    def data(self, payload):
+        if self.writing:
+            for value in payload:
+                self.write(value)
+            return
+        self.params.extend(payload)
+        if self.cmd == CMD_CASET and len(self.params) == 2:
+            self.cols = (self.params[0], self.params[1])
+        elif self.cmd == CMD_RASET and len(self.params) == 2:
+            self.rows = (self.params[0], self.params[1])
+
+    def write(self, value):
+        col = self.col - COL_ADDR_START
+        if 0 <= col < BYTES_PER_ROW_PAIR // BYTES_PER_COL and 0 <= self.row < HEIGHT // 2:
+            self.ram[self.row * BYTES_PER_ROW_PAIR + col * BYTES_PER_COL + self.byte] = value
+        self.byte += 1
+        if self.byte == BYTES_PER_COL:
+            self.byte = 0
+            self.col += 1
+            if self.col > self.cols[1]:
+                self.col = self.cols[0]
+                self.row += 1
+                if self.row > self.rows[1]:
+                    self.row = self.rows[0]
+
+    def pixels(self):
+        """Rows of 0/1 as shown on the panel (1 = white)."""
+        rows = []
+        for y in range(HEIGHT):
+            base = (y // 2) * BYTES_PER_ROW_PAIR
+            line = []
+            for x in range(WIDTH):
+                bit = (self.ram[base + x // 4] >> (7 - ((x % 4) * 2 + y % 2))) & 1
+                line.append(bit if self.inversion else bit ^ 1)
+            rows.append(line)
+        return rows
+
+
+# ============================================================================
+# Frames
+# ============================================================================
+
+class Frame:
+    def __init__(self, index):
+        self.index = index
+        self.tag = None        # None = unmarked tail
+        self.commands = 0
+        self.data_bytes = 0
+        self.pixel_bytes = 0   # Data written to RAM (after RAMWR / WRMEMC)
+        self.windows = 0       # RAMWR commands
+        self.image = None
+
+    def bus_bytes(self):
+        return self.commands + self.data_bytes
+
+    def label(self):
+        if self.tag is None:
+            return '%d (tail)' % self.index
+        return '%d [%d]' % (self.index, self.tag)
+
+
+def run(records, replay):
+    """Split the trace into frames, optionally replaying the RAM."""
+    panel = Panel()
+    frames = []
+    frame = Frame(0)
+    busy = False
+    for kind, value in records:
+        if kind == REC_CMD:
+            panel.command(value)
+            frame.commands += 1
+            if value == CMD_RAMWR:
+                frame.windows += 1
+        elif kind in (REC_DATA, REC_COUNT):
+            count = len(value) if kind == REC_DATA else value
+            frame.data_bytes += count
+            if panel.writing:
+                frame.pixel_bytes += count
+            if kind == REC_DATA:
+                panel.data(value)
+            elif replay:
+                raise ValueError('trace was recorded without payload; replay needs the data bytes')
+        elif kind == REC_FRAME:
+            frame.tag = value
+            if replay:
+                frame.image = panel.pixels()
+            frames.append(frame)
+            frame = Frame(len(frames))
+            busy = False
+            continue
+        busy = True
+    if busy:
+        if replay:
+            frame.image = panel.pixels()
+        frames.append(frame)
+    return frames
+
+
+# ============================================================================
+# Commands
+# ============================================================================
+
+def cmd_summary(args):
+    frames = run(parse(args.trace), False)
+    print('%-10s %8s %10s %10s %8s' % ('frame', 'commands', 'data', 'pixel', 'windows'))
+    over = 0
+    for frame in frames:
+        notes = []
+        if args.budget_bytes is not None and frame.bus_bytes() > args.budget_bytes:
+            notes.append('bytes over budget by %d' % (frame.bus_bytes() - args.budget_bytes))
+        if args.budget_commands is not None and frame.commands > args.budget_commands:
+            notes.append('commands over budget by %d' % (frame.commands - args.budget_commands))
+        over += 1 if notes else 0
+        print('%-10s %8d %10d %10d %8d  %s' % (frame.label(), frame.commands, frame.data_bytes,
+                                              frame.pixel_bytes, frame.windows, ', '.join(notes)))
+
+    total = sum(f.bus_bytes() for f in frames)
+    print('%d frames, %d bus bytes (%d commands), max %d bytes per frame' % (
+        len(frames), total, sum(f.commands for f in frames),
+        max([f.bus_bytes() for f in frames] or [0])))
+    if over:
+        print('%d frame(s) over budget' % over, file=sys.stderr)
+        return 1
+    return 0
+
+
+def write_pbm(path, rows):
+    """P4 PBM; PBM uses 1 = black."""
+    stride = (WIDTH + 7) // 8
+    out = bytearray(b'P4\n%d %d\n' % (WIDTH, HEIGHT))
+    for line in rows:
+        packed = bytearray(stride)
+        for x, white in enumerate(line):
+            if not white:
+                packed[x >> 3] |= 0x80 >> (x & 7)
+        out += packed
+    with open(path, 'wb') as f:
+        f.write(out)
+
+
+def cmd_replay(args):
+    frames = run(parse(args.trace), True)
+    prefix = args.output or os.path.splitext(args.trace)[0]
+    for frame in frames:
+        path = '%s_%03d.pbm' % (prefix, frame.index)
+        write_pbm(path, frame.image)
+        print('%s: frame %s, %d bus bytes' % (path, frame.label(), frame.bus_bytes()))
+    return 0
+
+
+def cmd_diff(args):
+    a = run(parse(args.a), True)
+    b = run(parse(args.b), True)
+    differs = len(a) != len(b)
+    if differs:
+        print('frame count differs: %d vs %d' % (len(a), len(b)))
+
+    for fa, fb in zip(a, b):
+        changed = 0
+        x0, y0, x1, y1 = WIDTH, HEIGHT, -1, -1
+        for y in range(HEIGHT):
+            ra, rb = fa.image[y], fb.image[y]
+            if ra == rb:
+                continue
+            for x in range(WIDTH):
+                if ra[x] != rb[x]:
+                    changed += 1
+                    x0, y0, x1, y1 = min(x0, x), min(y0, y), max(x1, x), max(y1, y)
+        pixels = 'identical'
+        if changed:
+            differs = True
+            pixels = '%d pixels differ in (%d,%d)-(%d,%d)' % (changed, x0, y0, x1, y1)
+        print('%-10s %s; bytes %d -> %d (%+d), commands %d -> %d (%+d)' % (
+            fa.label(), pixels,
+            fa.bus_bytes(), fb.bus_bytes(), fb.bus_bytes() - fa.bus_bytes(),
+            fa.commands, fb.commands, fb.commands - fa.commands))
+    return 1 if differs else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Summarize, replay and compare ST7305 SPI wire traces')
+    sub = parser.add_subparsers(dest='command')
+    sub.required = True
+
+    p = sub.add_parser('summary', help='bus traffic per frame')
+    p.add_argument('trace', help='S7TR trace file')
+    p.add_argument('--budget-bytes', type=int, help='fail if a frame sends more bytes (commands + data)')
+    p.add_argument('--budget-commands', type=int, help='fail if a frame sends more commands')
+    p.set_defaults(func=cmd_summary)
+
+    p = sub.add_parser('replay', help='reconstruct the panel at every frame as PBM')
+    p.add_argument('trace', help='S7TR trace file')
+    p.add_argument('-o', '--output', help='output prefix (default: trace name)')
+    p.set_defaults(func=cmd_replay)
+
+    p = sub.add_parser('diff', help='compare two traces frame by frame')
+    p.add_argument('a', help='baseline trace')
+    p.add_argument('b', help='trace to compare')
+    p.set_defaults(func=cmd_diff)
+
+    args = parser.parse_args()
+    try:
+        return args.func(args)
+    except (OSError, ValueError) as e:
+        print('error: %s' % e, file=sys.stderr)
+        return 2
+
+
+if __name__ == '__main__':
+    sys.exit(main())